@@ -6,6 +6,11 @@
 #ifndef _AUTOTUNE_H
 #define _AUTOTUNE_H
 
+#define RETUNE_BATCHES   2
+#define RETUNE_EXEC_CNT  8
+
+void  autotune_online (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 pws_cnt);
+
 void *thread_autotune (void *p);
 
 #endif // _AUTOTUNE_H
@@ -11,4 +11,6 @@
 int  bitmap_ctx_init    (hashcat_ctx_t *hashcat_ctx);
 void bitmap_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
 
+void bitmap_ctx_generate (hashcat_ctx_t *hashcat_ctx, const u32 digests_cnt, char *digests_buf, u32 *bitmap_bufs);
+
 #endif // _BITMAP_H
@@ -37,6 +37,11 @@
 #define SPEED_CACHE     128
 #define SPEED_MAXAGE    4096
 
+#define METRICS_KERN    5   // KERN_RUN_1, KERN_RUN_12, KERN_RUN_2, KERN_RUN_23, KERN_RUN_3
+#define METRICS_BUCKETS 10  // histogram buckets, the last one is +Inf
+
+#define KERNEL_GROUPS_MAX 16 // separate builds of the JIT kernels (scrypt, descrypt) per session
+
 // general buffer size in case the size is unknown at compile-time
 #define HCBUFSIZ_TINY   0x100
 #define HCBUFSIZ_LARGE  0x50000
@@ -0,0 +1,24 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _COMPACT_H
+#define _COMPACT_H
+
+#include <string.h>
+#include <time.h>
+
+// rebuild once this many percent of the remaining digests cracked, but not more often than every COMPACT_INTERVAL seconds
+
+#define COMPACT_RATIO     10
+#define COMPACT_INTERVAL  10
+
+int  compact_ctx_init    (hashcat_ctx_t *hashcat_ctx);
+void compact_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
+
+int  compact_update      (hashcat_ctx_t *hashcat_ctx);
+int  compact_device_sync (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void compact_plains      (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plains_buf, const u32 plains_cnt);
+
+#endif // _COMPACT_H
@@ -21,6 +21,10 @@ u64 hex_to_u64 (const u8 hex[16]);
 
 void bin_to_hex_lower (const u32 v, u8 hex[8]);
 
+bool is_valid_hex_string (const u8 *s, const int len);
+bool hex_decode          (const u8 *in_buf, const int in_len, u8 *out_buf);
+void hex_encode_lower    (const u8 *in_buf, const int in_len, u8 *out_buf);
+
 u8 int_to_base32  (const u8 c);
 u8 base32_to_int  (const u8 c);
 u8 int_to_base64  (const u8 c);
@@ -43,6 +47,15 @@ int base32_encode (u8 (*f) (const u8), const u8 *in_buf, int in_len, u8 *out_buf
 int base64_decode (u8 (*f) (const u8), const u8 *in_buf, int in_len, u8 *out_buf);
 int base64_encode (u8 (*f) (const u8), const u8 *in_buf, int in_len, u8 *out_buf);
 
+int itoa64_decode  (const u8 *in_buf, const int in_len, u8 *out_buf);
+int itoa64_encode  (const u8 *in_buf, const int in_len, u8 *out_buf);
+int bf64_decode    (const u8 *in_buf, const int in_len, u8 *out_buf);
+int bf64_encode    (const u8 *in_buf, const int in_len, u8 *out_buf);
+int lotus64_decode (const u8 *in_buf, const int in_len, u8 *out_buf);
+int lotus64_encode (const u8 *in_buf, const int in_len, u8 *out_buf);
+
+bool itoa64_to_int_buf (const u8 *in_buf, const int in_len, u8 *out_buf);
+
 void lowercase (u8 *buf, int len);
 void uppercase (u8 *buf, int len);
 
@@ -0,0 +1,23 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _DEDUP_H
+#define _DEDUP_H
+
+#include <string.h>
+#include <inttypes.h>
+
+int  dedup_ctx_init     (hashcat_ctx_t *hashcat_ctx);
+void dedup_ctx_destroy  (hashcat_ctx_t *hashcat_ctx);
+
+void dedup_check_keyspace (hashcat_ctx_t *hashcat_ctx, const u64 words_base);
+
+int  dedup_batch_init    (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void dedup_batch_reset   (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void dedup_batch_destroy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+
+bool dedup_skip (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u8 *pw_buf, const u32 pw_len);
+
+#endif // _DEDUP_H
@@ -0,0 +1,32 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _FEED_H
+#define _FEED_H
+
+#include <errno.h>
+#include <unistd.h>
+
+#if defined (_POSIX)
+#include <poll.h>
+#endif
+
+#define FEED_BATCHES   16           // batches queued before hashcat_feed_push () blocks
+#define FEED_READ_SIZE (1024 * 1024) // bytes per read () of the stdin reader
+
+int  feed_init    (hashcat_ctx_t *hashcat_ctx);
+void feed_destroy (hashcat_ctx_t *hashcat_ctx);
+void feed_reset   (hashcat_ctx_t *hashcat_ctx);
+
+int  feed_push   (hashcat_ctx_t *hashcat_ctx, const u8 *buf, const u32 *len_buf, const u32 cnt);
+void feed_finish (hashcat_ctx_t *hashcat_ctx);
+
+bool feed_wait (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+bool feed_next (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, char **line_buf, u32 *line_len);
+void feed_drop (hc_device_param_t *device_param);
+
+void *thread_feed_stdin (void *p);
+
+#endif // _FEED_H
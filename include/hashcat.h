@@ -18,7 +18,25 @@ int   hashcat_session_checkpoint (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_session_quit       (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_session_destroy    (hashcat_ctx_t *hashcat_ctx);
 
+// run another job on an initialized session, hc_argv is a full command line like the one given to hashcat_session_init ()
+// kept: platforms, devices, the tuning db, the autotune and kernel caches, the potfile, outfile and log setup
+// rebuilt per job: hashes and bitmaps, so hash_mode and attack_mode can change
+// programs and device buffers are kept from the previous job if the kernels and the tuning options match,
+// only the hashlist, rules and combs buffers are uploaded again (JIT modes and --backend-host always rebuild)
+// options which select devices or files, like --opencl-devices, --session or --outfile, have to stay the same
+// hc_argv is written to the job's restore file, so it has to stay valid until the job returns
+
+int   hashcat_session_run_job    (hashcat_ctx_t *hashcat_ctx, int hc_argc, char **hc_argv);
+
+// push candidates from the host process instead of stdin, enable before hashcat_session_init ()
+// cracks are reported as crack_record_t through EVENT_CRACKER_CRACK_RECORD
+
+int   hashcat_feed_enable        (hashcat_ctx_t *hashcat_ctx);
+int   hashcat_feed_push          (hashcat_ctx_t *hashcat_ctx, const u8 *buf, const u32 *len_buf, const u32 cnt);
+void  hashcat_feed_finish        (hashcat_ctx_t *hashcat_ctx);
+
 char *hashcat_get_log            (hashcat_ctx_t *hashcat_ctx);
 int   hashcat_get_status         (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_status);
+int   hashcat_get_status_snapshot (hashcat_ctx_t *hashcat_ctx, status_snapshot_t *status_snapshot);
 
 #endif // _HASHCAT_H
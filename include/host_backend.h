@@ -0,0 +1,27 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _HOST_BACKEND_H
+#define _HOST_BACKEND_H
+
+#include <string.h>
+#include <unistd.h>
+
+// candidates hashed side by side, 16 x u32 is one AVX-512 register, two AVX2 or four SSE2 registers
+// two blocks are enough for PW_MAX, even as UTF-16LE
+
+#define HOST_LANES      16
+#define HOST_BLOCKS_MAX 2
+
+bool host_backend_supported (const u32 hash_mode);
+
+int  host_backend_device_init     (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+int  host_backend_session_begin   (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+void host_backend_session_destroy (hc_device_param_t *device_param);
+
+int  host_backend_run_mp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num);
+int  host_backend_run    (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num, const u32 event_update, const u32 iteration);
+
+#endif // _HOST_BACKEND_H
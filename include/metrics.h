@@ -0,0 +1,22 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _METRICS_H
+#define _METRICS_H
+
+#include <stdio.h>
+#include <errno.h>
+
+int  metrics_init    (hashcat_ctx_t *hashcat_ctx);
+void metrics_destroy (hashcat_ctx_t *hashcat_ctx);
+
+void metrics_kernel_exec (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const double exec_us);
+void metrics_transfer    (hashcat_ctx_t *hashcat_ctx, cl_command_queue command_queue, const bool h2d, const size_t bytes, const double exec_msec);
+void metrics_batch       (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 pws_cnt, const double host_wait_msec, const u64 words_bytes);
+void metrics_cracked     (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 cracked);
+
+int  metrics_write (hashcat_ctx_t *hashcat_ctx);
+
+#endif // _METRICS_H
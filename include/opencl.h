@@ -73,8 +73,10 @@ void opencl_ctx_devices_destroy       (hashcat_ctx_t *hashcat_ctx);
 void opencl_ctx_devices_update_power  (hashcat_ctx_t *hashcat_ctx);
 void opencl_ctx_devices_kernel_loops  (hashcat_ctx_t *hashcat_ctx);
 
+int  opencl_kernel_warmup             (hashcat_ctx_t *hashcat_ctx);
 int  opencl_session_begin             (hashcat_ctx_t *hashcat_ctx);
 void opencl_session_destroy           (hashcat_ctx_t *hashcat_ctx);
+void opencl_session_keep              (hashcat_ctx_t *hashcat_ctx);
 void opencl_session_reset             (hashcat_ctx_t *hashcat_ctx);
 int  opencl_session_update_combinator (hashcat_ctx_t *hashcat_ctx);
 int  opencl_session_update_mp         (hashcat_ctx_t *hashcat_ctx);
@@ -9,6 +9,11 @@
 #include <unistd.h>
 #include <errno.h>
 
+#if defined (__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
 #define OUTFILES_DIR "outfiles"
 
 void *thread_outfile_remove (void *p);
@@ -23,10 +23,19 @@
 #define RESTORE_VERSION_MIN 320
 #define RESTORE_VERSION_CUR 320
 
+#define RESTORE_JOURNAL_MAGIC   0x4c4e524a // "JRNL"
+#define RESTORE_JOURNAL_VERSION 1
+#define RESTORE_JOURNAL_ALLOC   64
+
 int cycle_restore (hashcat_ctx_t *hashcat_ctx);
 
 void unlink_restore (hashcat_ctx_t *hashcat_ctx);
 
+int  restore_journal_begin  (hashcat_ctx_t *hashcat_ctx);
+u64  restore_journal_skip   (const hashcat_ctx_t *hashcat_ctx, u64 words_off, const u64 words_base, u64 *words_gap, u64 *words_skip);
+void restore_journal_claim  (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_off, const u64 words_cnt);
+void restore_journal_commit (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param);
+
 int restore_ctx_init (hashcat_ctx_t *hashcat_ctx, int argc, char **argv);
 
 void restore_ctx_destroy (hashcat_ctx_t *hashcat_ctx);
@@ -30,7 +30,7 @@ int kernel_rule_to_cpu_rule (char *rule_buf, kernel_rule_t *rule);
 
 bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 kernel_rules_cnt);
 
-int kernel_rules_load     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt);
+int kernel_rules_load     (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, kernel_rule_t **out_buf_orig, u32 *out_folded);
 int kernel_rules_generate (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt);
 
 #endif // _RP_H
@@ -50,6 +50,7 @@ double  status_get_progress_finished_percent  (const hashcat_ctx_t *hashcat_ctx)
 u64     status_get_progress_done              (const hashcat_ctx_t *hashcat_ctx);
 u64     status_get_progress_rejected          (const hashcat_ctx_t *hashcat_ctx);
 double  status_get_progress_rejected_percent  (const hashcat_ctx_t *hashcat_ctx);
+u64     status_get_progress_dedup             (const hashcat_ctx_t *hashcat_ctx);
 u64     status_get_progress_restored          (const hashcat_ctx_t *hashcat_ctx);
 u64     status_get_progress_cur               (const hashcat_ctx_t *hashcat_ctx);
 u64     status_get_progress_end               (const hashcat_ctx_t *hashcat_ctx);
@@ -62,6 +63,9 @@ double  status_get_hashes_msec_dev            (const hashcat_ctx_t *hashcat_ctx,
 double  status_get_hashes_msec_dev_benchmark  (const hashcat_ctx_t *hashcat_ctx, const int device_id);
 double  status_get_exec_msec_all              (const hashcat_ctx_t *hashcat_ctx);
 double  status_get_exec_msec_dev              (const hashcat_ctx_t *hashcat_ctx, const int device_id);
+u32     status_get_kernel_accel_dev           (const hashcat_ctx_t *hashcat_ctx, const int device_id);
+u32     status_get_kernel_loops_dev           (const hashcat_ctx_t *hashcat_ctx, const int device_id);
+u32     status_get_retune_cnt_dev             (const hashcat_ctx_t *hashcat_ctx, const int device_id);
 char   *status_get_speed_sec_all              (const hashcat_ctx_t *hashcat_ctx);
 char   *status_get_speed_sec_dev              (const hashcat_ctx_t *hashcat_ctx, const int device_id);
 int     status_get_cpt_cur_min                (const hashcat_ctx_t *hashcat_ctx);
@@ -76,6 +80,11 @@ char   *status_get_hwmon_dev                  (const hashcat_ctx_t *hashcat_ctx,
 int     status_progress_init                  (hashcat_ctx_t *hashcat_ctx);
 void    status_progress_destroy               (hashcat_ctx_t *hashcat_ctx);
 void    status_progress_reset                 (hashcat_ctx_t *hashcat_ctx);
+void    status_progress_add_done              (hc_device_param_t *device_param, const u32 salt_pos, const u64 cnt);
+void    status_progress_add_rejected          (hc_device_param_t *device_param, const u32 salt_pos, const u64 cnt);
+void    status_progress_add_done_salts        (hc_device_param_t *device_param, const u32 salt_pos, const u32 salts_cnt, const u64 cnt);
+void    status_progress_add_rejected_salts    (hc_device_param_t *device_param, const u32 salt_pos, const u32 salts_cnt, const u64 cnt);
+void    status_progress_add_rejected_all      (hc_device_param_t *device_param, const u64 cnt);
 
 int     status_ctx_init                       (hashcat_ctx_t *hashcat_ctx);
 void    status_ctx_destroy                    (hashcat_ctx_t *hashcat_ctx);
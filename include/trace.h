@@ -0,0 +1,24 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <stdio.h>
+#include <errno.h>
+#include <inttypes.h>
+
+#define TRACE_RING 0x10000 // events per device, the oldest ones are overwritten
+
+int  trace_init    (hashcat_ctx_t *hashcat_ctx);
+void trace_destroy (hashcat_ctx_t *hashcat_ctx);
+
+u64  trace_now    (hashcat_ctx_t *hashcat_ctx);
+void trace_span   (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u32 span, const u64 ts_start, const u64 arg);
+void trace_device (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u32 kern_run, const double exec_us);
+
+int  trace_write (hashcat_ctx_t *hashcat_ctx);
+
+#endif // _TRACE_H
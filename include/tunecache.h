@@ -0,0 +1,27 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#ifndef _TUNECACHE_H
+#define _TUNECACHE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <search.h>
+
+#define MAX_TUNECACHE 10000
+
+int sort_by_tunecache (const void *s1, const void *s2);
+
+int  tunecache_init    (hashcat_ctx_t *hashcat_ctx);
+void tunecache_destroy (hashcat_ctx_t *hashcat_ctx);
+void tunecache_read    (hashcat_ctx_t *hashcat_ctx);
+int  tunecache_write   (hashcat_ctx_t *hashcat_ctx);
+void tunecache_key     (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, tunecache_t *t);
+bool tunecache_find    (hashcat_ctx_t *hashcat_ctx, tunecache_t *t);
+void tunecache_append  (hashcat_ctx_t *hashcat_ctx, tunecache_t *t);
+
+#endif // _TUNECACHE_H
@@ -100,6 +100,7 @@ typedef enum event_identifier
   EVENT_AUTOTUNE_FINISHED         = 0x00000054,
   EVENT_CRACKER_STARTING          = 0x00000055,
   EVENT_CRACKER_FINISHED          = 0x00000056,
+  EVENT_CRACKER_CRACK_RECORD      = 0x00000057,
   EVENT_CRACKER_HASH_CRACKED      = 0x00000058,
   EVENT_POTFILE_REMOVE_PARSE_PRE  = 0x00000061,
   EVENT_POTFILE_REMOVE_PARSE_POST = 0x00000062,
@@ -238,6 +239,14 @@ typedef enum kern_run_mp
 
 } kern_run_mp_t;
 
+typedef enum host_amp
+{
+  HOST_AMP_RULES   = 1,  // base word through kernel_rules_buf
+  HOST_AMP_APPEND  = 2,  // base word || combs_buf
+  HOST_AMP_PREPEND = 3   // combs_buf || base word
+
+} host_amp_t;
+
 typedef enum rule_functions
 {
   RULE_OP_MANGLE_NOOP            = ':',
@@ -330,7 +339,8 @@ typedef enum opti_type
   OPTI_TYPE_USES_BITS_8       = (1u << 16),
   OPTI_TYPE_USES_BITS_16      = (1u << 17),
   OPTI_TYPE_USES_BITS_32      = (1u << 18),
-  OPTI_TYPE_USES_BITS_64      = (1u << 19)
+  OPTI_TYPE_USES_BITS_64      = (1u << 19),
+  OPTI_TYPE_MULTI_SALT        = (1u << 20)
 
 } opti_type_t;
 
@@ -527,6 +537,14 @@ typedef struct outfile_data
 
 } outfile_data_t;
 
+typedef struct outfile_check_index
+{
+  u32 *slots;      // digest index + 1, 0 is an empty slot
+  u32 *salts_pos;  // salt of each digest index
+  u32  mask;
+
+} outfile_check_index_t;
+
 typedef struct logfile_ctx
 {
   bool  enabled;
@@ -594,6 +612,8 @@ struct hashconfig
   u32   pw_max;
 
   int (*parse_func) (char *, u32, hash_t *, const struct hashconfig *);
+
+  int (*ascii_digest_func) (const struct hashconfig *, const hashes_t *, char *, const u32, const u32); // NULL for the generic ascii_digest ()
 };
 
 typedef struct hashconfig hashconfig_t;
@@ -647,6 +667,18 @@ typedef struct plain
 
 } plain_t;
 
+typedef struct crack_record
+{
+  u32  device_id;
+  u32  salt_pos;
+  u32  digest_pos;  // relative to the salt
+  u32  hash_pos;    // absolute
+  u64  crackpos;
+  u32  plain_len;
+  u8   plain_buf[64];
+
+} crack_record_t;
+
 typedef struct wordl
 {
   u32  word_buf[16];
@@ -659,8 +691,103 @@ typedef struct wordr
 
 } wordr_t;
 
+typedef struct metrics_hist
+{
+  u64  bucket[METRICS_BUCKETS]; // not cumulative, the exporter sums them up
+  u64  cnt;
+  u64  sum_usec;
+
+} metrics_hist_t;
+
+typedef struct metrics_dev
+{
+  metrics_hist_t kernel_exec[METRICS_KERN];
+
+  u64  h2d_cnt;
+  u64  h2d_bytes;
+  u64  h2d_usec;
+  u64  d2h_cnt;
+  u64  d2h_bytes;
+  u64  d2h_usec;
+
+  u64  batches;
+  u64  host_wait_usec;  // between the end of one batch and the copy of the next one
+  u64  words_bytes;     // base words read from the wordlist or stdin, including the newline
+  u64  cracked;
+
+  u32  batch_size;      // last pws_cnt, compared to kernel_power this is the queue fill
+
+} metrics_dev_t;
+
 #include "ext_OpenCL.h"
 
+typedef struct feed_batch
+{
+  u8   *buf;      // candidates, back to back
+  u32  *len_buf;
+  u32   cnt;
+  u32   pos;      // next candidate to hand out
+  u64   buf_off;  // offset of that candidate in buf
+
+} feed_batch_t;
+
+typedef struct restore_range
+{
+  u32   dicts_pos;
+  u32   masks_pos;
+
+  u64   words_off;              // [words_off, words_fin) of the base keyspace at that position
+  u64   words_fin;
+
+} restore_range_t;
+
+typedef struct compact_image
+{
+  u32   gen;
+  u32   refs;                   // devices holding it, protected by mux_compact
+
+  u32   digests_cnt;            // uncracked digests only, back to back
+  void *digests_buf;
+  u32  *digests_shown;
+  u32  *digests_map;            // compacted hash_pos -> hash_pos in hashes->digests_buf
+
+  salt_t *salts_buf;            // copy with the compacted digests_cnt and digests_offset
+
+  u32  *bitmap_bufs;            // s1_a .. s2_d, bitmap_nums each
+
+} compact_image_t;
+
+typedef struct kernel_group
+{
+  u32   salts_cnt;
+  u32   digests_cnt;
+
+  bool  specialized;            // false for the generic build shared by the leftover salts
+
+  u32   scrypt_N;
+  u32   scrypt_r;
+  u32   scrypt_p;
+
+  u32   descrypt_salt;
+
+} kernel_group_t;
+
+typedef struct device_kernel_group
+{
+  u32   scrypt_tmto;
+  u32   scrypt_tmp_size;
+
+  cl_program program;
+
+  cl_kernel  kernel1;
+  cl_kernel  kernel12;
+  cl_kernel  kernel2;
+  cl_kernel  kernel23;
+  cl_kernel  kernel3;
+  cl_kernel  kernel_tm;
+
+} device_kernel_group_t;
+
 typedef struct hc_device_param
 {
   cl_device_id      device;
@@ -670,6 +797,7 @@ typedef struct hc_device_param
   u32     platform_devices_id;   // for mapping with hms devices
 
   bool    skipped;
+  bool    is_host;              // cracked by the host backend, none of the OpenCL handles below are set
 
   u32     sm_major;
   u32     sm_minor;
@@ -688,16 +816,31 @@ typedef struct hc_device_param
   u32     kernel_accel;
   u32     kernel_loops_min;
   u32     kernel_loops_max;
+  u32     kernel_loops_max_orig;  // before opencl_ctx_devices_kernel_loops () lowered it, a kept session starts over from it
   u32     kernel_accel_min;
   u32     kernel_accel_max;
+  u32     kernel_salts;     // salts covered by one launch, the second NDRange dimension
   u32     kernel_power;
   u32     hardware_power;
 
+  u32     retune_batches;       // full batches since the last online retune
+  u32     retune_cnt;           // number of online retunes, for status
+
+  // progress counters, only written by the thread which owns this device, so no locking is required
+  // being part of hc_device_param_t they never share a cache line with the counters of another device
+
+  u64     progress_done;          // sum over all salts
+  u64     progress_rejected;      // sum over all salts, without progress_rejected_all
+  u64     progress_rejected_all;  // rejected for every salt at once, like words filtered before the copy
+  u64    *progress_done_buf;      // per salt
+  u64    *progress_rejected_buf;  // per salt
+
   size_t  size_pws;
   size_t  size_tmps;
   size_t  size_hooks;
   size_t  size_bfs;
   size_t  size_combs;
+  size_t  size_combs_all;
   size_t  size_rules;
   size_t  size_rules_c;
   size_t  size_root_css;
@@ -710,15 +853,41 @@ typedef struct hc_device_param
 
   FILE   *combs_fp;
   comb_t *combs_buf;
+  bool    combs_resident;
 
   void   *hooks_buf;
 
   pw_t   *pws_buf;
   u32     pws_cnt;
 
+  bool    host_rules;           // pws_buf holds candidates with the rules already applied on the host
+  u32     host_rules_words;     // number of base words behind them
+  pw_t   *host_rules_base_buf;
+  u32    *host_rules_pos_buf;   // per candidate: word_pos * kernel_rules_cnt + rule_pos
+
+  u32    *dedup_table_buf;      // exact set of the words in pws_buf, stores pws_buf index + 1
+  u32     dedup_table_size;
+
+  metrics_dev_t metrics;        // counters for --metrics-file, updated with atomics
+
+  feed_batch_t feed_cur;        // batch taken from the candidate feed, consumed without mux_dispatcher
+
+  compact_image_t *compact_image; // hashlist the device buffers hold, NULL for the full one
+
+  u32     host_threads;         // host backend: workers per launch
+  u32     host_result;          // host backend: stands in for d_result
+  u32    *host_digests_shown;   // host backend: stands in for d_digests_shown
+  plain_t *host_plain_bufs;     // host backend: stands in for d_plain_bufs
+
+  device_kernel_group_t *kernel_groups; // one build per opencl_ctx->kernel_groups, [0] is also program, kernel1, ..
+
   u64     words_off;
   u64     words_done;
 
+  restore_range_t *words_claimed_buf; // ranges get_work () handed out for the batch in flight, journaled once it ran
+  u32     words_claimed_cnt;
+  u32     words_claimed_avail;
+
   u32     outerloop_pos;
   u32     outerloop_left;
 
@@ -839,9 +1008,76 @@ typedef struct hc_device_param
 
 } hc_device_param_t;
 
+typedef struct host_launch
+{
+  u32   hash_type;
+  u32   dgst_words;
+  u32   dgst_pos0;
+  u32   dgst_pos1;
+  u32   dgst_pos2;
+  u32   dgst_pos3;
+  bool  unicode;                // PT_UNICODE, expanded to UTF-16LE before hashing
+  bool  big_endian;             // message words and length are big-endian, like SHA1 and SHA256
+
+  u32   amp_mode;
+  u32   pw_max;
+
+  const pw_t   *pws_buf;
+  const comb_t *combs_buf;
+  const void   *rules_buf;      // kernel_rule_t, already at innerloop_pos
+  u32   rules_cnt;
+
+  u32   pws_cnt;
+  u32   il_cnt;
+  u32   salt_pos;
+
+  const u32 *digests_buf;       // full or compacted hashlist, see compact_image_t
+  u32   digests_cnt;
+  u32   digests_offset;
+
+  const u32 *bitmaps[8];        // s1_a .. s2_d
+  u32   bitmap_mask;
+  u32   bitmap_shift1;
+  u32   bitmap_shift2;
+
+  u32     *digests_shown;       // hc_device_param_t host_digests_shown
+  u32     *result;              // hc_device_param_t host_result
+  plain_t *plains_buf;          // hc_device_param_t host_plain_bufs
+
+} host_launch_t;
+
+typedef struct host_worker
+{
+  host_launch_t *launch;
+
+  u64   pos;                    // gidvid * il_cnt + il_pos of the first candidate
+  u64   cnt;
+
+} host_worker_t;
+
+// everything the programs and the buffers sized by kernel_accel depend on, see opencl_session_keep ()
+
+typedef struct opencl_session_key
+{
+  u32   hash_mode;
+  u32   attack_mode;
+  u32   kern_type;
+  u32   opti_type;
+  u32   opts_type;
+  u32   kernel_accel;
+  u32   kernel_loops;
+  u32   workload_profile;
+  u32   opencl_vector_width;
+  bool  kernel_accel_chgd;
+  bool  kernel_loops_chgd;
+  bool  opencl_vector_width_chgd;
+
+} opencl_session_key_t;
+
 typedef struct opencl_ctx
 {
   bool                enabled;
+  bool                host_backend;   // --backend-host, one device hashing on the host CPU, no OpenCL runtime loaded
 
   void               *ocl;
 
@@ -874,6 +1110,13 @@ typedef struct opencl_ctx
 
   int                 force_jit_compilation;
 
+  kernel_group_t     *kernel_groups;      // salts sharing the parameters baked into the kernel at build time
+  u32                 kernel_groups_cnt;
+  u32                *salts_kernel_group; // salt_pos -> kernel group
+
+  bool                session_kept;       // programs and device buffers of the last outer loop are still alive
+  opencl_session_key_t session_key;       // what they were set up for
+
 } opencl_ctx_t;
 
 #include "ext_ADL.h"
@@ -942,6 +1185,35 @@ typedef struct debugfile_ctx
 
 } debugfile_ctx_t;
 
+typedef struct compact_ctx
+{
+  bool enabled;
+
+  hc_thread_mutex_t mux_compact;
+
+  compact_image_t *image;       // latest one, NULL until the first compaction
+
+  u32    gen;
+  u32    digests_done;          // hashes->digests_done when the latest one was taken
+  u32    digests_live;
+  time_t compact_last;
+
+} compact_ctx_t;
+
+typedef struct dedup_ctx
+{
+  bool enabled;
+
+  u64 *bloom_buf;
+  u64  bloom_mask;
+
+  u64  skipped;
+
+  u64  words_sum;   // base words of all dictionaries so far, to size check the filter
+  bool warned;
+
+} dedup_ctx_t;
+
 typedef struct dictstat
 {
   u64 cnt;
@@ -981,6 +1253,15 @@ typedef struct loopback_ctx
 
 } loopback_ctx_t;
 
+typedef struct metrics_ctx
+{
+  bool enabled;
+
+  char *filename;
+  char *filename_tmp;
+
+} metrics_ctx_t;
+
 typedef struct cs
 {
   u32  cs_buf[0x100];
@@ -1059,6 +1340,14 @@ typedef struct restore_ctx
 
   restore_data_t *rd;
 
+  char   *journal_file;
+  FILE   *journal_fp;
+
+  restore_range_t *journal_buf; // records read on --restore, consumed by the first restore_journal_begin ()
+  u32     journal_cnt;
+
+  hc_thread_mutex_t mux_journal;
+
 } restore_ctx_t;
 
 typedef struct cpu_rule
@@ -1084,6 +1373,90 @@ typedef struct out
 
 } out_t;
 
+typedef struct tunecache
+{
+  // key
+
+  char device_name_chksum[16];
+  u32  kern_type;
+  u32  attack_exec;
+  u32  attack_kern;
+  u32  device_processors;
+  u32  kernel_threads;
+  u32  kernel_accel_min;
+  u32  kernel_accel_max;
+  u32  kernel_loops_min;
+  u32  kernel_loops_max;
+  u32  target_msec;
+
+  // tuned
+
+  u32  kernel_accel;
+  u32  kernel_loops;
+
+} tunecache_t;
+
+typedef enum trace_span
+{
+  TRACE_FETCH          = 0,  // get_work () and filling pws_buf with base words
+  TRACE_RULES          = 1,  // rules applied on the host
+  TRACE_COPY           = 2,  // run_copy ()
+  TRACE_KERNEL_ENQUEUE = 3,  // kernel args, enqueue and flush
+  TRACE_KERNEL_WAIT    = 4,  // host waiting for the kernel to finish
+  TRACE_KERNEL_DEVICE  = 5,  // kernel execution, from the OpenCL profiling counters
+  TRACE_CRACK_CHECK    = 6,  // check_cracked ()
+  TRACE_POTFILE_WRITE  = 7,  // potfile_write_append ()
+
+} trace_span_t;
+
+typedef struct trace_event
+{
+  u64  ts;    // usec since trace_init ()
+  u32  dur;   // usec
+  u32  span;
+  u64  arg;
+
+} trace_event_t;
+
+typedef struct trace_ring
+{
+  trace_event_t *buf;
+  u32            pos;
+  u32            cnt;
+
+} trace_ring_t;
+
+typedef struct trace_ctx
+{
+  bool enabled;
+
+  char *filename;
+
+  hc_timer_t timer_start;
+
+  trace_ring_t *rings;  // one per device, only written by the thread of that device
+  u32           rings_cnt;
+
+} trace_ctx_t;
+
+typedef struct tunecache_ctx
+{
+  bool enabled;
+
+  char *filename;
+
+  tunecache_t *base;
+
+  #if defined (_POSIX)
+  size_t cnt;
+  #else
+  u32    cnt;
+  #endif
+
+  hc_thread_mutex_t mux_tunecache;
+
+} tunecache_ctx_t;
+
 typedef struct tuning_db_alias
 {
   char *device_name;
@@ -1151,6 +1524,7 @@ typedef struct user_options
   bool   workload_profile_chgd;
   bool   segment_size_chgd;
 
+  bool   backend_host;
   bool   benchmark;
   bool   force;
   bool   gpu_temp_disable;
@@ -1175,6 +1549,7 @@ typedef struct user_options
   bool   restore_disable;
   bool   show;
   bool   status;
+  bool   status_json;
   bool   stdout_flag;
   bool   speed_only;
   bool   usage;
@@ -1187,7 +1562,9 @@ typedef struct user_options
   char  *custom_charset_4;
   char  *debug_file;
   char  *induction_dir;
+  char  *kernel_warmup;
   char  *markov_hcstat;
+  char  *metrics_file;
   char  *opencl_devices;
   char  *opencl_device_types;
   char  *opencl_platforms;
@@ -1199,15 +1576,18 @@ typedef struct user_options
   char  *rule_buf_r;
   char   separator;
   char  *session;
+  char  *trace_file;
   char  *truecrypt_keyfiles;
   char  *veracrypt_keyfiles;
   u32    attack_mode;
   u32    bitmap_max;
   u32    bitmap_min;
   u32    debug_mode;
+  u32    dedup_candidates;
   u32    gpu_temp_abort;
   u32    gpu_temp_retain;
   u32    hash_mode;
+  u32    host_rule_threads;
   u32    increment_max;
   u32    increment_min;
   u32    kernel_accel;
@@ -1274,6 +1654,19 @@ typedef struct bitmap_ctx
 
 } bitmap_ctx_t;
 
+typedef struct feed_ctx
+{
+  bool enabled;
+  bool finished;  // no more batches will be pushed
+
+  feed_batch_t *batches;  // ring of FEED_BATCHES
+  u32           batches_head;
+  u32           batches_cnt;
+
+  hc_thread_mutex_t mux_feed;
+
+} feed_ctx_t;
+
 typedef struct folder_config
 {
   char *cwd;
@@ -1311,6 +1704,8 @@ typedef struct straight_ctx
 
   u32             kernel_rules_cnt;
   kernel_rule_t  *kernel_rules_buf;
+  kernel_rule_t  *kernel_rules_buf_orig; // unfolded rules, only kept for --debug-mode
+  u32             kernel_rules_folded;
 
   char **dicts;
   u32    dicts_pos;
@@ -1333,6 +1728,10 @@ typedef struct combinator_ctx
   u32 combs_mode;
   u32 combs_cnt;
 
+  comb_t *combs_buf;      // pre-filtered amplifiers, only set if a device can hold them resident
+  u32     combs_buf_cnt;
+  u32     combs_rejected;
+
 } combinator_ctx_t;
 
 typedef struct mask_ctx
@@ -1415,13 +1814,15 @@ typedef struct status_ctx
   u64  words_base;              // the unamplified max keyspace
   u64  words_cnt;               // the amplified max keyspace
 
+  restore_range_t *words_skip_buf; // ranges above words_off a previous run already finished, sorted, get_work () skips them
+  u32  words_skip_cnt;
+  u64  words_skip_sum;          // number of words in words_skip_buf
+
   /**
    * progress
    */
 
-  u64 *words_progress_done;     // progress number of words done     per salt
-  u64 *words_progress_rejected; // progress number of words rejected per salt
-  u64 *words_progress_restored; // progress number of words restored per salt
+  u64  words_progress_restored; // progress number of words restored, same for every salt
 
   /**
    * timer
@@ -1502,10 +1903,13 @@ typedef struct hashcat_ctx
 {
   bitmap_ctx_t          *bitmap_ctx;
   combinator_ctx_t      *combinator_ctx;
+  compact_ctx_t         *compact_ctx;
   cpt_ctx_t             *cpt_ctx;
   debugfile_ctx_t       *debugfile_ctx;
+  dedup_ctx_t           *dedup_ctx;
   dictstat_ctx_t        *dictstat_ctx;
   event_ctx_t           *event_ctx;
+  feed_ctx_t            *feed_ctx;
   folder_config_t       *folder_config;
   hashcat_user_t        *hashcat_user;
   hashconfig_t          *hashconfig;
@@ -1515,6 +1919,7 @@ typedef struct hashcat_ctx
   logfile_ctx_t         *logfile_ctx;
   loopback_ctx_t        *loopback_ctx;
   mask_ctx_t            *mask_ctx;
+  metrics_ctx_t         *metrics_ctx;
   opencl_ctx_t          *opencl_ctx;
   outcheck_ctx_t        *outcheck_ctx;
   outfile_ctx_t         *outfile_ctx;
@@ -1522,6 +1927,8 @@ typedef struct hashcat_ctx
   restore_ctx_t         *restore_ctx;
   status_ctx_t          *status_ctx;
   straight_ctx_t        *straight_ctx;
+  trace_ctx_t           *trace_ctx;
+  tunecache_ctx_t       *tunecache_ctx;
   tuning_db_t           *tuning_db;
   user_options_extra_t  *user_options_extra;
   user_options_t        *user_options;
@@ -1537,6 +1944,9 @@ typedef struct
   double  hashes_msec_dev;
   double  hashes_msec_dev_benchmark;
   double  exec_msec_dev;
+  u32     kernel_accel_dev;
+  u32     kernel_loops_dev;
+  u32     retune_cnt_dev;
   char   *speed_sec_dev;
   char   *input_candidates_dev;
   char   *hwmon_dev;
@@ -1571,6 +1981,7 @@ typedef struct
   double  progress_finished_percent;
   u64     progress_cur;
   u64     progress_cur_relative_skip;
+  u64     progress_dedup;
   u64     progress_done;
   u64     progress_end;
   u64     progress_end_relative_skip;
@@ -1600,6 +2011,45 @@ typedef struct
 
 } hashcat_status_t;
 
+typedef struct
+{
+  bool    skipped_dev;
+  double  hashes_msec_dev;
+  double  exec_msec_dev;
+  u64     progress_done_dev;
+  u32     kernel_accel_dev;
+  u32     kernel_loops_dev;
+  int     temperature_dev;
+  int     fanspeed_dev;
+  int     utilization_dev;
+
+} status_snapshot_dev_t;
+
+// numbers only, no formatted strings, filled by hashcat_get_status_snapshot ()
+
+typedef struct
+{
+  time_t  timestamp;
+  int     status_number;
+  int     digests_cnt;
+  int     digests_done;
+  int     salts_cnt;
+  int     salts_done;
+  u64     cracked_total;
+  double  msec_running;
+  u64     progress_cur_relative_skip;
+  u64     progress_end_relative_skip;
+  u64     progress_done;
+  u64     progress_rejected;
+  u64     restore_point;
+  u64     restore_total;
+  double  hashes_msec_all;
+
+  status_snapshot_dev_t device_buf[DEVICES_MAX];
+  int                   device_cnt;
+
+} status_snapshot_t;
+
 typedef struct thread_param
 {
   u32 tid;
@@ -1608,4 +2058,32 @@ typedef struct thread_param
 
 } thread_param_t;
 
+typedef struct kernel_prebuild
+{
+  hashcat_ctx_t     *hashcat_ctx;
+  hc_device_param_t *device_param;
+
+  char build_opts[1024];
+
+  // main, mp and amp program
+
+  char source_file[3][256];
+  char cached_file[3][256];
+  u32  files_cnt;
+
+} kernel_prebuild_t;
+
+typedef struct host_rules_param
+{
+  const kernel_rule_t *kernel_rules_buf;
+  u32                  kernel_rules_cnt;
+
+  const pw_t *base_buf;
+  pw_t       *exp_buf;
+
+  u32 words_start;
+  u32 words_stop;
+
+} host_rules_param_t;
+
 #endif // _TYPES_H
@@ -11,10 +11,12 @@
 typedef enum user_options_defaults
 {
   ATTACK_MODE             = ATTACK_MODE_STRAIGHT,
+  BACKEND_HOST            = false,
   BENCHMARK               = false,
   BITMAP_MAX              = 24,
   BITMAP_MIN              = 16,
   DEBUG_MODE              = 0,
+  DEDUP_CANDIDATES        = 0,
   FORCE                   = false,
   GPU_TEMP_ABORT          = 90,
   GPU_TEMP_DISABLE        = false,
@@ -23,6 +25,7 @@ typedef enum user_options_defaults
   HEX_CHARSET             = false,
   HEX_SALT                = false,
   HEX_WORDLIST            = false,
+  HOST_RULE_THREADS       = 0,
   INCREMENT               = false,
   INCREMENT_MAX           = PW_MAX,
   INCREMENT_MIN           = 1,
@@ -61,6 +64,7 @@ typedef enum user_options_defaults
   SHOW                    = false,
   SKIP                    = 0,
   STATUS                  = false,
+  STATUS_JSON             = false,
   STATUS_TIMER            = 10,
   STDOUT_FLAG             = false,
   SPEED_ONLY              = false,
@@ -75,6 +79,7 @@ typedef enum user_options_defaults
 typedef enum user_options_map
 {
   IDX_ATTACK_MODE              = 'a',
+  IDX_BACKEND_HOST             = 0xff3c,
   IDX_BENCHMARK                = 'b',
   IDX_BITMAP_MAX               = 0xff00,
   IDX_BITMAP_MIN               = 0xff01,
@@ -85,6 +90,7 @@ typedef enum user_options_map
   IDX_CUSTOM_CHARSET_4         = '4',
   IDX_DEBUG_FILE               = 0xff03,
   IDX_DEBUG_MODE               = 0xff04,
+  IDX_DEDUP_CANDIDATES         = 0xff37,
   IDX_FORCE                    = 0xff05,
   IDX_GPU_TEMP_ABORT           = 0xff06,
   IDX_GPU_TEMP_DISABLE         = 0xff07,
@@ -94,12 +100,14 @@ typedef enum user_options_map
   IDX_HEX_CHARSET              = 0xff09,
   IDX_HEX_SALT                 = 0xff0a,
   IDX_HEX_WORDLIST             = 0xff0b,
+  IDX_HOST_RULE_THREADS        = 0xff36,
   IDX_INCREMENT                = 'i',
   IDX_INCREMENT_MAX            = 0xff0c,
   IDX_INCREMENT_MIN            = 0xff0d,
   IDX_INDUCTION_DIR            = 0xff0e,
   IDX_KERNEL_ACCEL             = 'n',
   IDX_KERNEL_LOOPS             = 'u',
+  IDX_KERNEL_WARMUP            = 0xff3b,
   IDX_KEYSPACE                 = 0xff0f,
   IDX_LEFT                     = 0xff10,
   IDX_LIMIT                    = 'l',
@@ -110,6 +118,7 @@ typedef enum user_options_map
   IDX_MARKOV_DISABLE           = 0xff15,
   IDX_MARKOV_HCSTAT            = 0xff16,
   IDX_MARKOV_THRESHOLD         = 't',
+  IDX_METRICS_FILE             = 0xff38,
   IDX_NVIDIA_SPIN_DAMP         = 0xff17,
   IDX_OPENCL_DEVICES           = 'd',
   IDX_OPENCL_DEVICE_TYPES      = 'D',
@@ -144,9 +153,11 @@ typedef enum user_options_map
   IDX_SHOW                     = 0xff2c,
   IDX_SKIP                     = 's',
   IDX_STATUS                   = 0xff2d,
+  IDX_STATUS_JSON              = 0xff3a,
   IDX_STATUS_TIMER             = 0xff2e,
   IDX_STDOUT_FLAG              = 0xff2f,
   IDX_SPEED_ONLY               = 0xff30,
+  IDX_TRACE_FILE               = 0xff39,
   IDX_TRUECRYPT_KEYFILES       = 0xff31,
   IDX_USERNAME                 = 0xff32,
   IDX_VERACRYPT_KEYFILES       = 0xff33,
@@ -166,6 +177,8 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv);
 
 int user_options_sanity (hashcat_ctx_t *hashcat_ctx);
 
+int user_options_job_check (hashcat_ctx_t *hashcat_ctx, const user_options_t *session_options);
+
 void user_options_preprocess (hashcat_ctx_t *hashcat_ctx);
 
 void user_options_extra_init (hashcat_ctx_t *hashcat_ctx);
@@ -6,8 +6,10 @@
 #include "common.h"
 #include "types.h"
 #include "event.h"
+#include "thread.h"
 #include "opencl.h"
 #include "status.h"
+#include "tunecache.h"
 #include "autotune.h"
 
 static double try_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kernel_accel, const u32 kernel_loops)
@@ -77,13 +79,31 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
   }
 
   // from here it's clear we are allowed to autotune
+  // but maybe we did already, for the same kernel and the same limits
+
+  tunecache_t tunecache;
+
+  tunecache_key (hashcat_ctx, device_param, &tunecache);
+
+  if (tunecache_find (hashcat_ctx, &tunecache) == true)
+  {
+    device_param->kernel_accel = tunecache.kernel_accel;
+    device_param->kernel_loops = tunecache.kernel_loops;
+
+    const u32 kernel_power = device_param->device_processors * device_param->kernel_threads * device_param->kernel_accel;
+
+    device_param->kernel_power = kernel_power;
+
+    return 0;
+  }
+
   // so let's init some fake words
 
   const u32 kernel_power_max = device_param->device_processors * device_param->kernel_threads * kernel_accel_max;
 
   int CL_rc;
 
-  if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+  if ((user_options_extra->attack_kern == ATTACK_KERN_BF) && (device_param->is_host == false))
   {
     CL_rc = run_kernel_memset (hashcat_ctx, device_param, device_param->d_pws_buf, 7, kernel_power_max * sizeof (pw_t));
 
@@ -98,14 +118,17 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
       device_param->pws_buf[i].pw_len = 7 + (i & 7);
     }
 
-    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_pws_buf, CL_TRUE, 0, kernel_power_max * sizeof (pw_t), device_param->pws_buf, 0, NULL, NULL);
+    if (device_param->is_host == false)
+    {
+      CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_pws_buf, CL_TRUE, 0, kernel_power_max * sizeof (pw_t), device_param->pws_buf, 0, NULL, NULL);
 
-    if (CL_rc == -1) return -1;
+      if (CL_rc == -1) return -1;
+    }
   }
 
   if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
   {
-    if (straight_ctx->kernel_rules_cnt > 1)
+    if ((straight_ctx->kernel_rules_cnt > 1) && (device_param->is_host == false))
     {
       CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_rules, device_param->d_rules_c, 0, 0, MIN (kernel_loops_max, KERNEL_RULES) * sizeof (kernel_rule_t), 0, NULL, NULL);
 
@@ -247,9 +270,16 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
   hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_pws_amp_buf, CL_TRUE, 0, kernel_power_max * sizeof (pw_t), device_param->pws_buf, 0, NULL, NULL);
   */
 
-  CL_rc = run_kernel_memset (hashcat_ctx, device_param, device_param->d_pws_buf, 0, kernel_power_max * sizeof (pw_t));
+  if (device_param->is_host == true)
+  {
+    memset (device_param->pws_buf, 0, kernel_power_max * sizeof (pw_t));
+  }
+  else
+  {
+    CL_rc = run_kernel_memset (hashcat_ctx, device_param, device_param->d_pws_buf, 0, kernel_power_max * sizeof (pw_t));
 
-  if (CL_rc == -1) return -1;
+    if (CL_rc == -1) return -1;
+  }
 
   if (hashconfig->attack_exec == ATTACK_EXEC_OUTSIDE_KERNEL)
   {
@@ -277,6 +307,13 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
 
   device_param->kernel_power = kernel_power;
 
+  // remember for the next mask or dictionary, and for the next session
+
+  tunecache.kernel_accel = kernel_accel;
+  tunecache.kernel_loops = kernel_loops;
+
+  tunecache_append (hashcat_ctx, &tunecache);
+
   #if defined (DEBUG)
 
   user_options_t *user_options = hashcat_ctx->user_options;
@@ -301,6 +338,115 @@ static int autotune (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
   return 0;
 }
 
+void autotune_online (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 pws_cnt)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  opencl_ctx_t   *opencl_ctx   = hashcat_ctx->opencl_ctx;
+  status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  // the one-shot autotune() runs on fake words and a single salt, real batches drift away from that:
+  // salts get cracked, words have other lengths, -a 1 amplifiers vary, so keep the launches at target_msec
+
+  if (user_options->speed_only == true) return;
+
+  if (hashconfig->hash_mode == 2000) return;
+
+  if (device_param->host_rules == true) return;
+
+  const u32 kernel_accel_min = device_param->kernel_accel_min;
+  const u32 kernel_accel_max = device_param->kernel_accel_max;
+
+  const u32 kernel_loops_min = device_param->kernel_loops_min;
+  const u32 kernel_loops_max = device_param->kernel_loops_max;
+
+  if ((kernel_accel_min == kernel_accel_max) && (kernel_loops_min == kernel_loops_max)) return;
+
+  // only full batches are representative, the final ones are cut by kernel_power_final anyway
+
+  if (opencl_ctx->kernel_power_final) return;
+
+  if (pws_cnt < device_param->kernel_power) return;
+
+  device_param->retune_batches++;
+
+  if (device_param->retune_batches < RETUNE_BATCHES) return;
+
+  const double exec_msec = get_avg_exec_time (device_param, RETUNE_EXEC_CNT);
+
+  if (exec_msec <= 0) return;
+
+  const double target_msec = opencl_ctx->target_msec;
+
+  const double ratio = target_msec / exec_msec;
+
+  // dead band, jitter of a few percent is normal
+
+  if ((ratio > 0.8) && (ratio < 1.25)) return;
+
+  u32 kernel_accel = device_param->kernel_accel;
+  u32 kernel_loops = device_param->kernel_loops;
+
+  if (ratio < 1)
+  {
+    kernel_accel = MAX (kernel_accel_min, (u32) (kernel_accel * ratio));
+
+    // kernel_loops is only a slice of the iterations for slow hashes, for fast hashes it has more dependencies
+
+    if ((kernel_accel == device_param->kernel_accel) && (hashconfig->attack_exec == ATTACK_EXEC_OUTSIDE_KERNEL))
+    {
+      kernel_loops = MAX (kernel_loops_min, (u32) (kernel_loops * ratio));
+    }
+  }
+  else
+  {
+    // grow slowly, a single short launch should not double the workload
+
+    kernel_accel = MIN (kernel_accel_max, (u32) (kernel_accel * MIN (ratio, 2.0)));
+
+    if ((kernel_accel == device_param->kernel_accel) && (hashconfig->attack_exec == ATTACK_EXEC_OUTSIDE_KERNEL))
+    {
+      kernel_loops = MIN (kernel_loops_max, (u32) (kernel_loops * MIN (ratio, 2.0)));
+    }
+  }
+
+  if ((kernel_accel == device_param->kernel_accel) && (kernel_loops == device_param->kernel_loops)) return;
+
+  // serialize concurrent retunes, get_work() reads kernel_power_all without locking
+
+  hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+
+  device_param->kernel_accel = kernel_accel;
+  device_param->kernel_loops = kernel_loops;
+
+  device_param->kernel_power = device_param->device_processors * device_param->kernel_threads * kernel_accel;
+
+  u32 kernel_power_all = 0;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    kernel_power_all += opencl_ctx->devices_param[device_id].kernel_power;
+  }
+
+  opencl_ctx->kernel_power_all = kernel_power_all;
+
+  hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+
+  // the old timings are meaningless now
+
+  device_param->exec_pos = 0;
+
+  memset (device_param->exec_msec, 0, EXEC_CACHE * sizeof (double));
+
+  memset (device_param->exec_us_prev1, 0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev2, 0, EXPECTED_ITERATIONS * sizeof (double));
+  memset (device_param->exec_us_prev3, 0, EXPECTED_ITERATIONS * sizeof (double));
+
+  device_param->retune_batches = 0;
+
+  device_param->retune_cnt++;
+}
+
 void *thread_autotune (void *p)
 {
   thread_param_t *thread_param = (thread_param_t *) p;
@@ -315,6 +461,8 @@ void *thread_autotune (void *p)
 
   if (device_param->skipped == true) return NULL;
 
+  device_param->retune_batches = 0;
+
   const int rc_autotune = autotune (hashcat_ctx, device_param);
 
   if (rc_autotune == -1)
@@ -0,0 +1,969 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "timer.h"
+#include "hashcat.h"
+#include "user_options.h"
+#include "interface.h"
+#include "hashes.h"
+#include "potfile.h"
+#include "wordlist.h"
+#include "rp.h"
+#include "rp_cpu.h"
+#include "rp_kernel_on_cpu.h"
+#include "mpsp.h"
+
+/**
+ * micro-benchmarks for the host side of a session, no OpenCL runtime needed
+ * all corpora are generated from a fixed seed, so two runs see the same input
+ * each stage runs a number of rounds and the fastest round is reported
+ */
+
+#define BENCH_SEED       0x5eed1234
+#define BENCH_ROUNDS     5
+#define BENCH_WORDS      1000000
+#define BENCH_RULE_WORDS 100000
+#define BENCH_HASHES     100000
+#define BENCH_MASK_CANDS 10000000
+
+static const char *BENCH_RULES[] =
+{
+  ":", "l", "u", "c", "C", "t", "T2", "r", "d", "p2", "f", "{", "}", "[", "]",
+  "$1", "^1", "D2", "x13", "O12", "i2x", "o2x", "'5", "sa@", "@a", "z2", "Z2",
+  "q", "k", "K", "*12", "L1", "R1", "+1", "-1", ".1", ",1", "y2", "Y2", "E",
+  "c $1 $2 $3", "sa@ se3 so0 si1", "u r ^x", "l d '9",
+};
+
+static const u32 BENCH_MODES[] = { 0, 10, 100, 1000, 1400, 1700 };
+
+static const char BENCH_CHARSET[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+static const char BENCH_HEX[] = "0123456789abcdef";
+
+typedef struct bench_stage
+{
+  char   name[64];
+
+  u64    ops;
+  u64    bytes;
+  double ms; // fastest round
+
+} bench_stage_t;
+
+typedef struct bench
+{
+  char *tmpdir;
+  char *dictfile;
+  char *hashfile;
+  char *potfile;
+
+  char *words_buf;
+  u64   words_len;
+  u32   words_cnt;
+
+  u32   rounds;
+  u32   scale;
+
+  bench_stage_t *stages;
+  u32            stages_cnt;
+  u32            stages_avail;
+
+} bench_t;
+
+static volatile u64 bench_sink = 0; // keeps the compiler from dropping the results
+
+static u32 bench_rand_state = BENCH_SEED;
+
+static u32 bench_rand (void)
+{
+  // xorshift32, the same sequence on every platform, unlike rand ()
+
+  u32 x = bench_rand_state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x <<  5;
+
+  bench_rand_state = x;
+
+  return x;
+}
+
+static void bench_event (const u32 id, hashcat_ctx_t *hashcat_ctx, MAYBE_UNUSED const void *buf, MAYBE_UNUSED const size_t len)
+{
+  if (id != EVENT_LOG_ERROR) return;
+
+  const event_ctx_t *event_ctx = hashcat_ctx->event_ctx;
+
+  fprintf (stderr, "%s\n", event_ctx->msg_buf);
+}
+
+static bench_stage_t *bench_stage (hashcat_ctx_t *hashcat_ctx, bench_t *bench, const char *name, const u32 hash_mode)
+{
+  char buf[64];
+
+  if (hash_mode == (u32) -1)
+  {
+    snprintf (buf, sizeof (buf), "%s", name);
+  }
+  else
+  {
+    snprintf (buf, sizeof (buf), "%s/m%u", name, hash_mode);
+  }
+
+  for (u32 i = 0; i < bench->stages_cnt; i++)
+  {
+    if (strcmp (bench->stages[i].name, buf) == 0) return &bench->stages[i];
+  }
+
+  if (bench->stages_cnt == bench->stages_avail)
+  {
+    bench->stages = (bench_stage_t *) hcrealloc (hashcat_ctx, bench->stages, bench->stages_avail * sizeof (bench_stage_t), 32 * sizeof (bench_stage_t));
+
+    if (bench->stages == NULL) return NULL;
+
+    bench->stages_avail += 32;
+  }
+
+  bench_stage_t *stage = &bench->stages[bench->stages_cnt];
+
+  memcpy (stage->name, buf, sizeof (stage->name));
+
+  stage->ops   = 0;
+  stage->bytes = 0;
+  stage->ms    = -1;
+
+  bench->stages_cnt++;
+
+  return stage;
+}
+
+static void bench_record (bench_stage_t *stage, const u64 ops, const u64 bytes, const double ms)
+{
+  // ops and bytes are the same for every round, only the time changes
+
+  stage->ops   = ops;
+  stage->bytes = bytes;
+
+  if ((stage->ms < 0) || (ms < stage->ms)) stage->ms = ms;
+}
+
+static int bench_write_file (hashcat_ctx_t *hashcat_ctx, const char *filename, const char *buf, const u64 len)
+{
+  FILE *fp = fopen (filename, "wb");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", filename, strerror (errno));
+
+    return -1;
+  }
+
+  const size_t nwrite = fwrite (buf, 1, len, fp);
+
+  fclose (fp);
+
+  if (nwrite != len)
+  {
+    event_log_error (hashcat_ctx, "%s: short write", filename);
+
+    return -1;
+  }
+
+  return 0;
+}
+
+static void bench_gen_word (char *out, u32 *out_len, const u32 len_min, const u32 len_max)
+{
+  const u32 len = len_min + (bench_rand () % (len_max - len_min + 1));
+
+  for (u32 i = 0; i < len; i++)
+  {
+    out[i] = BENCH_CHARSET[bench_rand () % (sizeof (BENCH_CHARSET) - 1)];
+  }
+
+  *out_len = len;
+}
+
+static void bench_gen_hex (char *out, const u32 len)
+{
+  for (u32 i = 0; i < len; i++)
+  {
+    out[i] = BENCH_HEX[bench_rand () & 15];
+  }
+}
+
+/**
+ * wordlist: the line splitters and count_words ()
+ */
+
+static int bench_gen_words (hashcat_ctx_t *hashcat_ctx, bench_t *bench)
+{
+  const u32 words_cnt = BENCH_WORDS * bench->scale;
+
+  // at most 16 chars, one of 16 lines ends with \r\n
+
+  bench->words_buf = (char *) hcmalloc (hashcat_ctx, (u64) words_cnt * 18); VERIFY_PTR (bench->words_buf);
+
+  u64 pos = 0;
+
+  for (u32 i = 0; i < words_cnt; i++)
+  {
+    u32 len;
+
+    bench_gen_word (bench->words_buf + pos, &len, 1, 16);
+
+    pos += len;
+
+    if ((i & 15) == 15) bench->words_buf[pos++] = '\r';
+
+    bench->words_buf[pos++] = '\n';
+  }
+
+  bench->words_len = pos;
+  bench->words_cnt = words_cnt;
+
+  return bench_write_file (hashcat_ctx, bench->dictfile, bench->words_buf, bench->words_len);
+}
+
+static int bench_wordlist (hashcat_ctx_t *hashcat_ctx, bench_t *bench)
+{
+  typedef void (*wl_func_t) (char *, u64, u64 *, u64 *);
+
+  static const struct { const char *name; wl_func_t func; } splitters[] =
+  {
+    { "get_next_word_std", get_next_word_std },
+    { "get_next_word_uc",  get_next_word_uc  },
+    { "get_next_word_lm",  get_next_word_lm  },
+  };
+
+  // the uc and lm variants change the buffer, so they get their own copy
+
+  char *buf = (char *) hcmalloc (hashcat_ctx, bench->words_len); VERIFY_PTR (buf);
+
+  for (u32 splitter_pos = 0; splitter_pos < sizeof (splitters) / sizeof (splitters[0]); splitter_pos++)
+  {
+    bench_stage_t *stage = bench_stage (hashcat_ctx, bench, splitters[splitter_pos].name, (u32) -1); VERIFY_PTR (stage);
+
+    for (u32 round = 0; round < bench->rounds; round++)
+    {
+      memcpy (buf, bench->words_buf, bench->words_len);
+
+      hc_timer_t timer;
+
+      hc_timer_set (&timer);
+
+      u64 ops = 0;
+      u64 sum = 0;
+
+      for (u64 pos = 0; pos < bench->words_len; ops++)
+      {
+        u64 len;
+        u64 off;
+
+        splitters[splitter_pos].func (buf + pos, bench->words_len - pos, &len, &off);
+
+        sum += len;
+        pos += off;
+      }
+
+      bench_record (stage, ops, bench->words_len, hc_timer_get (timer));
+
+      bench_sink += sum;
+    }
+  }
+
+  hcfree (buf);
+
+  // count_words () goes through load_segment (), so this one includes the reads
+
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
+
+  user_options->hash_mode = 0;
+
+  if (hashconfig_init (hashcat_ctx) == -1) return -1;
+
+  user_options_extra->attack_kern = ATTACK_KERN_STRAIGHT;
+  user_options_extra->rule_len_l  = (int) strlen (user_options->rule_buf_l);
+
+  straight_ctx->kernel_rules_cnt = 1;
+
+  if (wl_data_init (hashcat_ctx) == -1) return -1;
+
+  FILE *fd = fopen (bench->dictfile, "rb");
+
+  if (fd == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", bench->dictfile, strerror (errno));
+
+    return -1;
+  }
+
+  bench_stage_t *stage = bench_stage (hashcat_ctx, bench, "count_words", (u32) -1); VERIFY_PTR (stage);
+
+  for (u32 round = 0; round < bench->rounds; round++)
+  {
+    rewind (fd);
+
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    const u64 cnt = count_words (hashcat_ctx, fd, bench->dictfile);
+
+    bench_record (stage, bench->words_cnt, bench->words_len, hc_timer_get (timer));
+
+    bench_sink += cnt;
+  }
+
+  fclose (fd);
+
+  wl_data_destroy (hashcat_ctx);
+
+  hashconfig_destroy (hashcat_ctx);
+
+  return 0;
+}
+
+/**
+ * rules: both rule engines and the conversion between them
+ */
+
+static int bench_rules (hashcat_ctx_t *hashcat_ctx, bench_t *bench)
+{
+  const u32 rules_cnt = sizeof (BENCH_RULES) / sizeof (BENCH_RULES[0]);
+
+  kernel_rule_t *kernel_rules = (kernel_rule_t *) hccalloc (hashcat_ctx, rules_cnt, sizeof (kernel_rule_t)); VERIFY_PTR (kernel_rules);
+
+  u64 rules_len = 0;
+
+  for (u32 rule_pos = 0; rule_pos < rules_cnt; rule_pos++)
+  {
+    const u32 rule_len = (u32) strlen (BENCH_RULES[rule_pos]);
+
+    if (cpu_rule_to_kernel_rule ((char *) BENCH_RULES[rule_pos], rule_len, &kernel_rules[rule_pos]) == -1)
+    {
+      event_log_error (hashcat_ctx, "Invalid benchmark rule: %s", BENCH_RULES[rule_pos]);
+
+      hcfree (kernel_rules);
+
+      return -1;
+    }
+
+    rules_len += rule_len;
+  }
+
+  // the words are taken from the wordlist corpus, the first BENCH_RULE_WORDS of it
+
+  const u32 words_cnt = MIN (BENCH_RULE_WORDS * bench->scale, bench->words_cnt);
+
+  u32 *words_off = (u32 *) hccalloc (hashcat_ctx, words_cnt, sizeof (u32)); VERIFY_PTR (words_off);
+  u32 *words_len = (u32 *) hccalloc (hashcat_ctx, words_cnt, sizeof (u32)); VERIFY_PTR (words_len);
+
+  u64 words_bytes = 0;
+
+  for (u32 word_pos = 0, pos = 0; word_pos < words_cnt; word_pos++)
+  {
+    u64 len;
+    u64 off;
+
+    get_next_word_std (bench->words_buf + pos, bench->words_len - pos, &len, &off);
+
+    words_off[word_pos] = pos;
+    words_len[word_pos] = (u32) len;
+
+    words_bytes += len;
+
+    pos += (u32) off;
+  }
+
+  bench_stage_t *stage_cpu = bench_stage (hashcat_ctx, bench, "_old_apply_rule",         (u32) -1); VERIFY_PTR (stage_cpu);
+  bench_stage_t *stage_gpu = bench_stage (hashcat_ctx, bench, "apply_rules",             (u32) -1); VERIFY_PTR (stage_gpu);
+  bench_stage_t *stage_cvt = bench_stage (hashcat_ctx, bench, "cpu_rule_to_kernel_rule", (u32) -1); VERIFY_PTR (stage_cvt);
+
+  for (u32 round = 0; round < bench->rounds; round++)
+  {
+    hc_timer_t timer;
+
+    u64 sum = 0;
+
+    hc_timer_set (&timer);
+
+    for (u32 word_pos = 0; word_pos < words_cnt; word_pos++)
+    {
+      char *word = bench->words_buf + words_off[word_pos];
+
+      for (u32 rule_pos = 0; rule_pos < rules_cnt; rule_pos++)
+      {
+        char out[BLOCK_SIZE] = { 0 };
+
+        sum += _old_apply_rule ((char *) BENCH_RULES[rule_pos], (int) strlen (BENCH_RULES[rule_pos]), word, (int) words_len[word_pos], out);
+      }
+    }
+
+    bench_record (stage_cpu, (u64) words_cnt * rules_cnt, words_bytes * rules_cnt, hc_timer_get (timer));
+
+    hc_timer_set (&timer);
+
+    for (u32 word_pos = 0; word_pos < words_cnt; word_pos++)
+    {
+      for (u32 rule_pos = 0; rule_pos < rules_cnt; rule_pos++)
+      {
+        u32 buf[8] = { 0 };
+
+        memcpy (buf, bench->words_buf + words_off[word_pos], words_len[word_pos]);
+
+        sum += apply_rules (kernel_rules[rule_pos].cmds, buf + 0, buf + 4, words_len[word_pos]);
+      }
+    }
+
+    bench_record (stage_gpu, (u64) words_cnt * rules_cnt, words_bytes * rules_cnt, hc_timer_get (timer));
+
+    hc_timer_set (&timer);
+
+    for (u32 word_pos = 0; word_pos < words_cnt; word_pos++)
+    {
+      for (u32 rule_pos = 0; rule_pos < rules_cnt; rule_pos++)
+      {
+        kernel_rule_t kernel_rule;
+
+        sum += cpu_rule_to_kernel_rule ((char *) BENCH_RULES[rule_pos], (u32) strlen (BENCH_RULES[rule_pos]), &kernel_rule);
+
+        sum += kernel_rule.cmds[0];
+      }
+    }
+
+    bench_record (stage_cvt, (u64) words_cnt * rules_cnt, rules_len * words_cnt, hc_timer_get (timer));
+
+    bench_sink += sum;
+  }
+
+  hcfree (words_off);
+  hcfree (words_len);
+  hcfree (kernel_rules);
+
+  return 0;
+}
+
+/**
+ * mask: sp_exec () on ?l?l?l?l?d?d?d?d, --markov-disable style tables
+ */
+
+static int bench_mask (hashcat_ctx_t *hashcat_ctx, bench_t *bench)
+{
+  const u32 mask_len = 8;
+
+  cs_t *root_css_buf   = (cs_t *) hccalloc (hashcat_ctx, SP_PW_MAX,           sizeof (cs_t)); VERIFY_PTR (root_css_buf);
+  cs_t *markov_css_buf = (cs_t *) hccalloc (hashcat_ctx, SP_PW_MAX * CHARSIZ, sizeof (cs_t)); VERIFY_PTR (markov_css_buf);
+
+  for (u32 pos = 0; pos < mask_len; pos++)
+  {
+    cs_t *cs = &root_css_buf[pos];
+
+    if (pos < 4)
+    {
+      for (u32 c = 'a'; c <= 'z'; c++) cs->cs_buf[cs->cs_len++] = c;
+    }
+    else
+    {
+      for (u32 c = '0'; c <= '9'; c++) cs->cs_buf[cs->cs_len++] = c;
+    }
+  }
+
+  // without markov every predecessor leads to the plain charset of the next position
+
+  for (u32 pos = 0; pos + 1 < mask_len; pos++)
+  {
+    for (u32 c = 0; c < CHARSIZ; c++)
+    {
+      memcpy (&markov_css_buf[(pos * CHARSIZ) + c], &root_css_buf[pos + 1], sizeof (cs_t));
+    }
+  }
+
+  const u64 cands = (u64) BENCH_MASK_CANDS * bench->scale;
+
+  bench_stage_t *stage = bench_stage (hashcat_ctx, bench, "sp_exec", (u32) -1); VERIFY_PTR (stage);
+
+  for (u32 round = 0; round < bench->rounds; round++)
+  {
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    u64 sum = 0;
+
+    for (u64 ctx = 0; ctx < cands; ctx++)
+    {
+      char pw_buf[64];
+
+      sp_exec (ctx, pw_buf, root_css_buf, markov_css_buf, 0, mask_len);
+
+      sum += (u8) pw_buf[ctx & 7];
+    }
+
+    bench_record (stage, cands, cands * mask_len, hc_timer_get (timer));
+
+    bench_sink += sum;
+  }
+
+  hcfree (root_css_buf);
+  hcfree (markov_css_buf);
+
+  return 0;
+}
+
+/**
+ * hashes: parse_func, the hashlist load, potfile_remove_parse () and ascii_digest () per hash-mode
+ */
+
+static int bench_gen_hashes (hashcat_ctx_t *hashcat_ctx, bench_t *bench, char **hashes_buf, u64 *hashes_len, u32 *hashes_cnt, u32 *pot_cnt)
+{
+  const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  const u32 hash_len = hashconfig->dgst_size * 2;
+
+  const u32 cnt = BENCH_HASHES * bench->scale;
+
+  // hash, salt and plain: at most 128 + 1 + 16 + 1 + 16 + 1
+
+  char *buf = (char *) hcmalloc (hashcat_ctx, (u64) cnt * 163); VERIFY_PTR (buf);
+  char *pot = (char *) hcmalloc (hashcat_ctx, (u64) cnt * 163); VERIFY_PTR (pot);
+
+  u64 pos     = 0;
+  u64 pot_pos = 0;
+
+  u64 prev_pos = 0;
+  u64 prev_len = 0;
+
+  u32 pot_lines = 0;
+
+  for (u32 i = 0; i < cnt; i++)
+  {
+    // one in ten lines repeats the previous one, stage 2 has to remove them
+
+    if ((i % 10) == 9)
+    {
+      memmove (buf + pos, buf + prev_pos, prev_len);
+
+      pos += prev_len;
+
+      buf[pos++] = '\n';
+
+      continue;
+    }
+
+    const u64 line_pos = pos;
+
+    bench_gen_hex (buf + pos, hash_len);
+
+    pos += hash_len;
+
+    if (hashconfig->is_salted)
+    {
+      u32 salt_len;
+
+      buf[pos++] = hashconfig->separator;
+
+      bench_gen_word (buf + pos, &salt_len, 4, 16);
+
+      pos += salt_len;
+    }
+
+    prev_pos = line_pos;
+    prev_len = pos - line_pos;
+
+    buf[pos++] = '\n';
+
+    // every other hash is already in the potfile
+
+    if (i & 1)
+    {
+      u32 plain_len;
+
+      memcpy (pot + pot_pos, buf + line_pos, prev_len);
+
+      pot_pos += prev_len;
+
+      pot[pot_pos++] = ':';
+
+      bench_gen_word (pot + pot_pos, &plain_len, 1, 16);
+
+      pot_pos += plain_len;
+
+      pot[pot_pos++] = '\n';
+
+      pot_lines++;
+    }
+  }
+
+  const int rc_hashfile = bench_write_file (hashcat_ctx, bench->hashfile, buf, pos);
+  const int rc_potfile  = bench_write_file (hashcat_ctx, bench->potfile,  pot, pot_pos);
+
+  hcfree (pot);
+
+  if ((rc_hashfile == -1) || (rc_potfile == -1))
+  {
+    hcfree (buf);
+
+    return -1;
+  }
+
+  *hashes_buf = buf;
+  *hashes_len = pos;
+  *hashes_cnt = cnt;
+  *pot_cnt    = pot_lines;
+
+  return 0;
+}
+
+static int bench_hash_mode (hashcat_ctx_t *hashcat_ctx, bench_t *bench, const u32 hash_mode)
+{
+  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  hashes_t             *hashes             = hashcat_ctx->hashes;
+  potfile_ctx_t        *potfile_ctx        = hashcat_ctx->potfile_ctx;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  user_options->hash_mode = hash_mode;
+
+  if (hashconfig_init (hashcat_ctx) == -1) return -1;
+
+  char *lines_buf = NULL;
+  u64   lines_len = 0;
+  u32   lines_cnt = 0;
+  u32   pot_cnt   = 0;
+
+  if (bench_gen_hashes (hashcat_ctx, bench, &lines_buf, &lines_len, &lines_cnt, &pot_cnt) == -1) return -1;
+
+  // parse_func alone, from memory
+
+  hash_t hash_buf;
+
+  memset (&hash_buf, 0, sizeof (hash_buf));
+
+  hash_buf.digest = hcmalloc (hashcat_ctx, hashconfig->dgst_size); VERIFY_PTR (hash_buf.digest);
+  hash_buf.salt   = (salt_t *) hcmalloc (hashcat_ctx, sizeof (salt_t)); VERIFY_PTR (hash_buf.salt);
+  hash_buf.esalt  = hcmalloc (hashcat_ctx, MAX (hashconfig->esalt_size, 1)); VERIFY_PTR (hash_buf.esalt);
+
+  bench_stage_t *stage_parse = bench_stage (hashcat_ctx, bench, "parse_func", hash_mode); VERIFY_PTR (stage_parse);
+
+  for (u32 round = 0; round < bench->rounds; round++)
+  {
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    u32 parser_errors = 0;
+
+    for (u64 pos = 0; pos < lines_len; )
+    {
+      char *line_buf = lines_buf + pos;
+
+      char *line_end = (char *) memchr (line_buf, '\n', lines_len - pos);
+
+      const u32 line_len = (u32) (line_end - line_buf);
+
+      if (hashconfig->parse_func (line_buf, line_len, &hash_buf, hashconfig) != PARSER_OK) parser_errors++;
+
+      pos += line_len + 1;
+    }
+
+    bench_record (stage_parse, lines_cnt, lines_len, hc_timer_get (timer));
+
+    // a corpus that does not parse would only measure the error path
+
+    if (parser_errors)
+    {
+      event_log_error (hashcat_ctx, "Hash-mode %u: %u of %u generated hashes failed to parse", hash_mode, parser_errors, lines_cnt);
+
+      hcfree (hash_buf.digest);
+      hcfree (hash_buf.salt);
+      hcfree (hash_buf.esalt);
+      hcfree (lines_buf);
+
+      return -1;
+    }
+  }
+
+  hcfree (hash_buf.digest);
+  hcfree (hash_buf.salt);
+  hcfree (hash_buf.esalt);
+
+  // the real thing, from the hashfile and the potfile
+
+  user_options_extra->hc_hash = bench->hashfile;
+
+  potfile_ctx->enabled  = true;
+  potfile_ctx->filename = bench->potfile;
+
+  bench_stage_t *stage_stage1 = bench_stage (hashcat_ctx, bench, "hashes_init_stage1",   hash_mode); VERIFY_PTR (stage_stage1);
+  bench_stage_t *stage_sort   = bench_stage (hashcat_ctx, bench, "hashes_sort",          hash_mode); VERIFY_PTR (stage_sort);
+  bench_stage_t *stage_stage2 = bench_stage (hashcat_ctx, bench, "hashes_init_stage2",   hash_mode); VERIFY_PTR (stage_stage2);
+  bench_stage_t *stage_pot    = bench_stage (hashcat_ctx, bench, "potfile_remove_parse", hash_mode); VERIFY_PTR (stage_pot);
+  bench_stage_t *stage_digest = bench_stage (hashcat_ctx, bench, "ascii_digest",         hash_mode); VERIFY_PTR (stage_digest);
+
+  char *out_buf = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE); VERIFY_PTR (out_buf);
+
+  int rc = 0;
+
+  for (u32 round = 0; round < bench->rounds; round++)
+  {
+    hc_timer_t timer;
+
+    hc_timer_set (&timer);
+
+    if (hashes_init_stage1 (hashcat_ctx) == -1) { rc = -1; break; }
+
+    bench_record (stage_stage1, lines_cnt, lines_len, hc_timer_get (timer));
+
+    // stage 1 ends with the sort, redo it from a shuffled copy to see it alone
+
+    const u32 hashes_cnt = hashes->hashes_cnt;
+
+    hash_t *hashes_tmp = (hash_t *) hcmalloc (hashcat_ctx, hashes_cnt * sizeof (hash_t)); VERIFY_PTR (hashes_tmp);
+
+    memcpy (hashes_tmp, hashes->hashes_buf, hashes_cnt * sizeof (hash_t));
+
+    for (u32 i = hashes_cnt - 1; i > 0; i--)
+    {
+      const u32 j = bench_rand () % (i + 1);
+
+      hash_t tmp = hashes_tmp[i];
+
+      hashes_tmp[i] = hashes_tmp[j];
+      hashes_tmp[j] = tmp;
+    }
+
+    hc_timer_set (&timer);
+
+    if (hashconfig->is_salted)
+    {
+      hc_qsort_r (hashes_tmp, hashes_cnt, sizeof (hash_t), sort_by_hash, (void *) hashconfig);
+    }
+    else
+    {
+      hc_qsort_r (hashes_tmp, hashes_cnt, sizeof (hash_t), sort_by_hash_no_salt, (void *) hashconfig);
+    }
+
+    bench_record (stage_sort, hashes_cnt, (u64) hashes_cnt * hashconfig->dgst_size, hc_timer_get (timer));
+
+    hcfree (hashes_tmp);
+
+    hc_timer_set (&timer);
+
+    if (hashes_init_stage2 (hashcat_ctx) == -1) { rc = -1; break; }
+
+    bench_record (stage_stage2, hashes_cnt, (u64) hashes_cnt * hashconfig->dgst_size, hc_timer_get (timer));
+
+    hc_timer_set (&timer);
+
+    if (potfile_remove_parse (hashcat_ctx) == -1) { rc = -1; break; }
+
+    const double ms_pot = hc_timer_get (timer);
+
+    struct stat pot_stat;
+
+    stat (bench->potfile, &pot_stat);
+
+    bench_record (stage_pot, pot_cnt, (u64) pot_stat.st_size, ms_pot);
+
+    hc_timer_set (&timer);
+
+    u64 digests_bytes = 0;
+
+    for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+    {
+      const salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+      for (u32 digest_pos = 0; digest_pos < salt_buf->digests_cnt; digest_pos++)
+      {
+        ascii_digest (hashcat_ctx, out_buf, salt_pos, digest_pos);
+
+        digests_bytes += strlen (out_buf);
+      }
+    }
+
+    bench_record (stage_digest, hashes->digests_cnt, digests_bytes, hc_timer_get (timer));
+
+    // stage 3 would drop the hash_t array, we stop before it
+
+    u32 pot_hits = 0;
+
+    for (u32 hashes_pos = 0; hashes_pos < hashes->hashes_cnt; hashes_pos++)
+    {
+      if (hashes->hashes_buf[hashes_pos].pw_buf == NULL) continue;
+
+      hcfree (hashes->hashes_buf[hashes_pos].pw_buf);
+
+      pot_hits++;
+    }
+
+    hcfree (hashes->hashes_buf);
+
+    hashes_destroy (hashcat_ctx);
+
+    if (pot_hits != pot_cnt)
+    {
+      event_log_error (hashcat_ctx, "Hash-mode %u: %u of %u potfile entries matched", hash_mode, pot_hits, pot_cnt);
+
+      rc = -1;
+
+      break;
+    }
+  }
+
+  hcfree (out_buf);
+  hcfree (lines_buf);
+
+  potfile_ctx->enabled  = false;
+  potfile_ctx->filename = NULL;
+
+  user_options_extra->hc_hash = NULL;
+
+  hashconfig_destroy (hashcat_ctx);
+
+  return rc;
+}
+
+static void bench_report (const bench_t *bench)
+{
+  printf ("{\n");
+  printf ("  \"version\": \"%s\",\n", VERSION_TAG);
+  printf ("  \"seed\": %u,\n", BENCH_SEED);
+  printf ("  \"rounds\": %u,\n", bench->rounds);
+  printf ("  \"scale\": %u,\n", bench->scale);
+  printf ("  \"stages\": [\n");
+
+  for (u32 i = 0; i < bench->stages_cnt; i++)
+  {
+    const bench_stage_t *stage = &bench->stages[i];
+
+    const double ms = MAX (stage->ms, 0.001);
+
+    const double ns_per_op = (ms * 1000000) / (double) MAX (stage->ops, 1);
+    const double mb_per_s  = ((double) stage->bytes / 1000000) / (ms / 1000);
+
+    printf ("    { \"name\": \"%s\", \"ops\": %" PRIu64 ", \"bytes\": %" PRIu64 ", \"ms\": %.3f, \"ns_per_op\": %.2f, \"mb_per_s\": %.2f }%s\n",
+      stage->name,
+      stage->ops,
+      stage->bytes,
+      stage->ms,
+      ns_per_op,
+      mb_per_s,
+      (i + 1 < bench->stages_cnt) ? "," : "");
+  }
+
+  printf ("  ]\n");
+  printf ("}\n");
+}
+
+static void bench_usage (const char *progname)
+{
+  fprintf (stderr, "Usage: %s [-r rounds] [-s scale]\n", progname);
+}
+
+int main (int argc, char **argv)
+{
+  bench_t bench;
+
+  memset (&bench, 0, sizeof (bench));
+
+  bench.rounds = BENCH_ROUNDS;
+  bench.scale  = 1;
+
+  int c;
+
+  while ((c = getopt (argc, argv, "r:s:h")) != -1)
+  {
+    switch (c)
+    {
+      case 'r': bench.rounds = (u32) atoi (optarg); break;
+      case 's': bench.scale  = (u32) atoi (optarg); break;
+      default:  bench_usage (argv[0]); return -1;
+    }
+  }
+
+  if ((bench.rounds == 0) || (bench.scale == 0))
+  {
+    bench_usage (argv[0]);
+
+    return -1;
+  }
+
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) malloc (sizeof (hashcat_ctx_t));
+
+  if (hashcat_ctx == NULL) return -1;
+
+  if (hashcat_init (hashcat_ctx, bench_event) == -1) return -1;
+
+  if (event_ctx_init (hashcat_ctx) == -1) return -1;
+
+  if (user_options_init (hashcat_ctx) == -1) return -1;
+
+  // the corpora go to a private temporary folder, removed at the end
+
+  char tmpdir[] = "/tmp/hashcat-bench-XXXXXX";
+
+  if (mkdtemp (tmpdir) == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tmpdir, strerror (errno));
+
+    return -1;
+  }
+
+  bench.tmpdir   = tmpdir;
+  bench.dictfile = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_TINY);
+  bench.hashfile = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_TINY);
+  bench.potfile  = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_TINY);
+
+  snprintf (bench.dictfile, HCBUFSIZ_TINY - 1, "%s/words.dict", tmpdir);
+  snprintf (bench.hashfile, HCBUFSIZ_TINY - 1, "%s/hashes.txt", tmpdir);
+  snprintf (bench.potfile,  HCBUFSIZ_TINY - 1, "%s/hashes.pot", tmpdir);
+
+  int rc = bench_gen_words (hashcat_ctx, &bench);
+
+  if (rc == 0) rc = bench_wordlist (hashcat_ctx, &bench);
+  if (rc == 0) rc = bench_rules    (hashcat_ctx, &bench);
+  if (rc == 0) rc = bench_mask     (hashcat_ctx, &bench);
+
+  for (u32 mode_pos = 0; mode_pos < sizeof (BENCH_MODES) / sizeof (BENCH_MODES[0]); mode_pos++)
+  {
+    if (rc == 0) rc = bench_hash_mode (hashcat_ctx, &bench, BENCH_MODES[mode_pos]);
+  }
+
+  if (rc == 0) bench_report (&bench);
+
+  unlink (bench.dictfile);
+  unlink (bench.hashfile);
+  unlink (bench.potfile);
+
+  rmdir (tmpdir);
+
+  hcfree (bench.dictfile);
+  hcfree (bench.hashfile);
+  hcfree (bench.potfile);
+  hcfree (bench.words_buf);
+  hcfree (bench.stages);
+
+  user_options_destroy (hashcat_ctx);
+
+  event_ctx_destroy (hashcat_ctx);
+
+  hashcat_destroy (hashcat_ctx);
+
+  free (hashcat_ctx);
+
+  return rc;
+}
@@ -135,6 +135,19 @@ int bitmap_ctx_init (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+void bitmap_ctx_generate (hashcat_ctx_t *hashcat_ctx, const u32 digests_cnt, char *digests_buf, u32 *bitmap_bufs)
+{
+  bitmap_ctx_t *bitmap_ctx = hashcat_ctx->bitmap_ctx;
+  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+
+  // same tables as above, just from a different set of digests, the size and shifts are kept
+
+  const u32 bitmap_nums = bitmap_ctx->bitmap_nums;
+
+  generate_bitmaps (digests_cnt, hashconfig->dgst_size, bitmap_ctx->bitmap_shift1, digests_buf, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, bitmap_ctx->bitmap_mask, bitmap_ctx->bitmap_size, bitmap_bufs + (bitmap_nums * 0), bitmap_bufs + (bitmap_nums * 1), bitmap_bufs + (bitmap_nums * 2), bitmap_bufs + (bitmap_nums * 3), -1ul);
+  generate_bitmaps (digests_cnt, hashconfig->dgst_size, bitmap_ctx->bitmap_shift2, digests_buf, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, bitmap_ctx->bitmap_mask, bitmap_ctx->bitmap_size, bitmap_bufs + (bitmap_nums * 4), bitmap_bufs + (bitmap_nums * 5), bitmap_bufs + (bitmap_nums * 6), bitmap_bufs + (bitmap_nums * 7), -1ul);
+}
+
 void bitmap_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   bitmap_ctx_t *bitmap_ctx = hashcat_ctx->bitmap_ctx;
@@ -7,6 +7,9 @@
 #include "types.h"
 #include "event.h"
 #include "memory.h"
+#include "convert.h"
+#include "filehandling.h"
+#include "rp_cpu.h"
 #include "combinator.h"
 #include "wordlist.h"
 
@@ -177,6 +180,107 @@ int combinator_ctx_init (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+int combinator_ctx_load_combs (hashcat_ctx_t *hashcat_ctx)
+{
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  if (combinator_ctx->enabled == false) return 0;
+
+  if (user_options->attack_mode != ATTACK_MODE_COMBI) return 0;
+
+  // the amplifier side is the smaller dictionary, see combinator_ctx_init()
+
+  const char *dictfilec = (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT) ? combinator_ctx->dict2 : combinator_ctx->dict1;
+
+  FILE *combs_fp = fopen (dictfilec, "rb");
+
+  if (combs_fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", dictfilec, strerror (errno));
+
+    return -1;
+  }
+
+  comb_t *combs_buf = (comb_t *) hccalloc (hashcat_ctx, combinator_ctx->combs_cnt, sizeof (comb_t)); VERIFY_PTR (combs_buf);
+
+  char *line_buf = combinator_ctx->scratch_buf;
+
+  u32 combs_buf_cnt  = 0;
+  u32 combs_rejected = 0;
+
+  // this has to produce exactly the same amplifiers as the streaming path in run_cracker()
+
+  while (combs_buf_cnt < combinator_ctx->combs_cnt)
+  {
+    if (feof (combs_fp)) break;
+
+    int line_len = fgetl (combs_fp, line_buf);
+
+    if (line_len >= PW_MAX1) continue;
+
+    line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
+
+    char *line_buf_new = line_buf;
+
+    char rule_buf_out[BLOCK_SIZE] = { 0 };
+
+    if (run_rule_engine (user_options_extra->rule_len_r, user_options->rule_buf_r))
+    {
+      int rule_len_out = _old_apply_rule (user_options->rule_buf_r, user_options_extra->rule_len_r, line_buf, line_len, rule_buf_out);
+
+      if (rule_len_out < 0)
+      {
+        combs_rejected++;
+
+        continue;
+      }
+
+      line_len = rule_len_out;
+
+      line_buf_new = rule_buf_out;
+    }
+
+    line_len = MIN (line_len, PW_DICTMAX);
+
+    u8 *ptr = (u8 *) combs_buf[combs_buf_cnt].i;
+
+    memcpy (ptr, line_buf_new, line_len);
+
+    if (hashconfig->opts_type & OPTS_TYPE_PT_UPPER)
+    {
+      uppercase (ptr, line_len);
+    }
+
+    if (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT)
+    {
+      if (hashconfig->opts_type & OPTS_TYPE_PT_ADD80)
+      {
+        ptr[line_len] = 0x80;
+      }
+
+      if (hashconfig->opts_type & OPTS_TYPE_PT_ADD01)
+      {
+        ptr[line_len] = 0x01;
+      }
+    }
+
+    combs_buf[combs_buf_cnt].pw_len = line_len;
+
+    combs_buf_cnt++;
+  }
+
+  fclose (combs_fp);
+
+  combinator_ctx->combs_buf      = combs_buf;
+  combinator_ctx->combs_buf_cnt  = combs_buf_cnt;
+  combinator_ctx->combs_rejected = combs_rejected;
+
+  return 0;
+}
+
 void combinator_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   combinator_ctx_t *combinator_ctx = hashcat_ctx->combinator_ctx;
@@ -184,6 +288,7 @@ void combinator_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   if (combinator_ctx->enabled == false) return;
 
   hcfree (combinator_ctx->scratch_buf);
+  hcfree (combinator_ctx->combs_buf);
 
   memset (combinator_ctx, 0, sizeof (combinator_ctx_t));
 }
@@ -0,0 +1,308 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "thread.h"
+#include "bitmap.h"
+#include "opencl.h"
+#include "compact.h"
+
+static void compact_image_free (compact_image_t *image)
+{
+  hcfree (image->digests_buf);
+  hcfree (image->digests_shown);
+  hcfree (image->digests_map);
+  hcfree (image->salts_buf);
+  hcfree (image->bitmap_bufs);
+
+  hcfree (image);
+}
+
+static void compact_image_release (compact_ctx_t *compact_ctx, compact_image_t *image)
+{
+  // only call with mux_compact locked
+
+  if (image == NULL) return;
+
+  image->refs--;
+
+  if ((image->refs == 0) && (image != compact_ctx->image)) compact_image_free (image);
+}
+
+int compact_ctx_init (hashcat_ctx_t *hashcat_ctx)
+{
+  bitmap_ctx_t   *bitmap_ctx   = hashcat_ctx->bitmap_ctx;
+  compact_ctx_t  *compact_ctx  = hashcat_ctx->compact_ctx;
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  hashes_t       *hashes       = hashcat_ctx->hashes;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  compact_ctx->enabled = false;
+
+  if (bitmap_ctx->enabled == false) return 0;
+
+  if (user_options->benchmark   == true) return 0;
+  if (user_options->keyspace    == true) return 0;
+  if (user_options->speed_only  == true) return 0;
+  if (user_options->stdout_flag == true) return 0;
+
+  // single hash kernels compare against one digest anyway
+
+  if (hashes->digests_cnt < 2) return 0;
+
+  // these are never marked as cracked, so there is nothing to drop
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) return 0;
+
+  hc_thread_mutex_init (compact_ctx->mux_compact);
+
+  compact_ctx->image        = NULL;
+  compact_ctx->gen          = 0;
+  compact_ctx->digests_done = hashes->digests_done;
+  compact_ctx->digests_live = hashes->digests_cnt - hashes->digests_done;
+  compact_ctx->compact_last = time (NULL);
+
+  compact_ctx->enabled = true;
+
+  return 0;
+}
+
+void compact_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  compact_ctx_t *compact_ctx = hashcat_ctx->compact_ctx;
+  opencl_ctx_t  *opencl_ctx  = hashcat_ctx->opencl_ctx;
+
+  if (compact_ctx->enabled == false) return;
+
+  // the device threads are gone, so there's no need to lock
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    compact_image_release (compact_ctx, device_param->compact_image);
+
+    device_param->compact_image = NULL;
+  }
+
+  if (compact_ctx->image != NULL) compact_image_free (compact_ctx->image);
+
+  hc_thread_mutex_delete (compact_ctx->mux_compact);
+
+  memset (compact_ctx, 0, sizeof (compact_ctx_t));
+}
+
+int compact_update (hashcat_ctx_t *hashcat_ctx)
+{
+  bitmap_ctx_t  *bitmap_ctx  = hashcat_ctx->bitmap_ctx;
+  compact_ctx_t *compact_ctx = hashcat_ctx->compact_ctx;
+  hashconfig_t  *hashconfig  = hashcat_ctx->hashconfig;
+  hashes_t      *hashes      = hashcat_ctx->hashes;
+  status_ctx_t  *status_ctx  = hashcat_ctx->status_ctx;
+
+  if (compact_ctx->enabled == false) return 0;
+
+  // only worth it once a good part of what is left has cracked
+
+  const u32 cracked = hashes->digests_done - compact_ctx->digests_done;
+
+  if (cracked == 0) return 0;
+
+  if (((u64) cracked * 100) < ((u64) compact_ctx->digests_live * COMPACT_RATIO)) return 0;
+
+  const time_t now = time (NULL);
+
+  if ((now - compact_ctx->compact_last) < COMPACT_INTERVAL) return 0;
+
+  // check_cracked () updates digests_shown under mux_display, take a snapshot to build from
+  // a digest which cracks after that simply stays in the new image until the next one
+
+  u32 *digests_shown = (u32 *) hcmalloc (hashcat_ctx, hashes->digests_cnt * sizeof (u32)); VERIFY_PTR (digests_shown);
+
+  hc_thread_mutex_lock (status_ctx->mux_display);
+
+  memcpy (digests_shown, hashes->digests_shown, hashes->digests_cnt * sizeof (u32));
+
+  const u32 digests_done = hashes->digests_done;
+
+  hc_thread_mutex_unlock (status_ctx->mux_display);
+
+  u32 digests_live = 0;
+
+  for (u32 hash_pos = 0; hash_pos < hashes->digests_cnt; hash_pos++)
+  {
+    if (digests_shown[hash_pos] == 0) digests_live++;
+  }
+
+  compact_ctx->digests_done = digests_done;
+  compact_ctx->digests_live = digests_live;
+  compact_ctx->compact_last = now;
+
+  if (digests_live == 0)
+  {
+    hcfree (digests_shown);
+
+    return 0;
+  }
+
+  compact_image_t *image = (compact_image_t *) hccalloc (hashcat_ctx, 1, sizeof (compact_image_t)); VERIFY_PTR (image);
+
+  image->digests_buf          = hcmalloc (hashcat_ctx, (size_t) digests_live * hashconfig->dgst_size);                   VERIFY_PTR (image->digests_buf);
+  image->digests_shown        = (u32 *) hccalloc (hashcat_ctx, digests_live, sizeof (u32));                              VERIFY_PTR (image->digests_shown);
+  image->digests_map          = (u32 *) hcmalloc (hashcat_ctx, digests_live * sizeof (u32));                             VERIFY_PTR (image->digests_map);
+  image->salts_buf            = (salt_t *) hcmalloc (hashcat_ctx, hashes->salts_cnt * sizeof (salt_t));                 VERIFY_PTR (image->salts_buf);
+  image->bitmap_bufs          = (u32 *) hcmalloc (hashcat_ctx, (size_t) bitmap_ctx->bitmap_size * 8);                    VERIFY_PTR (image->bitmap_bufs);
+
+  // keep the salt order and the digest order inside each salt, find_hash () relies on the sort
+
+  u32 digests_pos = 0;
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    const salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+    salt_t *salt_buf_compact = &image->salts_buf[salt_pos];
+
+    memcpy (salt_buf_compact, salt_buf, sizeof (salt_t));
+
+    salt_buf_compact->digests_offset = digests_pos;
+
+    for (u32 digest_pos = 0; digest_pos < salt_buf->digests_cnt; digest_pos++)
+    {
+      const u32 hash_pos = salt_buf->digests_offset + digest_pos;
+
+      if (digests_shown[hash_pos] == 1) continue;
+
+      memcpy ((char *) image->digests_buf + ((size_t) digests_pos * hashconfig->dgst_size), (char *) hashes->digests_buf + ((size_t) hash_pos * hashconfig->dgst_size), hashconfig->dgst_size);
+
+      image->digests_map[digests_pos] = hash_pos;
+
+      digests_pos++;
+    }
+
+    salt_buf_compact->digests_cnt = digests_pos - salt_buf_compact->digests_offset;
+  }
+
+  hcfree (digests_shown);
+
+  image->digests_cnt = digests_pos;
+
+  bitmap_ctx_generate (hashcat_ctx, image->digests_cnt, (char *) image->digests_buf, image->bitmap_bufs);
+
+  // publish, the device threads pick it up at their next batch
+
+  hc_thread_mutex_lock (compact_ctx->mux_compact);
+
+  compact_image_t *image_old = compact_ctx->image;
+
+  compact_ctx->gen++;
+
+  image->gen = compact_ctx->gen;
+
+  compact_ctx->image = image;
+
+  if ((image_old != NULL) && (image_old->refs == 0)) compact_image_free (image_old);
+
+  hc_thread_mutex_unlock (compact_ctx->mux_compact);
+
+  return 0;
+}
+
+int compact_device_sync (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  bitmap_ctx_t  *bitmap_ctx  = hashcat_ctx->bitmap_ctx;
+  compact_ctx_t *compact_ctx = hashcat_ctx->compact_ctx;
+  hashconfig_t  *hashconfig  = hashcat_ctx->hashconfig;
+  hashes_t      *hashes      = hashcat_ctx->hashes;
+
+  if (compact_ctx->enabled == false) return 0;
+
+  hc_thread_mutex_lock (compact_ctx->mux_compact);
+
+  compact_image_t *image = compact_ctx->image;
+
+  if ((image == NULL) || (image == device_param->compact_image))
+  {
+    hc_thread_mutex_unlock (compact_ctx->mux_compact);
+
+    return 0;
+  }
+
+  image->refs++;
+
+  hc_thread_mutex_unlock (compact_ctx->mux_compact);
+
+  // the host backend reads the image in place, only its own digests_shown copy is written by the workers
+
+  if (device_param->is_host == true)
+  {
+    memcpy (device_param->host_digests_shown, image->digests_shown, (size_t) image->digests_cnt * sizeof (u32));
+
+    hc_thread_mutex_lock (compact_ctx->mux_compact);
+
+    compact_image_release (compact_ctx, device_param->compact_image);
+
+    device_param->compact_image = image;
+
+    hc_thread_mutex_unlock (compact_ctx->mux_compact);
+
+    return 0;
+  }
+
+  // the queue is idle between batches, so the kernels of the next batch see all of it
+
+  const u32 bitmap_nums = bitmap_ctx->bitmap_nums;
+  const u32 bitmap_size = bitmap_ctx->bitmap_size;
+
+  int CL_rc;
+
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_buf,   CL_TRUE, 0, (size_t) image->digests_cnt * hashconfig->dgst_size, image->digests_buf,   0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_shown, CL_TRUE, 0, (size_t) image->digests_cnt * sizeof (u32),        image->digests_shown, 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_salt_bufs,     CL_TRUE, 0, (size_t) hashes->salts_cnt * sizeof (salt_t),        image->salts_buf,     0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_a,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 0), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_b,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 1), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_c,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 2), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_d,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 3), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_a,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 4), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_b,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 5), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_c,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 6), 0, NULL, NULL); if (CL_rc == -1) return -1;
+  CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_d,   CL_TRUE, 0, bitmap_size, image->bitmap_bufs + (bitmap_nums * 7), 0, NULL, NULL); if (CL_rc == -1) return -1;
+
+  hc_thread_mutex_lock (compact_ctx->mux_compact);
+
+  compact_image_release (compact_ctx, device_param->compact_image);
+
+  device_param->compact_image = image;
+
+  hc_thread_mutex_unlock (compact_ctx->mux_compact);
+
+  return 0;
+}
+
+void compact_plains (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, plain_t *plains_buf, const u32 plains_cnt)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  // only the device thread itself swaps its image, so no lock is needed here
+
+  const compact_image_t *image = device_param->compact_image;
+
+  if (image == NULL) return;
+
+  // back to positions in the full hashlist, that's what the output, potfile and --remove work with
+
+  for (u32 i = 0; i < plains_cnt; i++)
+  {
+    plain_t *plain = &plains_buf[i];
+
+    const u32 hash_pos = image->digests_map[plain->hash_pos];
+
+    plain->hash_pos   = hash_pos;
+    plain->digest_pos = hash_pos - hashes->salts_buf[plain->salt_pos].digests_offset;
+  }
+}
@@ -5,6 +5,7 @@
 
 #include "common.h"
 #include "types.h"
+#include "bitops.h"
 #include "convert.h"
 
 bool need_hexify (const u8 *buf, const int len)
@@ -24,21 +25,7 @@ void exec_hexify (const u8 *buf, const int len, u8 *out)
 {
   const int max_len = (len >= 31) ? 31 : len;
 
-  for (int i = max_len - 1, j = i * 2; i >= 0; i -= 1, j -= 2)
-  {
-    const u8 v = buf[i];
-
-    u8 h0 = v >> 4 & 15;
-    u8 h1 = v >> 0 & 15;
-
-    u8 add;
-
-    h0 += 6; add = ((h0 & 0x10) >> 4) * 39; h0 += 42 + add;
-    h1 += 6; add = ((h1 & 0x10) >> 4) * 39; h1 += 42 + add;
-
-    out[j + 0] = h0;
-    out[j + 1] = h1;
-  }
+  hex_encode_lower (buf, max_len, out);
 
   out[max_len * 2] = 0;
 }
@@ -107,32 +94,152 @@ u64 hex_to_u64 (const u8 hex[16])
   return (v);
 }
 
-void bin_to_hex_lower (const u32 v, u8 hex[8])
+/**
+ * buffer-level hex, 8 chars per step in a u64 (SWAR), so the compiler can keep it in registers
+ * the little endian load order is what hashcat assumes everywhere else, too
+ */
+
+#define SWAR_ONES  0x0101010101010101ull
+#define SWAR_HIGHS 0x8080808080808080ull
+
+// high bit of each byte is set if m < byte < n, exact for n <= 128, bytes >= 128 never match
+
+static inline u64 swar_between (const u64 x, const u8 m, const u8 n)
+{
+  const u64 x7 = x & (SWAR_ONES * 127);
+
+  return ((SWAR_ONES * (127 + n)) - x7) & ~x & (x7 + (SWAR_ONES * (127 - m))) & SWAR_HIGHS;
+}
+
+static inline bool swar_is_hex (const u64 x)
+{
+  const u64 digit = swar_between (x, '0' - 1, '9' + 1);
+  const u64 upper = swar_between (x, 'A' - 1, 'F' + 1);
+  const u64 lower = swar_between (x, 'a' - 1, 'f' + 1);
+
+  return (digit | upper | lower) == SWAR_HIGHS;
+}
+
+// 8 hex chars to 4 bytes, same nibble math as hex_convert ()
+
+static inline u32 swar_hex_decode (const u64 x)
+{
+  u64 n = (x & (SWAR_ONES * 0x0f)) + (((x >> 6) & SWAR_ONES) * 9);
+
+  n = ((n & 0x00ff00ff00ff00ffull) << 4) | ((n >> 8) & 0x00ff00ff00ff00ffull);
+
+  n = (n | (n >>  8)) & 0x0000ffff0000ffffull;
+  n = (n | (n >> 16)) & 0x00000000ffffffffull;
+
+  return (u32) n;
+}
+
+// 4 bytes to 8 lowercase hex chars, same math as the old bin_to_hex_lower ()
+
+static inline u64 hex_encode_u32 (const u32 v)
+{
+  u64 x = v;
+
+  x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+  x = (x | (x <<  8)) & 0x00ff00ff00ff00ffull;
+
+  u64 h = ((x >> 4) & (SWAR_ONES * 0x0f)) | ((x & (SWAR_ONES * 0x0f)) << 8);
+
+  h += SWAR_ONES * 6;
+
+  const u64 add = ((h & (SWAR_ONES * 0x10)) >> 4) * 39;
+
+  h += (SWAR_ONES * 42) + add;
+
+  return h;
+}
+
+bool is_valid_hex_string (const u8 *s, const int len)
+{
+  int i = 0;
+
+  for (; i + 8 <= len; i += 8)
+  {
+    u64 x;
+
+    memcpy (&x, s + i, 8);
+
+    if (swar_is_hex (x) == false) return false;
+  }
+
+  for (; i < len; i++)
+  {
+    if (is_valid_hex_char (s[i]) == false) return false;
+  }
+
+  return true;
+}
+
+bool hex_decode (const u8 *in_buf, const int in_len, u8 *out_buf)
 {
-  hex[0] = v >> 28 & 15;
-  hex[1] = v >> 24 & 15;
-  hex[2] = v >> 20 & 15;
-  hex[3] = v >> 16 & 15;
-  hex[4] = v >> 12 & 15;
-  hex[5] = v >>  8 & 15;
-  hex[6] = v >>  4 & 15;
-  hex[7] = v >>  0 & 15;
+  if (in_len & 1) return false;
+
+  int i = 0;
+
+  for (; i + 8 <= in_len; i += 8)
+  {
+    u64 x;
+
+    memcpy (&x, in_buf + i, 8);
+
+    if (swar_is_hex (x) == false) return false;
 
-  u32 add;
+    const u32 v = swar_hex_decode (x);
 
-  hex[0] += 6; add = ((hex[0] & 0x10) >> 4) * 39; hex[0] += 42 + add;
-  hex[1] += 6; add = ((hex[1] & 0x10) >> 4) * 39; hex[1] += 42 + add;
-  hex[2] += 6; add = ((hex[2] & 0x10) >> 4) * 39; hex[2] += 42 + add;
-  hex[3] += 6; add = ((hex[3] & 0x10) >> 4) * 39; hex[3] += 42 + add;
-  hex[4] += 6; add = ((hex[4] & 0x10) >> 4) * 39; hex[4] += 42 + add;
-  hex[5] += 6; add = ((hex[5] & 0x10) >> 4) * 39; hex[5] += 42 + add;
-  hex[6] += 6; add = ((hex[6] & 0x10) >> 4) * 39; hex[6] += 42 + add;
-  hex[7] += 6; add = ((hex[7] & 0x10) >> 4) * 39; hex[7] += 42 + add;
+    memcpy (out_buf + (i / 2), &v, 4);
+  }
+
+  for (; i < in_len; i += 2)
+  {
+    if (is_valid_hex_char (in_buf[i + 0]) == false) return false;
+    if (is_valid_hex_char (in_buf[i + 1]) == false) return false;
+
+    out_buf[i / 2] = hex_to_u8 (in_buf + i);
+  }
+
+  return true;
+}
+
+void hex_encode_lower (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  // back to front, so in_buf and out_buf may be the same buffer
+
+  int i = in_len;
+
+  for (; i & 3; i--)
+  {
+    const u64 chars = hex_encode_u32 (in_buf[i - 1]);
+
+    memcpy (out_buf + ((i - 1) * 2), &chars, 2);
+  }
+
+  for (; i > 0; i -= 4)
+  {
+    u32 v;
+
+    memcpy (&v, in_buf + i - 4, 4);
+
+    const u64 chars = hex_encode_u32 (v);
+
+    memcpy (out_buf + ((i - 4) * 2), &chars, 8);
+  }
+}
+
+void bin_to_hex_lower (const u32 v, u8 hex[8])
+{
+  const u64 chars = hex_encode_u32 (byte_swap_32 (v));
+
+  memcpy (hex, &chars, 8);
 }
 
 u8 int_to_base32 (const u8 c)
 {
-  const u8 tbl[0x20] =
+  static const u8 tbl[0x20] =
   {
     0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50,
     0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
@@ -151,7 +258,7 @@ u8 base32_to_int (const u8 c)
 
 u8 int_to_itoa32 (const u8 c)
 {
-  const u8 tbl[0x20] =
+  static const u8 tbl[0x20] =
   {
     0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
     0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76,
@@ -170,7 +277,7 @@ u8 itoa32_to_int (const u8 c)
 
 u8 int_to_itoa64 (const u8 c)
 {
-  const u8 tbl[0x40] =
+  static const u8 tbl[0x40] =
   {
     0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43, 0x44,
     0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54,
@@ -183,7 +290,7 @@ u8 int_to_itoa64 (const u8 c)
 
 u8 itoa64_to_int (const u8 c)
 {
-  const u8 tbl[0x100] =
+  static const u8 tbl[0x100] =
   {
     0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21,
     0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31,
@@ -208,7 +315,7 @@ u8 itoa64_to_int (const u8 c)
 
 u8 int_to_base64 (const u8 c)
 {
-  const u8 tbl[0x40] =
+  static const u8 tbl[0x40] =
   {
     0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50,
     0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
@@ -221,7 +328,7 @@ u8 int_to_base64 (const u8 c)
 
 u8 base64_to_int (const u8 c)
 {
-  const u8 tbl[0x100] =
+  static const u8 tbl[0x100] =
   {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -246,7 +353,7 @@ u8 base64_to_int (const u8 c)
 
 u8 int_to_bf64 (const u8 c)
 {
-  const u8 tbl[0x40] =
+  static const u8 tbl[0x40] =
   {
     0x2e, 0x2f, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e,
     0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x61, 0x62, 0x63, 0x64,
@@ -259,7 +366,7 @@ u8 int_to_bf64 (const u8 c)
 
 u8 bf64_to_int (const u8 c)
 {
-  const u8 tbl[0x100] =
+  static const u8 tbl[0x100] =
   {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -453,6 +560,227 @@ int base64_encode (u8 (*f) (const u8), const u8 *in_buf, int in_len, u8 *out_buf
   return out_len;
 }
 
+/**
+ * table-driven base64 variants, without a function call per char
+ * the decode tables mark chars outside of the alphabet with 0xff
+ */
+
+static const u8 ITOA64_ENC[0x40] =
+{
+  0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43, 0x44,
+  0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54,
+  0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+  0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+};
+
+static const u8 ITOA64_DEC[0x100] =
+{
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01,
+  0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a,
+  0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34,
+  0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const u8 BF64_ENC[0x40] =
+{
+  0x2e, 0x2f, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e,
+  0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x61, 0x62, 0x63, 0x64,
+  0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74,
+  0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+};
+
+static const u8 BF64_DEC[0x100] =
+{
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01,
+  0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+  0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a,
+  0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const u8 LOTUS64_ENC[0x40] =
+{
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46,
+  0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56,
+  0x57, 0x58, 0x59, 0x5a, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c,
+  0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x2b, 0x2f,
+};
+
+static const u8 LOTUS64_DEC[0x100] =
+{
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+  0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32,
+  0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static int base64_decode_tbl (const u8 dec[0x100], const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  // unlike base64_decode () this stops at in_len and rejects chars outside of the alphabet
+
+  const u8 *in_ptr = in_buf;
+
+  u8 *out_ptr = out_buf;
+
+  int i = 0;
+
+  for (; i + 4 <= in_len; i += 4)
+  {
+    const u8 v0 = dec[in_ptr[0]];
+    const u8 v1 = dec[in_ptr[1]];
+    const u8 v2 = dec[in_ptr[2]];
+    const u8 v3 = dec[in_ptr[3]];
+
+    if ((v0 | v1 | v2 | v3) & 0xc0) return -1;
+
+    out_ptr[0] = (v0 << 2) | (v1 >> 4);
+    out_ptr[1] = (v1 << 4) | (v2 >> 2);
+    out_ptr[2] = (v2 << 6) | (v3 >> 0);
+
+    in_ptr  += 4;
+    out_ptr += 3;
+  }
+
+  const int out_len = (in_len * 6) / 8;
+
+  if (i < in_len)
+  {
+    u8 v[4] = { 0 };
+
+    for (int j = 0; i + j < in_len; j++)
+    {
+      v[j] = dec[in_ptr[j]];
+
+      if (v[j] & 0xc0) return -1;
+    }
+
+    const u8 tail[3] =
+    {
+      (u8) ((v[0] << 2) | (v[1] >> 4)),
+      (u8) ((v[1] << 4) | (v[2] >> 2)),
+      (u8) ((v[2] << 6) | (v[3] >> 0)),
+    };
+
+    memcpy (out_ptr, tail, out_len - (out_ptr - out_buf));
+  }
+
+  return out_len;
+}
+
+static int base64_encode_tbl (const u8 enc[0x40], const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  // same output as base64_encode (), including the padding
+
+  const u8 *in_ptr = in_buf;
+
+  u8 *out_ptr = out_buf;
+
+  for (int i = 0; i < in_len; i += 3)
+  {
+    out_ptr[0] = enc[                            ((in_ptr[0] >> 2) & 0x3f)];
+    out_ptr[1] = enc[((in_ptr[0] << 4) & 0x30) | ((in_ptr[1] >> 4) & 0x0f)];
+    out_ptr[2] = enc[((in_ptr[1] << 2) & 0x3c) | ((in_ptr[2] >> 6) & 0x03)];
+    out_ptr[3] = enc[                            ((in_ptr[2] >> 0) & 0x3f)];
+
+    in_ptr  += 3;
+    out_ptr += 4;
+  }
+
+  int out_len = (int) (((0.5 + (double) in_len) * 8) / 6); // ceil (in_len * 8 / 6)
+
+  while (out_len % 4)
+  {
+    out_buf[out_len] = '=';
+
+    out_len++;
+  }
+
+  return out_len;
+}
+
+int itoa64_decode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_decode_tbl (ITOA64_DEC, in_buf, in_len, out_buf);
+}
+
+int itoa64_encode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_encode_tbl (ITOA64_ENC, in_buf, in_len, out_buf);
+}
+
+int bf64_decode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_decode_tbl (BF64_DEC, in_buf, in_len, out_buf);
+}
+
+int bf64_encode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_encode_tbl (BF64_ENC, in_buf, in_len, out_buf);
+}
+
+int lotus64_decode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_decode_tbl (LOTUS64_DEC, in_buf, in_len, out_buf);
+}
+
+int lotus64_encode (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  return base64_encode_tbl (LOTUS64_ENC, in_buf, in_len, out_buf);
+}
+
+bool itoa64_to_int_buf (const u8 *in_buf, const int in_len, u8 *out_buf)
+{
+  // for the crypt () style encodings, which have their own bit order
+
+  u8 bad = 0;
+
+  for (int i = 0; i < in_len; i++)
+  {
+    const u8 v = ITOA64_DEC[in_buf[i]];
+
+    out_buf[i] = v;
+
+    bad |= v;
+  }
+
+  return (bad & 0xc0) == 0;
+}
+
 void lowercase (u8 *buf, int len)
 {
   for (int i = 0; i < len; i++) buf[i] = tolower (buf[i]);
@@ -0,0 +1,208 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "dedup.h"
+
+// number of bits set per candidate in the cross-batch filter
+
+#define DEDUP_BLOOM_K 4
+
+// below this many filter bits per base word the false positive rate climbs over 2%
+
+#define DEDUP_BLOOM_BITS_MIN 8
+
+static u64 dedup_hash (const u8 *buf, const u32 len)
+{
+  u64 hash = 0xcbf29ce484222325;
+
+  for (u32 i = 0; i < len; i++)
+  {
+    hash ^= buf[i];
+    hash *= 0x100000001b3;
+  }
+
+  hash ^= len;
+
+  // final avalanche, the bloom filter uses the upper bits as well
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+int dedup_ctx_init (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t    *dedup_ctx    = hashcat_ctx->dedup_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  dedup_ctx->enabled = false;
+
+  if (user_options->dedup_candidates == 0) return 0;
+
+  if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+   && (user_options->attack_mode != ATTACK_MODE_COMBI)) return 0;
+
+  dedup_ctx->enabled = true;
+
+  // largest power of 2 which fits into the memory budget
+
+  const u64 budget_bits = (u64) user_options->dedup_candidates * 1024 * 1024 * 8;
+
+  u64 bloom_bits = 64;
+
+  while ((bloom_bits * 2) <= budget_bits) bloom_bits *= 2;
+
+  dedup_ctx->bloom_buf  = (u64 *) hccalloc (hashcat_ctx, bloom_bits / 64, sizeof (u64)); VERIFY_PTR (dedup_ctx->bloom_buf);
+  dedup_ctx->bloom_mask = bloom_bits - 1;
+  dedup_ctx->skipped    = 0;
+  dedup_ctx->words_sum  = 0;
+  dedup_ctx->warned     = false;
+
+  return 0;
+}
+
+void dedup_check_keyspace (hashcat_ctx_t *hashcat_ctx, const u64 words_base)
+{
+  dedup_ctx_t          *dedup_ctx    = hashcat_ctx->dedup_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (dedup_ctx->enabled == false) return;
+
+  // the filter is shared by all dictionaries, a false positive silently drops a unique base word
+
+  dedup_ctx->words_sum += words_base;
+
+  if (dedup_ctx->warned == true) return;
+
+  const u64 bloom_bits = dedup_ctx->bloom_mask + 1;
+
+  if ((bloom_bits / DEDUP_BLOOM_BITS_MIN) >= dedup_ctx->words_sum) return;
+
+  u64 need_bits = bloom_bits;
+
+  while ((need_bits / DEDUP_BLOOM_BITS_MIN) < dedup_ctx->words_sum) need_bits *= 2;
+
+  const u64 need_mb = need_bits / 8 / 1024 / 1024;
+
+  event_log_warning (hashcat_ctx, "--dedup-candidates=%u is too small for %" PRIu64 " base words, unique words may be skipped as duplicates", user_options->dedup_candidates, dedup_ctx->words_sum);
+  event_log_warning (hashcat_ctx, "Use --dedup-candidates=%" PRIu64 " or more to keep that below 2%%", need_mb);
+  event_log_warning (hashcat_ctx, "");
+
+  dedup_ctx->warned = true;
+}
+
+void dedup_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  hcfree (dedup_ctx->bloom_buf);
+
+  memset (dedup_ctx, 0, sizeof (dedup_ctx_t));
+}
+
+int dedup_batch_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  // the exact set indexes into pws_buf, keep it at most half full
+  // sized for the largest batch, kernel_power can change while running
+
+  const u64 pws_max = device_param->size_pws / sizeof (pw_t);
+
+  u32 table_size = 1;
+
+  while (table_size < (pws_max * 2)) table_size <<= 1;
+
+  device_param->dedup_table_buf  = (u32 *) hccalloc (hashcat_ctx, table_size, sizeof (u32)); VERIFY_PTR (device_param->dedup_table_buf);
+  device_param->dedup_table_size = table_size;
+
+  return 0;
+}
+
+void dedup_batch_reset (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  memset (device_param->dedup_table_buf, 0, device_param->dedup_table_size * sizeof (u32));
+}
+
+void dedup_batch_destroy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return;
+
+  hcfree (device_param->dedup_table_buf);
+
+  device_param->dedup_table_buf  = NULL;
+  device_param->dedup_table_size = 0;
+}
+
+bool dedup_skip (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u8 *pw_buf, const u32 pw_len)
+{
+  // returns true if the candidate was seen before
+  // if not, it's registered as pws_buf[pws_cnt], so the caller has to pw_add() it next
+
+  dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return false;
+
+  const u64 hash = dedup_hash (pw_buf, pw_len);
+
+  // exact check within the current batch
+
+  const u32 table_mask = device_param->dedup_table_size - 1;
+
+  u32 slot = (u32) hash & table_mask;
+
+  while (device_param->dedup_table_buf[slot])
+  {
+    const pw_t *pw = device_param->pws_buf + device_param->dedup_table_buf[slot] - 1;
+
+    if ((pw->pw_len == pw_len) && (memcmp (pw->i, pw_buf, pw_len) == 0)) return true;
+
+    slot = (slot + 1) & table_mask;
+  }
+
+  // approximate check against everything the other batches have seen, shared by all devices
+
+  const u64 h1 = hash;
+  const u64 h2 = (hash >> 32) | 1;
+
+  bool seen = true;
+
+  for (u32 k = 0; k < DEDUP_BLOOM_K; k++)
+  {
+    const u64 bit_pos = (h1 + (k * h2)) & dedup_ctx->bloom_mask;
+
+    const u64 bit = 1ull << (bit_pos & 63);
+
+    const u64 old = __sync_fetch_and_or (&dedup_ctx->bloom_buf[bit_pos / 64], bit);
+
+    if ((old & bit) == 0) seen = false;
+  }
+
+  if (seen == true) return true;
+
+  // only register what the caller is going to pw_add(), skipped words never count towards the batch
+
+  device_param->dedup_table_buf[slot] = device_param->pws_cnt + 1;
+
+  return false;
+}
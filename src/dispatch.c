@@ -21,13 +21,19 @@
 #include "restore.h"
 #include "hashes.h"
 #include "rp_cpu.h"
+#include "rp_kernel_on_cpu.h"
 #include "mpsp.h"
+#include "metrics.h"
+#include "trace.h"
 #include "outfile.h"
 #include "potfile.h"
 #include "debugfile.h"
 #include "loopback.h"
 #include "status.h"
 #include "dictstat.h"
+#include "dedup.h"
+#include "feed.h"
+#include "autotune.h"
 #include "wordlist.h"
 #include "status.h"
 #include "shared.h"
@@ -61,73 +67,288 @@ static u64 get_lowest_words_done (const hashcat_ctx_t *hashcat_ctx)
   return words_cur;
 }
 
-static int set_kernel_power_final (hashcat_ctx_t *hashcat_ctx, const u32 kernel_power_final)
+static void set_kernel_power_final (hashcat_ctx_t *hashcat_ctx, const u64 kernel_power_final)
 {
-  EVENT (EVENT_SET_KERNEL_POWER_FINAL);
-
   opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
 
-  opencl_ctx->kernel_power_final = kernel_power_final;
+  // only the first device thread reaching the tail of the keyspace announces it
 
-  return 0;
+  if (__sync_bool_compare_and_swap (&opencl_ctx->kernel_power_final, 0, kernel_power_final) == false) return;
+
+  EVENT (EVENT_SET_KERNEL_POWER_FINAL);
 }
 
-static u32 get_power (opencl_ctx_t *opencl_ctx, hc_device_param_t *device_param)
+static double get_device_factor (const hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
 {
-  const u64 kernel_power_final = opencl_ctx->kernel_power_final;
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  // prefer the measured speed share, a device that has no timings yet falls back to the hardware share
 
-  if (kernel_power_final)
+  double speed_all = 0;
+  double speed_dev = 0;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
   {
-    const double device_factor = (double) device_param->hardware_power / opencl_ctx->hardware_power_all;
+    const hc_device_param_t *device_param_cur = &opencl_ctx->devices_param[device_id];
 
-    const u64 words_left_device = (u64) CEIL (kernel_power_final * device_factor);
+    if (device_param_cur->skipped) continue;
 
-    // work should be at least the hardware power available without any accelerator
+    const double speed = status_get_hashes_msec_dev (hashcat_ctx, device_id);
 
-    const u64 work = MAX (words_left_device, device_param->hardware_power);
+    if (speed == 0) return (double) device_param->hardware_power / opencl_ctx->hardware_power_all;
 
-    return work;
+    if (device_param_cur == device_param) speed_dev = speed;
+
+    speed_all += speed;
   }
 
-  return device_param->kernel_power;
+  return speed_dev / speed_all;
+}
+
+static u64 get_power (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_left)
+{
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  const u64 kernel_power = device_param->kernel_power;
+
+  if (words_left >= opencl_ctx->kernel_power_all) return kernel_power;
+
+  set_kernel_power_final (hashcat_ctx, words_left);
+
+  if (opencl_ctx->devices_active == 1) return kernel_power;
+
+  // guided self-scheduling: hand out half of this device's share of what is left,
+  // so the chunks shrink towards the end and faster devices come back for the rest
+
+  const double device_factor = get_device_factor (hashcat_ctx, device_param);
+
+  const u64 words_left_device = (u64) CEIL ((words_left * device_factor) / 2);
+
+  // work should be at least the hardware power available without any accelerator
+
+  const u64 work = MAX (words_left_device, device_param->hardware_power);
+
+  return MIN (work, kernel_power);
 }
 
 static u32 get_work (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 max)
 {
-  opencl_ctx_t   *opencl_ctx   = hashcat_ctx->opencl_ctx;
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
 
-  hc_thread_mutex_lock (status_ctx->mux_dispatcher);
-
-  const u64 words_off  = status_ctx->words_off;
   const u64 words_base = (user_options->limit == 0) ? status_ctx->words_base : MIN (user_options->limit, status_ctx->words_base);
 
-  device_param->words_off = words_off;
+  // lock-free: claim [words_pos, words_pos + work) and retry if another device thread got there first
+  // words_pos is words_off moved past the ranges a previous run already finished, see restore_journal_begin ()
+
+  u64 words_off = status_ctx->words_off;
+  u64 words_pos = words_off;
+
+  u64 work = 0;
+
+  while (true)
+  {
+    u64 words_gap  = 0;
+    u64 words_skip = 0;
+
+    words_pos = restore_journal_skip (hashcat_ctx, words_off, words_base, &words_gap, &words_skip);
+
+    const u64 words_left = ((words_pos + words_skip) < words_base) ? words_base - words_pos - words_skip : 0;
+
+    work = 0;
+
+    if (words_left)
+    {
+      work = get_power (hashcat_ctx, device_param, words_left);
+
+      work = MIN (work, words_left);
+      work = MIN (work, words_gap);
+      work = MIN (work, max);
+    }
+
+    const u64 words_off_prev = __sync_val_compare_and_swap (&status_ctx->words_off, words_off, words_pos + work);
+
+    if (words_off_prev == words_off) break;
+
+    words_off = words_off_prev;
+  }
+
+  device_param->words_off = words_pos;
+
+  restore_journal_claim (hashcat_ctx, device_param, words_pos, work);
+
+  return (u32) work;
+}
+
+static bool host_rules_usable (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  if (user_options->host_rule_threads == 0) return false;
+
+  if (user_options->attack_mode != ATTACK_MODE_STRAIGHT) return false;
+
+  // fast hashes apply the rules inside the kernel, there's nothing to win
+
+  if (hashconfig->attack_exec != ATTACK_EXEC_OUTSIDE_KERNEL) return false;
+
+  // we need to fit at least one word with all its rules into a single batch
+
+  if (straight_ctx->kernel_rules_cnt < 2) return false;
+
+  if (straight_ctx->kernel_rules_cnt > device_param->kernel_power) return false;
 
-  const u64 kernel_power_all = opencl_ctx->kernel_power_all;
+  return true;
+}
+
+static void *thread_host_rules (void *p)
+{
+  host_rules_param_t *host_rules_param = (host_rules_param_t *) p;
 
-  const u64 words_left = words_base - words_off;
+  const u32 kernel_rules_cnt = host_rules_param->kernel_rules_cnt;
 
-  if (words_left < kernel_power_all)
+  for (u32 word_pos = host_rules_param->words_start; word_pos < host_rules_param->words_stop; word_pos++)
   {
-    if (opencl_ctx->kernel_power_final == 0)
+    const pw_t *base = &host_rules_param->base_buf[word_pos];
+
+    for (u32 rule_pos = 0; rule_pos < kernel_rules_cnt; rule_pos++)
     {
-      set_kernel_power_final (hashcat_ctx, words_left);
+      const kernel_rule_t *kernel_rule = &host_rules_param->kernel_rules_buf[rule_pos];
+
+      pw_t *out = &host_rules_param->exp_buf[(word_pos * kernel_rules_cnt) + rule_pos];
+
+      memset (out, 0, sizeof (pw_t));
+
+      // same as amp_a0.cl: a single noop keeps words longer than 32 intact
+
+      if ((kernel_rule->cmds[0] == RULE_OP_MANGLE_NOOP) && (kernel_rule->cmds[1] == 0))
+      {
+        memcpy (out->i, base->i, sizeof (base->i));
+
+        out->pw_len = base->pw_len;
+
+        continue;
+      }
+
+      u32 buf0[4];
+      u32 buf1[4];
+
+      memcpy (buf0, base->i + 0, sizeof (buf0));
+      memcpy (buf1, base->i + 4, sizeof (buf1));
+
+      out->pw_len = apply_rules ((u32 *) kernel_rule->cmds, buf0, buf1, base->pw_len);
+
+      memcpy (out->i + 0, buf0, sizeof (buf0));
+      memcpy (out->i + 4, buf1, sizeof (buf1));
     }
   }
 
-  const u32 kernel_power = get_power (opencl_ctx, device_param);
+  return NULL;
+}
+
+static u32 host_rules_hash (const pw_t *pw)
+{
+  u32 hash = 0x811c9dc5 ^ pw->pw_len;
+
+  for (u32 i = 0; i < 16; i++)
+  {
+    hash ^= pw->i[i];
+    hash *= 0x01000193;
+    hash ^= hash >> 15;
+  }
+
+  return hash;
+}
+
+static int host_rules_expand (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pw_t *exp_buf, u32 *table_buf, const u32 table_size)
+{
+  straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  const u32 kernel_rules_cnt = straight_ctx->kernel_rules_cnt;
+
+  const u32 words_cnt = device_param->pws_cnt;
+
+  memcpy (device_param->host_rules_base_buf, device_param->pws_buf, words_cnt * sizeof (pw_t));
+
+  // expand
+
+  const u32 threads_cnt = MIN (user_options->host_rule_threads, words_cnt);
+
+  const u32 words_per_thread = (words_cnt + threads_cnt - 1) / threads_cnt;
+
+  hc_thread_t *threads = (hc_thread_t *) hccalloc (hashcat_ctx, threads_cnt, sizeof (hc_thread_t)); VERIFY_PTR (threads);
+
+  host_rules_param_t *host_rules_params = (host_rules_param_t *) hccalloc (hashcat_ctx, threads_cnt, sizeof (host_rules_param_t)); VERIFY_PTR (host_rules_params);
+
+  for (u32 thread_id = 0; thread_id < threads_cnt; thread_id++)
+  {
+    host_rules_param_t *host_rules_param = &host_rules_params[thread_id];
+
+    host_rules_param->kernel_rules_buf = straight_ctx->kernel_rules_buf;
+    host_rules_param->kernel_rules_cnt = kernel_rules_cnt;
+    host_rules_param->base_buf         = device_param->host_rules_base_buf;
+    host_rules_param->exp_buf          = exp_buf;
+    host_rules_param->words_start      = MIN (thread_id * words_per_thread, words_cnt);
+    host_rules_param->words_stop       = MIN (host_rules_param->words_start + words_per_thread, words_cnt);
+
+    hc_thread_create (threads[thread_id], thread_host_rules, host_rules_param);
+  }
+
+  hc_thread_wait (threads_cnt, threads);
+
+  hcfree (host_rules_params);
+  hcfree (threads);
+
+  // dedupe, the first occurrence wins
+
+  memset (table_buf, 0, table_size * sizeof (u32));
+
+  const u32 table_mask = table_size - 1;
+
+  const u32 exp_cnt = words_cnt * kernel_rules_cnt;
+
+  u32 pws_cnt = 0;
+
+  for (u32 exp_pos = 0; exp_pos < exp_cnt; exp_pos++)
+  {
+    const pw_t *pw = &exp_buf[exp_pos];
+
+    u32 slot = host_rules_hash (pw) & table_mask;
+
+    bool is_dupe = false;
+
+    while (table_buf[slot])
+    {
+      const pw_t *pw_cmp = &device_param->pws_buf[table_buf[slot] - 1];
+
+      if ((pw_cmp->pw_len == pw->pw_len) && (memcmp (pw_cmp->i, pw->i, sizeof (pw->i)) == 0))
+      {
+        is_dupe = true;
+
+        break;
+      }
+
+      slot = (slot + 1) & table_mask;
+    }
 
-  u32 work = MIN (words_left, kernel_power);
+    if (is_dupe == true) continue;
 
-  work = MIN (work, max);
+    device_param->pws_buf[pws_cnt] = *pw;
 
-  status_ctx->words_off += work;
+    device_param->host_rules_pos_buf[pws_cnt] = exp_pos;
 
-  hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+    pws_cnt++;
 
-  return work;
+    table_buf[slot] = pws_cnt;
+  }
+
+  device_param->pws_cnt          = pws_cnt;
+  device_param->host_rules_words = words_cnt;
+
+  return 0;
 }
 
 static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
@@ -135,34 +356,69 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
   user_options_t       *user_options       = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  hashes_t             *hashes             = hashcat_ctx->hashes;
   straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
   status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  dedup_ctx_t          *dedup_ctx          = hashcat_ctx->dedup_ctx;
+  feed_ctx_t           *feed_ctx           = hashcat_ctx->feed_ctx;
 
   char *buf = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE); VERIFY_PTR (buf);
 
   const u32 attack_kern = user_options_extra->attack_kern;
 
+  const int rc_dedup_batch_init = dedup_batch_init (hashcat_ctx, device_param);
+
+  if (rc_dedup_batch_init == -1) return -1;
+
+  hc_timer_t timer_wait;
+
+  hc_timer_set (&timer_wait);
+
+  u64 words_bytes = 0;
+
   while (status_ctx->run_thread_level1 == true)
   {
-    hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+    const u64 ts_fetch = trace_now (hashcat_ctx);
 
-    if (feof (stdin) != 0)
+    // with a candidate feed (or the stdin reader thread) each device works on its own batch,
+    // only reading stdin directly has to be serialized
+
+    if (feed_ctx->enabled == true)
     {
-      hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+      if (feed_wait (hashcat_ctx, device_param) == false) break;
+    }
+    else
+    {
+      hc_thread_mutex_lock (status_ctx->mux_dispatcher);
+
+      if (feof (stdin) != 0)
+      {
+        hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
 
-      break;
+        break;
+      }
     }
 
     u32 words_buffered = 0;
 
     while (words_buffered < device_param->kernel_power)
     {
-      char *line_buf = fgets (buf, HCBUFSIZ_LARGE - 1, stdin);
+      char *line_buf = buf;
+      u32   line_len = 0;
+
+      if (feed_ctx->enabled == true)
+      {
+        if (feed_next (hashcat_ctx, device_param, &line_buf, &line_len) == false) break;
+      }
+      else
+      {
+        line_buf = fgets (buf, HCBUFSIZ_LARGE - 1, stdin);
 
-      if (line_buf == NULL) break;
+        if (line_buf == NULL) break;
 
-      u32 line_len = (u32) in_superchop (line_buf);
+        line_len = (u32) in_superchop (line_buf);
+      }
+
+      words_bytes += line_len + 1;
 
       line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
 
@@ -196,19 +452,21 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
       {
         if ((line_len < hashconfig->pw_min) || (line_len > hashconfig->pw_max))
         {
-          hc_thread_mutex_lock (status_ctx->mux_counter);
-
-          for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-          {
-            status_ctx->words_progress_rejected[salt_pos] += straight_ctx->kernel_rules_cnt;
-          }
-
-          hc_thread_mutex_unlock (status_ctx->mux_counter);
+          status_progress_add_rejected_all (device_param, straight_ctx->kernel_rules_cnt);
 
           continue;
         }
       }
 
+      if (dedup_skip (hashcat_ctx, device_param, (u8 *) line_buf, line_len) == true)
+      {
+        status_progress_add_rejected_all (device_param, straight_ctx->kernel_rules_cnt);
+
+        __sync_fetch_and_add (&dedup_ctx->skipped, 1);
+
+        continue;
+      }
+
       pw_add (device_param, (u8 *) line_buf, (int) line_len);
 
       words_buffered++;
@@ -216,7 +474,9 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
       while (status_ctx->run_thread_level1 == false) break;
     }
 
-    hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+    if (feed_ctx->enabled == false) hc_thread_mutex_unlock (status_ctx->mux_dispatcher);
+
+    trace_span (hashcat_ctx, device_param, TRACE_FETCH, ts_fetch, words_buffered);
 
     while (status_ctx->run_thread_level1 == false) break;
 
@@ -226,18 +486,32 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
 
     if (pws_cnt)
     {
+      metrics_batch (hashcat_ctx, device_param, pws_cnt, hc_timer_get (timer_wait), words_bytes);
+
+      words_bytes = 0;
+
       int CL_rc;
 
+      const u64 ts_copy = trace_now (hashcat_ctx);
+
       CL_rc = run_copy (hashcat_ctx, device_param, pws_cnt);
 
+      trace_span (hashcat_ctx, device_param, TRACE_COPY, ts_copy, pws_cnt);
+
       if (CL_rc == -1) return -1;
 
       CL_rc = run_cracker (hashcat_ctx, device_param, pws_cnt);
 
       if (CL_rc == -1) return -1;
 
+      autotune_online (hashcat_ctx, device_param, pws_cnt);
+
+      hc_timer_set (&timer_wait);
+
       device_param->pws_cnt = 0;
 
+      dedup_batch_reset (hashcat_ctx, device_param);
+
       /*
       still required?
       if (attack_kern == ATTACK_KERN_STRAIGHT)
@@ -263,6 +537,10 @@ static int calc_stdin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_par
   device_param->kernel_accel = 0;
   device_param->kernel_loops = 0;
 
+  dedup_batch_destroy (hashcat_ctx, device_param);
+
+  feed_drop (device_param);
+
   hcfree (buf);
 
   return 0;
@@ -292,22 +570,30 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
   user_options_t       *user_options       = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
   hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
-  hashes_t             *hashes             = hashcat_ctx->hashes;
   straight_ctx_t       *straight_ctx       = hashcat_ctx->straight_ctx;
   combinator_ctx_t     *combinator_ctx     = hashcat_ctx->combinator_ctx;
   status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  dedup_ctx_t          *dedup_ctx          = hashcat_ctx->dedup_ctx;
 
   const u32 attack_mode = user_options->attack_mode;
   const u32 attack_kern = user_options_extra->attack_kern;
 
+  hc_timer_t timer_wait;
+
+  hc_timer_set (&timer_wait);
+
   if (attack_mode == ATTACK_MODE_BF)
   {
     while (status_ctx->run_thread_level1 == true)
     {
+      const u64 ts_fetch = trace_now (hashcat_ctx);
+
       const u32 work = get_work (hashcat_ctx, device_param, -1u);
 
       if (work == 0) break;
 
+      trace_span (hashcat_ctx, device_param, TRACE_FETCH, ts_fetch, work);
+
       const u64 words_off = device_param->words_off;
       const u64 words_fin = words_off + work;
 
@@ -317,16 +603,26 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       if (pws_cnt)
       {
+        metrics_batch (hashcat_ctx, device_param, pws_cnt, hc_timer_get (timer_wait), 0);
+
         int CL_rc;
 
+        const u64 ts_copy = trace_now (hashcat_ctx);
+
         CL_rc = run_copy (hashcat_ctx, device_param, pws_cnt);
 
+        trace_span (hashcat_ctx, device_param, TRACE_COPY, ts_copy, pws_cnt);
+
         if (CL_rc == -1) return -1;
 
         CL_rc = run_cracker (hashcat_ctx, device_param, pws_cnt);
 
         if (CL_rc == -1) return -1;
 
+        autotune_online (hashcat_ctx, device_param, pws_cnt);
+
+        hc_timer_set (&timer_wait);
+
         device_param->pws_cnt = 0;
       }
 
@@ -337,6 +633,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         device_param->words_done = words_fin;
 
         status_ctx->words_cur = get_lowest_words_done (hashcat_ctx);
+
+        restore_journal_commit (hashcat_ctx, device_param);
       }
 
       if (status_ctx->run_thread_level1 == false) break;
@@ -443,14 +741,47 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
     if (rc_wl_data_init == -1) return -1;
 
+    // slow hashes: optionally apply the rules on the host, a batch then holds fewer words but no duplicate candidates
+
+    u32 words_max = -1u;
+
+    pw_t *host_rules_exp_buf   = NULL;
+    u32  *host_rules_table_buf = NULL;
+    u32   host_rules_table_size = 1;
+
+    device_param->host_rules = host_rules_usable (hashcat_ctx, device_param);
+
+    if (device_param->host_rules == true)
+    {
+      const u32 kernel_power = device_param->kernel_power;
+
+      words_max = kernel_power / straight_ctx->kernel_rules_cnt;
+
+      while (host_rules_table_size < (kernel_power * 2)) host_rules_table_size <<= 1;
+
+      device_param->host_rules_base_buf = (pw_t *) hccalloc (hashcat_ctx, words_max,    sizeof (pw_t)); VERIFY_PTR (device_param->host_rules_base_buf);
+      device_param->host_rules_pos_buf  = (u32 *)  hccalloc (hashcat_ctx, kernel_power, sizeof (u32));  VERIFY_PTR (device_param->host_rules_pos_buf);
+
+      host_rules_exp_buf   = (pw_t *) hccalloc (hashcat_ctx, kernel_power,          sizeof (pw_t)); VERIFY_PTR (host_rules_exp_buf);
+      host_rules_table_buf = (u32 *)  hccalloc (hashcat_ctx, host_rules_table_size, sizeof (u32));  VERIFY_PTR (host_rules_table_buf);
+    }
+
+    const int rc_dedup_batch_init = dedup_batch_init (hashcat_ctx, device_param);
+
+    if (rc_dedup_batch_init == -1) return -1;
+
     u64 words_cur = 0;
 
+    u64 words_bytes = 0;
+
     while (status_ctx->run_thread_level1 == true)
     {
+      const u64 ts_fetch = trace_now (hashcat_ctx);
+
       u64 words_off = 0;
       u64 words_fin = 0;
 
-      u32 words_extra = -1u;
+      u32 words_extra = words_max;
 
       while (words_extra)
       {
@@ -472,6 +803,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         {
           get_next_word (hashcat_ctx_tmp, fd, &line_buf, &line_len);
 
+          words_bytes += line_len + 1;
+
           line_len = convert_from_hex (hashcat_ctx, line_buf, line_len);
 
           // post-process rule engine
@@ -499,14 +832,7 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             {
               words_extra++;
 
-              hc_thread_mutex_lock (status_ctx->mux_counter);
-
-              for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-              {
-                status_ctx->words_progress_rejected[salt_pos] += straight_ctx->kernel_rules_cnt;
-              }
-
-              hc_thread_mutex_unlock (status_ctx->mux_counter);
+              status_progress_add_rejected_all (device_param, straight_ctx->kernel_rules_cnt);
 
               continue;
             }
@@ -520,19 +846,25 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
             {
               words_extra++;
 
-              hc_thread_mutex_lock (status_ctx->mux_counter);
-
-              for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-              {
-                status_ctx->words_progress_rejected[salt_pos] += combinator_ctx->combs_cnt;
-              }
-
-              hc_thread_mutex_unlock (status_ctx->mux_counter);
+              status_progress_add_rejected_all (device_param, combinator_ctx->combs_cnt);
 
               continue;
             }
           }
 
+          if (dedup_skip (hashcat_ctx, device_param, (u8 *) line_buf, line_len) == true)
+          {
+            words_extra++;
+
+            const u64 skipped_cnt = (attack_kern == ATTACK_KERN_STRAIGHT) ? straight_ctx->kernel_rules_cnt : combinator_ctx->combs_cnt;
+
+            status_progress_add_rejected_all (device_param, skipped_cnt);
+
+            __sync_fetch_and_add (&dedup_ctx->skipped, 1);
+
+            continue;
+          }
+
           pw_add (device_param, (u8 *) line_buf, (int) line_len);
 
           if (status_ctx->run_thread_level1 == false) break;
@@ -543,26 +875,53 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
 
       if (status_ctx->run_thread_level1 == false) break;
 
+      trace_span (hashcat_ctx, device_param, TRACE_FETCH, ts_fetch, device_param->pws_cnt);
+
       //
       // flush
       //
 
+      if ((device_param->host_rules == true) && (device_param->pws_cnt))
+      {
+        const u64 ts_rules = trace_now (hashcat_ctx);
+
+        const int rc = host_rules_expand (hashcat_ctx, device_param, host_rules_exp_buf, host_rules_table_buf, host_rules_table_size);
+
+        if (rc == -1) return -1;
+
+        trace_span (hashcat_ctx, device_param, TRACE_RULES, ts_rules, device_param->pws_cnt);
+      }
+
       const u32 pws_cnt = device_param->pws_cnt;
 
       if (pws_cnt)
       {
+        metrics_batch (hashcat_ctx, device_param, pws_cnt, hc_timer_get (timer_wait), words_bytes);
+
+        words_bytes = 0;
+
         int CL_rc;
 
+        const u64 ts_copy = trace_now (hashcat_ctx);
+
         CL_rc = run_copy (hashcat_ctx, device_param, pws_cnt);
 
+        trace_span (hashcat_ctx, device_param, TRACE_COPY, ts_copy, pws_cnt);
+
         if (CL_rc == -1) return -1;
 
         CL_rc = run_cracker (hashcat_ctx, device_param, pws_cnt);
 
         if (CL_rc == -1) return -1;
 
+        autotune_online (hashcat_ctx, device_param, pws_cnt);
+
+        hc_timer_set (&timer_wait);
+
         device_param->pws_cnt = 0;
 
+        dedup_batch_reset (hashcat_ctx, device_param);
+
         /*
         still required?
         if (attack_kern == ATTACK_KERN_STRAIGHT)
@@ -587,6 +946,8 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
         device_param->words_done = words_fin;
 
         status_ctx->words_cur = get_lowest_words_done (hashcat_ctx);
+
+        restore_journal_commit (hashcat_ctx, device_param);
       }
 
       if (status_ctx->run_thread_level1 == false) break;
@@ -599,6 +960,22 @@ static int calc (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
       fclose (device_param->combs_fp);
     }
 
+    if (device_param->host_rules == true)
+    {
+      hcfree (device_param->host_rules_base_buf);
+      hcfree (device_param->host_rules_pos_buf);
+
+      hcfree (host_rules_exp_buf);
+      hcfree (host_rules_table_buf);
+
+      device_param->host_rules_base_buf = NULL;
+      device_param->host_rules_pos_buf  = NULL;
+
+      device_param->host_rules = false;
+    }
+
+    dedup_batch_destroy (hashcat_ctx, device_param);
+
     wl_data_destroy (hashcat_ctx_tmp);
 
     hcfree (hashcat_ctx_tmp->wl_data);
@@ -0,0 +1,398 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "shared.h"
+#include "thread.h"
+#include "feed.h"
+
+int feed_init (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  if (feed_ctx->enabled == true) return 0;
+
+  feed_ctx->finished     = false;
+  feed_ctx->batches      = (feed_batch_t *) hccalloc (hashcat_ctx, FEED_BATCHES, sizeof (feed_batch_t)); VERIFY_PTR (feed_ctx->batches);
+  feed_ctx->batches_head = 0;
+  feed_ctx->batches_cnt  = 0;
+
+  hc_thread_mutex_init (feed_ctx->mux_feed);
+
+  feed_ctx->enabled = true;
+
+  return 0;
+}
+
+static void feed_batch_free (feed_batch_t *batch)
+{
+  hcfree (batch->buf);
+  hcfree (batch->len_buf);
+
+  memset (batch, 0, sizeof (feed_batch_t));
+}
+
+void feed_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  if (feed_ctx->enabled == false) return;
+
+  for (u32 i = 0; i < FEED_BATCHES; i++)
+  {
+    feed_batch_free (&feed_ctx->batches[i]);
+  }
+
+  hcfree (feed_ctx->batches);
+
+  hc_thread_mutex_delete (feed_ctx->mux_feed);
+
+  memset (feed_ctx, 0, sizeof (feed_ctx_t));
+}
+
+void feed_reset (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  if (feed_ctx->enabled == false) return;
+
+  // drop whatever the previous job did not consume
+
+  hc_thread_mutex_lock (feed_ctx->mux_feed);
+
+  for (u32 i = 0; i < FEED_BATCHES; i++)
+  {
+    feed_batch_free (&feed_ctx->batches[i]);
+  }
+
+  feed_ctx->batches_head = 0;
+  feed_ctx->batches_cnt  = 0;
+  feed_ctx->finished     = false;
+
+  hc_thread_mutex_unlock (feed_ctx->mux_feed);
+}
+
+static int feed_queue (hashcat_ctx_t *hashcat_ctx, feed_batch_t *batch, const bool from_stdin)
+{
+  feed_ctx_t   *feed_ctx   = hashcat_ctx->feed_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  // the ring is bounded, so wait for the device threads if they are behind
+  // the stdin reader also gives up once the device threads are gone
+
+  while (true)
+  {
+    bool stop = (status_ctx->run_main_level1 == false);
+
+    if (from_stdin == true)
+    {
+      if (status_ctx->run_thread_level1 == false) stop = true;
+
+      if (feed_ctx->finished == true) stop = true;
+    }
+
+    if (stop == true)
+    {
+      feed_batch_free (batch);
+
+      return -1;
+    }
+
+    hc_thread_mutex_lock (feed_ctx->mux_feed);
+
+    if (feed_ctx->batches_cnt < FEED_BATCHES)
+    {
+      const u32 batches_tail = (feed_ctx->batches_head + feed_ctx->batches_cnt) % FEED_BATCHES;
+
+      feed_ctx->batches[batches_tail] = *batch;
+
+      feed_ctx->batches_cnt++;
+
+      hc_thread_mutex_unlock (feed_ctx->mux_feed);
+
+      break;
+    }
+
+    hc_thread_mutex_unlock (feed_ctx->mux_feed);
+
+    hc_sleep_msec (1);
+  }
+
+  return 0;
+}
+
+int feed_push (hashcat_ctx_t *hashcat_ctx, const u8 *buf, const u32 *len_buf, const u32 cnt)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  if (feed_ctx->enabled == false)
+  {
+    event_log_error (hashcat_ctx, "Candidate feed is not enabled");
+
+    return -1;
+  }
+
+  if (feed_ctx->finished == true)
+  {
+    event_log_error (hashcat_ctx, "Candidate feed is already finished");
+
+    return -1;
+  }
+
+  if (cnt == 0) return 0;
+
+  // copy first, the caller may reuse its buffers as soon as we return
+
+  u64 buf_len = 0;
+
+  for (u32 i = 0; i < cnt; i++) buf_len += len_buf[i];
+
+  feed_batch_t batch;
+
+  batch.buf     = (u8 *)  hcmalloc (hashcat_ctx, buf_len + 1);         VERIFY_PTR (batch.buf);
+  batch.len_buf = (u32 *) hcmalloc (hashcat_ctx, cnt * sizeof (u32)); VERIFY_PTR (batch.len_buf);
+  batch.cnt     = cnt;
+  batch.pos     = 0;
+  batch.buf_off = 0;
+
+  memcpy (batch.buf,     buf,     buf_len);
+  memcpy (batch.len_buf, len_buf, cnt * sizeof (u32));
+
+  return feed_queue (hashcat_ctx, &batch, false);
+}
+
+void feed_finish (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  if (feed_ctx->enabled == false) return;
+
+  hc_thread_mutex_lock (feed_ctx->mux_feed);
+
+  feed_ctx->finished = true;
+
+  hc_thread_mutex_unlock (feed_ctx->mux_feed);
+}
+
+bool feed_wait (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  feed_ctx_t   *feed_ctx   = hashcat_ctx->feed_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  // returns false once the feed is finished and drained, that's our EOF
+
+  const feed_batch_t *cur = &device_param->feed_cur;
+
+  if (cur->pos < cur->cnt) return true;
+
+  while (status_ctx->run_thread_level1 == true)
+  {
+    hc_thread_mutex_lock (feed_ctx->mux_feed);
+
+    const bool available = (feed_ctx->batches_cnt > 0);
+    const bool finished  = feed_ctx->finished;
+
+    hc_thread_mutex_unlock (feed_ctx->mux_feed);
+
+    if (available == true) return true;
+
+    if (finished == true) return false;
+
+    hc_sleep_msec (1);
+  }
+
+  return false;
+}
+
+bool feed_next (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, char **line_buf, u32 *line_len)
+{
+  feed_ctx_t *feed_ctx = hashcat_ctx->feed_ctx;
+
+  // each device owns the batch it took from the ring, so only the ring needs a lock
+
+  feed_batch_t *cur = &device_param->feed_cur;
+
+  // the previous candidate was already added by the caller, so a used up batch can go now
+
+  if ((cur->cnt > 0) && (cur->pos == cur->cnt)) feed_batch_free (cur);
+
+  if (cur->cnt == 0)
+  {
+    hc_thread_mutex_lock (feed_ctx->mux_feed);
+
+    if (feed_ctx->batches_cnt == 0)
+    {
+      hc_thread_mutex_unlock (feed_ctx->mux_feed);
+
+      return false;
+    }
+
+    *cur = feed_ctx->batches[feed_ctx->batches_head];
+
+    memset (&feed_ctx->batches[feed_ctx->batches_head], 0, sizeof (feed_batch_t));
+
+    feed_ctx->batches_head = (feed_ctx->batches_head + 1) % FEED_BATCHES;
+
+    feed_ctx->batches_cnt--;
+
+    hc_thread_mutex_unlock (feed_ctx->mux_feed);
+  }
+
+  // the candidate stays in the batch buffer, the caller may modify it in place (e.g. $HEX[])
+
+  *line_buf = (char *) cur->buf + cur->buf_off;
+  *line_len = cur->len_buf[cur->pos];
+
+  cur->buf_off += cur->len_buf[cur->pos];
+
+  cur->pos++;
+
+  return true;
+}
+
+void feed_drop (hc_device_param_t *device_param)
+{
+  feed_batch_free (&device_param->feed_cur);
+}
+
+static int feed_stdin_push (hashcat_ctx_t *hashcat_ctx, const u8 *read_buf, const size_t read_len, const u32 lines_cnt)
+{
+  feed_batch_t batch;
+
+  batch.buf     = (u8 *)  hcmalloc (hashcat_ctx, read_len + 1);              VERIFY_PTR (batch.buf);
+  batch.len_buf = (u32 *) hcmalloc (hashcat_ctx, lines_cnt * sizeof (u32)); VERIFY_PTR (batch.len_buf);
+  batch.cnt     = lines_cnt;
+  batch.pos     = 0;
+  batch.buf_off = 0;
+
+  // same as in_superchop (), the line ends are dropped and the candidates are stored back to back
+
+  const u8 *line_start = read_buf;
+  const u8 *read_end   = read_buf + read_len;
+
+  u64 buf_off = 0;
+
+  for (u32 line_pos = 0; line_pos < lines_cnt; line_pos++)
+  {
+    const u8 *line_end = (const u8 *) memchr (line_start, '\n', read_end - line_start);
+
+    if (line_end == NULL) line_end = read_end;
+
+    const u8 *next = (line_end < read_end) ? line_end + 1 : read_end;
+
+    while ((line_end > line_start) && (line_end[-1] == '\r')) line_end--;
+
+    const u32 line_len = (u32) (line_end - line_start);
+
+    memcpy (batch.buf + buf_off, line_start, line_len);
+
+    batch.len_buf[line_pos] = line_len;
+
+    buf_off += line_len;
+
+    line_start = next;
+  }
+
+  return feed_queue (hashcat_ctx, &batch, true);
+}
+
+static int feed_stdin (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_ctx_t   *feed_ctx   = hashcat_ctx->feed_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  const int fd = fileno (stdin);
+
+  u8 *read_buf = (u8 *) hcmalloc (hashcat_ctx, FEED_READ_SIZE); VERIFY_PTR (read_buf);
+
+  size_t read_len = 0; // includes the incomplete line left over from the previous read
+
+  bool eof = false;
+
+  while (eof == false)
+  {
+    if (status_ctx->run_thread_level1 == false) break;
+
+    if (feed_ctx->finished == true) break;
+
+    // don't block in read (), we have to notice when the device threads are done
+
+    #if defined (_POSIX)
+    struct pollfd stdin_pfd;
+
+    stdin_pfd.fd      = fd;
+    stdin_pfd.events  = POLLIN;
+    stdin_pfd.revents = 0;
+
+    const int rc_poll = poll (&stdin_pfd, 1, 100);
+
+    if (rc_poll == 0) continue;
+
+    if ((rc_poll == -1) && (errno == EINTR)) continue;
+    #endif
+
+    const ssize_t nread = read (fd, read_buf + read_len, FEED_READ_SIZE - read_len);
+
+    if ((nread == -1) && (errno == EINTR)) continue;
+
+    if (nread <= 0)
+    {
+      eof = true;
+    }
+    else
+    {
+      read_len += (size_t) nread;
+    }
+
+    // count the complete lines, memchr () is vectorized by the C library
+
+    size_t lines_len = 0;
+    u32    lines_cnt = 0;
+
+    for (const u8 *line_end = read_buf; (line_end = (const u8 *) memchr (line_end, '\n', read_buf + read_len - line_end)) != NULL; line_end++)
+    {
+      lines_len = (size_t) (line_end - read_buf) + 1;
+
+      lines_cnt++;
+    }
+
+    // a line without newline at EOF still counts, a line longer than the buffer is cut
+
+    if (((eof == true) || ((read_len == FEED_READ_SIZE) && (lines_cnt == 0))) && (lines_len < read_len))
+    {
+      lines_len = read_len;
+
+      lines_cnt++;
+    }
+
+    if (lines_cnt == 0) continue;
+
+    const int rc_push = feed_stdin_push (hashcat_ctx, read_buf, lines_len, lines_cnt);
+
+    if (rc_push == -1) break;
+
+    memmove (read_buf, read_buf + lines_len, read_len - lines_len);
+
+    read_len -= lines_len;
+  }
+
+  hcfree (read_buf);
+
+  return 0;
+}
+
+void *thread_feed_stdin (void *p)
+{
+  hashcat_ctx_t *hashcat_ctx = (hashcat_ctx_t *) p;
+
+  feed_stdin (hashcat_ctx); // we should check the RC here
+
+  feed_finish (hashcat_ctx);
+
+  return NULL;
+}
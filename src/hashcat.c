@@ -25,17 +25,22 @@
 #include "autotune.h"
 #include "bitmap.h"
 #include "combinator.h"
+#include "compact.h"
 #include "cpt.h"
 #include "debugfile.h"
+#include "dedup.h"
 #include "dictstat.h"
 #include "dispatch.h"
 #include "event.h"
+#include "feed.h"
 #include "hashes.h"
 #include "hwmon.h"
 #include "induct.h"
 #include "interface.h"
+#include "host_backend.h"
 #include "logfile.h"
 #include "loopback.h"
+#include "metrics.h"
 #include "monitor.h"
 #include "mpsp.h"
 #include "opencl.h"
@@ -46,6 +51,8 @@
 #include "rp.h"
 #include "status.h"
 #include "straight.h"
+#include "trace.h"
+#include "tunecache.h"
 #include "tuningdb.h"
 #include "usage.h"
 #include "user_options.h"
@@ -59,7 +66,7 @@ extern const u32 DEFAULT_BENCHMARK_ALGORITHMS_BUF[];
 
 static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 {
-  hashes_t             *hashes              = hashcat_ctx->hashes;
+  feed_ctx_t           *feed_ctx            = hashcat_ctx->feed_ctx;
   induct_ctx_t         *induct_ctx          = hashcat_ctx->induct_ctx;
   logfile_ctx_t        *logfile_ctx         = hashcat_ctx->logfile_ctx;
   opencl_ctx_t         *opencl_ctx          = hashcat_ctx->opencl_ctx;
@@ -136,6 +143,8 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   if (user_options->keyspace == true) return 0;
 
+  dedup_check_keyspace (hashcat_ctx, status_ctx->words_base);
+
   // restore stuff
 
   if (status_ctx->words_off > status_ctx->words_base)
@@ -145,12 +154,13 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
     return -1;
   }
 
-  const u64 progress_restored = status_ctx->words_off * amplifier_cnt;
+  const int rc_journal = restore_journal_begin (hashcat_ctx);
 
-  for (u32 i = 0; i < hashes->salts_cnt; i++)
-  {
-    status_ctx->words_progress_restored[i] = progress_restored;
-  }
+  if (rc_journal == -1) return -1;
+
+  const u64 progress_restored = (status_ctx->words_off + status_ctx->words_skip_sum) * amplifier_cnt;
+
+  status_ctx->words_progress_restored = progress_restored;
 
   /**
    * limit kernel loops by the amplification count we have from:
@@ -223,6 +233,28 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   status_ctx->devices_status = STATUS_RUNNING;
 
+  /**
+   * stdin is read by one thread in large blocks and handed to the devices as batches through the candidate feed
+   * on windows we can't wait on the stdin handle with a timeout, so the device threads keep reading it themselves
+   */
+
+  #if defined (_POSIX)
+  const bool feed_stdin = (user_options_extra->wordlist_mode == WL_MODE_STDIN) && (feed_ctx->enabled == false);
+  #else
+  const bool feed_stdin = false;
+  #endif
+
+  hc_thread_t feed_thread;
+
+  if (feed_stdin == true)
+  {
+    const int rc_feed_init = feed_init (hashcat_ctx);
+
+    if (rc_feed_init == -1) return -1;
+
+    hc_thread_create (feed_thread, thread_feed_stdin, hashcat_ctx);
+  }
+
   for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
   {
     thread_param_t *thread_param = threads_param + device_id;
@@ -242,6 +274,17 @@ static int inner2_loop (hashcat_ctx_t *hashcat_ctx)
 
   hc_thread_wait (opencl_ctx->devices_cnt, c_threads);
 
+  if (feed_stdin == true)
+  {
+    // the reader may still be waiting for input nobody is going to use
+
+    feed_finish (hashcat_ctx);
+
+    hc_thread_wait (1, &feed_thread);
+
+    feed_destroy (hashcat_ctx);
+  }
+
   hcfree (c_threads);
 
   hcfree (threads_param);
@@ -520,6 +563,14 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
   EVENT (EVENT_BITMAP_INIT_POST);
 
+  /**
+   * hashlist compaction, works on the digests and bitmaps from above
+   */
+
+  const int rc_compact_init = compact_ctx_init (hashcat_ctx);
+
+  if (rc_compact_init == -1) return -1;
+
   /**
    * cracks-per-time allocate buffer
    */
@@ -534,6 +585,14 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
   if (rc_wl_data_init == -1) return -1;
 
+  /**
+   * candidate dedup, shared by all dictionaries and devices
+   */
+
+  const int rc_dedup_init = dedup_ctx_init (hashcat_ctx);
+
+  if (rc_dedup_init == -1) return -1;
+
   /**
    * straight mode init
    */
@@ -738,15 +797,17 @@ static int outer_loop (hashcat_ctx_t *hashcat_ctx)
 
   potfile_write_close (hashcat_ctx);
 
-  // finalize opencl session
+  // finalize opencl session, the programs and device buffers are kept for a following job with the same kernels
 
-  opencl_session_destroy (hashcat_ctx);
+  opencl_session_keep (hashcat_ctx);
 
   // clean up
 
   bitmap_ctx_destroy      (hashcat_ctx);
   combinator_ctx_destroy  (hashcat_ctx);
+  compact_ctx_destroy     (hashcat_ctx);
   cpt_ctx_destroy         (hashcat_ctx);
+  dedup_ctx_destroy       (hashcat_ctx);
   hashconfig_destroy      (hashcat_ctx);
   hashes_destroy          (hashcat_ctx);
   mask_ctx_destroy        (hashcat_ctx);
@@ -770,10 +831,13 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
 
   hashcat_ctx->bitmap_ctx         = (bitmap_ctx_t *)          hcmalloc (hashcat_ctx, sizeof (bitmap_ctx_t));            VERIFY_PTR (hashcat_ctx->bitmap_ctx);
   hashcat_ctx->combinator_ctx     = (combinator_ctx_t *)      hcmalloc (hashcat_ctx, sizeof (combinator_ctx_t));        VERIFY_PTR (hashcat_ctx->combinator_ctx);
+  hashcat_ctx->compact_ctx        = (compact_ctx_t *)         hcmalloc (hashcat_ctx, sizeof (compact_ctx_t));           VERIFY_PTR (hashcat_ctx->compact_ctx);
   hashcat_ctx->cpt_ctx            = (cpt_ctx_t *)             hcmalloc (hashcat_ctx, sizeof (cpt_ctx_t));               VERIFY_PTR (hashcat_ctx->cpt_ctx);
   hashcat_ctx->debugfile_ctx      = (debugfile_ctx_t *)       hcmalloc (hashcat_ctx, sizeof (debugfile_ctx_t));         VERIFY_PTR (hashcat_ctx->debugfile_ctx);
+  hashcat_ctx->dedup_ctx          = (dedup_ctx_t *)           hcmalloc (hashcat_ctx, sizeof (dedup_ctx_t));             VERIFY_PTR (hashcat_ctx->dedup_ctx);
   hashcat_ctx->dictstat_ctx       = (dictstat_ctx_t *)        hcmalloc (hashcat_ctx, sizeof (dictstat_ctx_t));          VERIFY_PTR (hashcat_ctx->dictstat_ctx);
   hashcat_ctx->event_ctx          = (event_ctx_t *)           hcmalloc (hashcat_ctx, sizeof (event_ctx_t));             VERIFY_PTR (hashcat_ctx->event_ctx);
+  hashcat_ctx->feed_ctx           = (feed_ctx_t *)            hcmalloc (hashcat_ctx, sizeof (feed_ctx_t));              VERIFY_PTR (hashcat_ctx->feed_ctx);
   hashcat_ctx->folder_config      = (folder_config_t *)       hcmalloc (hashcat_ctx, sizeof (folder_config_t));         VERIFY_PTR (hashcat_ctx->folder_config);
   hashcat_ctx->hashcat_user       = (hashcat_user_t *)        hcmalloc (hashcat_ctx, sizeof (hashcat_user_t));          VERIFY_PTR (hashcat_ctx->hashcat_user);
   hashcat_ctx->hashconfig         = (hashconfig_t *)          hcmalloc (hashcat_ctx, sizeof (hashconfig_t));            VERIFY_PTR (hashcat_ctx->hashconfig);
@@ -783,6 +847,7 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->logfile_ctx        = (logfile_ctx_t *)         hcmalloc (hashcat_ctx, sizeof (logfile_ctx_t));           VERIFY_PTR (hashcat_ctx->logfile_ctx);
   hashcat_ctx->loopback_ctx       = (loopback_ctx_t *)        hcmalloc (hashcat_ctx, sizeof (loopback_ctx_t));          VERIFY_PTR (hashcat_ctx->loopback_ctx);
   hashcat_ctx->mask_ctx           = (mask_ctx_t *)            hcmalloc (hashcat_ctx, sizeof (mask_ctx_t));              VERIFY_PTR (hashcat_ctx->mask_ctx);
+  hashcat_ctx->metrics_ctx        = (metrics_ctx_t *)         hcmalloc (hashcat_ctx, sizeof (metrics_ctx_t));           VERIFY_PTR (hashcat_ctx->metrics_ctx);
   hashcat_ctx->opencl_ctx         = (opencl_ctx_t *)          hcmalloc (hashcat_ctx, sizeof (opencl_ctx_t));            VERIFY_PTR (hashcat_ctx->opencl_ctx);
   hashcat_ctx->outcheck_ctx       = (outcheck_ctx_t *)        hcmalloc (hashcat_ctx, sizeof (outcheck_ctx_t));          VERIFY_PTR (hashcat_ctx->outcheck_ctx);
   hashcat_ctx->outfile_ctx        = (outfile_ctx_t *)         hcmalloc (hashcat_ctx, sizeof (outfile_ctx_t));           VERIFY_PTR (hashcat_ctx->outfile_ctx);
@@ -790,6 +855,8 @@ int hashcat_init (hashcat_ctx_t *hashcat_ctx, void (*event) (const u32, struct h
   hashcat_ctx->restore_ctx        = (restore_ctx_t *)         hcmalloc (hashcat_ctx, sizeof (restore_ctx_t));           VERIFY_PTR (hashcat_ctx->restore_ctx);
   hashcat_ctx->status_ctx         = (status_ctx_t *)          hcmalloc (hashcat_ctx, sizeof (status_ctx_t));            VERIFY_PTR (hashcat_ctx->status_ctx);
   hashcat_ctx->straight_ctx       = (straight_ctx_t *)        hcmalloc (hashcat_ctx, sizeof (straight_ctx_t));          VERIFY_PTR (hashcat_ctx->straight_ctx);
+  hashcat_ctx->trace_ctx          = (trace_ctx_t *)           hcmalloc (hashcat_ctx, sizeof (trace_ctx_t));             VERIFY_PTR (hashcat_ctx->trace_ctx);
+  hashcat_ctx->tunecache_ctx      = (tunecache_ctx_t *)       hcmalloc (hashcat_ctx, sizeof (tunecache_ctx_t));         VERIFY_PTR (hashcat_ctx->tunecache_ctx);
   hashcat_ctx->tuning_db          = (tuning_db_t *)           hcmalloc (hashcat_ctx, sizeof (tuning_db_t));             VERIFY_PTR (hashcat_ctx->tuning_db);
   hashcat_ctx->user_options_extra = (user_options_extra_t *)  hcmalloc (hashcat_ctx, sizeof (user_options_extra_t));    VERIFY_PTR (hashcat_ctx->user_options_extra);
   hashcat_ctx->user_options       = (user_options_t *)        hcmalloc (hashcat_ctx, sizeof (user_options_t));          VERIFY_PTR (hashcat_ctx->user_options);
@@ -802,10 +869,13 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
 {
   hcfree (hashcat_ctx->bitmap_ctx);
   hcfree (hashcat_ctx->combinator_ctx);
+  hcfree (hashcat_ctx->compact_ctx);
   hcfree (hashcat_ctx->cpt_ctx);
   hcfree (hashcat_ctx->debugfile_ctx);
+  hcfree (hashcat_ctx->dedup_ctx);
   hcfree (hashcat_ctx->dictstat_ctx);
   hcfree (hashcat_ctx->event_ctx);
+  hcfree (hashcat_ctx->feed_ctx);
   hcfree (hashcat_ctx->folder_config);
   hcfree (hashcat_ctx->hashconfig);
   hcfree (hashcat_ctx->hashes);
@@ -814,6 +884,7 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->logfile_ctx);
   hcfree (hashcat_ctx->loopback_ctx);
   hcfree (hashcat_ctx->mask_ctx);
+  hcfree (hashcat_ctx->metrics_ctx);
   hcfree (hashcat_ctx->opencl_ctx);
   hcfree (hashcat_ctx->outcheck_ctx);
   hcfree (hashcat_ctx->outfile_ctx);
@@ -821,6 +892,8 @@ void hashcat_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_ctx->restore_ctx);
   hcfree (hashcat_ctx->status_ctx);
   hcfree (hashcat_ctx->straight_ctx);
+  hcfree (hashcat_ctx->trace_ctx);
+  hcfree (hashcat_ctx->tunecache_ctx);
   hcfree (hashcat_ctx->tuning_db);
   hcfree (hashcat_ctx->user_options_extra);
   hcfree (hashcat_ctx->user_options);
@@ -873,6 +946,20 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, char *install_folder, char
 
   user_options_extra_init (hashcat_ctx);
 
+  /**
+   * candidate feed, takes the place of stdin
+   */
+
+  if (hashcat_ctx->feed_ctx->enabled == true)
+  {
+    if (hashcat_ctx->user_options_extra->wordlist_mode != WL_MODE_STDIN)
+    {
+      event_log_error (hashcat_ctx, "Candidate feed requires attack-mode 0 without a wordlist");
+
+      return -1;
+    }
+  }
+
   /**
    * logfile
    */
@@ -961,6 +1048,22 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, char *install_folder, char
 
   if (rc_dictstat_init == -1) return -1;
 
+  /**
+   * autotune cache init
+   */
+
+  const int rc_tunecache_init = tunecache_init (hashcat_ctx);
+
+  if (rc_tunecache_init == -1) return -1;
+
+  /**
+   * metrics init
+   */
+
+  const int rc_metrics_init = metrics_init (hashcat_ctx);
+
+  if (rc_metrics_init == -1) return -1;
+
   /**
    * loopback init
    */
@@ -993,6 +1096,14 @@ int hashcat_session_init (hashcat_ctx_t *hashcat_ctx, char *install_folder, char
 
   if (rc_devices_init == -1) return -1;
 
+  /**
+   * Trace recorder init, needs the number of devices
+   */
+
+  const int rc_trace_init = trace_init (hashcat_ctx);
+
+  if (rc_trace_init == -1) return -1;
+
   /**
    * HM devices: init
    */
@@ -1010,6 +1121,10 @@ int hashcat_session_run (hashcat_ctx_t *hashcat_ctx)
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
 
+  // kernel warm-up only fills the kernel cache, there's no attack to run
+
+  if (user_options->kernel_warmup != NULL) return opencl_kernel_warmup (hashcat_ctx);
+
   // add all user options to logfile in case we want to debug some user session
 
   user_options_logger (hashcat_ctx);
@@ -1026,6 +1141,10 @@ int hashcat_session_run (hashcat_ctx_t *hashcat_ctx)
 
   dictstat_read (hashcat_ctx);
 
+  // read autotune cache
+
+  tunecache_read (hashcat_ctx);
+
   /**
    * outer loop
    */
@@ -1050,6 +1169,8 @@ int hashcat_session_run (hashcat_ctx_t *hashcat_ctx)
       {
         user_options->hash_mode = DEFAULT_BENCHMARK_ALGORITHMS_BUF[algorithm_pos];
 
+        if ((user_options->backend_host == true) && (host_backend_supported (user_options->hash_mode) == false)) continue;
+
         rc_final = outer_loop (hashcat_ctx);
 
         if (rc_final == -1) myabort (hashcat_ctx);
@@ -1081,6 +1202,14 @@ int hashcat_session_run (hashcat_ctx_t *hashcat_ctx)
 
   dictstat_write (hashcat_ctx);
 
+  // final update autotune cache
+
+  tunecache_write (hashcat_ctx);
+
+  // dump the trace recorded by the device threads
+
+  trace_write (hashcat_ctx);
+
   // final logfile entry
 
   const time_t proc_stop = time (NULL);
@@ -1105,6 +1234,111 @@ int hashcat_session_run (hashcat_ctx_t *hashcat_ctx)
   return rc_final;
 }
 
+int hashcat_session_run_job (hashcat_ctx_t *hashcat_ctx, int hc_argc, char **hc_argv)
+{
+  status_ctx_t         *status_ctx         = hashcat_ctx->status_ctx;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options       = hashcat_ctx->user_options;
+
+  if (status_ctx->devices_status == STATUS_RUNNING || status_ctx->devices_status == STATUS_PAUSED)
+  {
+    event_log_error (hashcat_ctx, "Previous job is still running");
+
+    return -1;
+  }
+
+  if (hc_argc < 1 || hc_argv == NULL)
+  {
+    event_log_error (hashcat_ctx, "Invalid job arguments");
+
+    return -1;
+  }
+
+  // parse the job's command line from scratch, the same way main () does for the session
+  // on any error the options of the previous job stay in place
+
+  user_options_t session_options;
+
+  memcpy (&session_options, user_options, sizeof (user_options_t));
+
+  // user_options_init () leaves the *_chgd flags alone, start from the zeroed state of hashcat_init ()
+
+  memset (user_options, 0, sizeof (user_options_t));
+
+  int rc_options = user_options_init (hashcat_ctx);
+
+  if (rc_options == 0) rc_options = user_options_getopt (hashcat_ctx, hc_argc, hc_argv);
+
+  if (rc_options == 0) rc_options = user_options_sanity (hashcat_ctx);
+
+  if (rc_options == 0)
+  {
+    user_options_preprocess (hashcat_ctx);
+
+    rc_options = user_options_job_check (hashcat_ctx, &session_options);
+  }
+
+  if (rc_options == -1)
+  {
+    hcfree (user_options->rp_files);
+
+    memcpy (user_options, &session_options, sizeof (user_options_t));
+
+    return -1;
+  }
+
+  hcfree (session_options.rp_files);
+
+  // the restore file has to replay this job's command line, not the one of the session
+
+  restore_ctx_destroy (hashcat_ctx);
+
+  const int rc_restore_init = restore_ctx_init (hashcat_ctx, hc_argc, hc_argv);
+
+  if (rc_restore_init == -1) return -1;
+
+  // everything derived from hash_mode, attack_mode and the hashfile is rebuilt in outer_loop ()
+
+  user_options_extra_init (hashcat_ctx);
+
+  if ((user_options->benchmark == false) && (user_options_extra->hc_hash == NULL))
+  {
+    event_log_error (hashcat_ctx, "No hash or hashfile given for job");
+
+    return -1;
+  }
+
+  if (hashcat_ctx->feed_ctx->enabled == true)
+  {
+    if (user_options_extra->wordlist_mode != WL_MODE_STDIN)
+    {
+      event_log_error (hashcat_ctx, "Candidate feed requires attack-mode 0 without a wordlist");
+
+      return -1;
+    }
+
+    feed_reset (hashcat_ctx);
+  }
+
+  const int rc_outfile_and_hashfile = outfile_and_hashfile (hashcat_ctx);
+
+  if (rc_outfile_and_hashfile == -1) return -1;
+
+  // a previous job may have been aborted or stopped at a checkpoint
+
+  status_ctx->devices_status = STATUS_INIT;
+
+  status_ctx->run_main_level1   = true;
+  status_ctx->run_main_level2   = true;
+  status_ctx->run_main_level3   = true;
+  status_ctx->run_thread_level1 = true;
+  status_ctx->run_thread_level2 = true;
+
+  status_ctx->checkpoint_shutdown = false;
+
+  return hashcat_session_run (hashcat_ctx);
+}
+
 int hashcat_session_pause (hashcat_ctx_t *hashcat_ctx)
 {
   return SuspendThreads (hashcat_ctx);
@@ -1132,19 +1366,27 @@ int hashcat_session_quit (hashcat_ctx_t *hashcat_ctx)
 
 int hashcat_session_destroy (hashcat_ctx_t *hashcat_ctx)
 {
+  // the opencl session kept by the last outer loop, has to go before the OpenCL library is unloaded
+
+  opencl_session_destroy     (hashcat_ctx);
+
   debugfile_destroy          (hashcat_ctx);
   dictstat_destroy           (hashcat_ctx);
+  feed_destroy               (hashcat_ctx);
   folder_config_destroy      (hashcat_ctx);
   hwmon_ctx_destroy          (hashcat_ctx);
   induct_ctx_destroy         (hashcat_ctx);
   logfile_destroy            (hashcat_ctx);
   loopback_destroy           (hashcat_ctx);
+  metrics_destroy            (hashcat_ctx);
   opencl_ctx_destroy         (hashcat_ctx);
   opencl_ctx_devices_destroy (hashcat_ctx);
   outcheck_ctx_destroy       (hashcat_ctx);
   outfile_destroy            (hashcat_ctx);
   potfile_destroy            (hashcat_ctx);
   restore_ctx_destroy        (hashcat_ctx);
+  trace_destroy              (hashcat_ctx);
+  tunecache_destroy          (hashcat_ctx);
   tuning_db_destroy          (hashcat_ctx);
   user_options_destroy       (hashcat_ctx);
   user_options_extra_destroy (hashcat_ctx);
@@ -1208,6 +1450,7 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
   hashcat_status->progress_finished_percent   = status_get_progress_finished_percent  (hashcat_ctx);
   hashcat_status->progress_cur_relative_skip  = status_get_progress_cur_relative_skip (hashcat_ctx);
   hashcat_status->progress_cur                = status_get_progress_cur               (hashcat_ctx);
+  hashcat_status->progress_dedup              = status_get_progress_dedup             (hashcat_ctx);
   hashcat_status->progress_done               = status_get_progress_done              (hashcat_ctx);
   hashcat_status->progress_end_relative_skip  = status_get_progress_end_relative_skip (hashcat_ctx);
   hashcat_status->progress_end                = status_get_progress_end               (hashcat_ctx);
@@ -1250,6 +1493,9 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
     device_info->hashes_msec_dev            = status_get_hashes_msec_dev            (hashcat_ctx, device_id);
     device_info->hashes_msec_dev_benchmark  = status_get_hashes_msec_dev_benchmark  (hashcat_ctx, device_id);
     device_info->exec_msec_dev              = status_get_exec_msec_dev              (hashcat_ctx, device_id);
+    device_info->kernel_accel_dev           = status_get_kernel_accel_dev           (hashcat_ctx, device_id);
+    device_info->kernel_loops_dev           = status_get_kernel_loops_dev           (hashcat_ctx, device_id);
+    device_info->retune_cnt_dev             = status_get_retune_cnt_dev             (hashcat_ctx, device_id);
     device_info->speed_sec_dev              = status_get_speed_sec_dev              (hashcat_ctx, device_id);
     device_info->input_candidates_dev       = status_get_input_candidates_dev       (hashcat_ctx, device_id);
     device_info->hwmon_dev                  = status_get_hwmon_dev                  (hashcat_ctx, device_id);
@@ -1261,3 +1507,97 @@ int hashcat_get_status (hashcat_ctx_t *hashcat_ctx, hashcat_status_t *hashcat_st
 
   return 0;
 }
+
+int hashcat_feed_enable (hashcat_ctx_t *hashcat_ctx)
+{
+  return feed_init (hashcat_ctx);
+}
+
+int hashcat_feed_push (hashcat_ctx_t *hashcat_ctx, const u8 *buf, const u32 *len_buf, const u32 cnt)
+{
+  return feed_push (hashcat_ctx, buf, len_buf, cnt);
+}
+
+void hashcat_feed_finish (hashcat_ctx_t *hashcat_ctx)
+{
+  feed_finish (hashcat_ctx);
+}
+
+int hashcat_get_status_snapshot (hashcat_ctx_t *hashcat_ctx, status_snapshot_t *status_snapshot)
+{
+  const cpt_ctx_t      *cpt_ctx      = hashcat_ctx->cpt_ctx;
+  const hashes_t       *hashes       = hashcat_ctx->hashes;
+  const hwmon_ctx_t    *hwmon_ctx    = hashcat_ctx->hwmon_ctx;
+  status_ctx_t         *status_ctx   = hashcat_ctx->status_ctx;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  memset (status_snapshot, 0, sizeof (status_snapshot_t));
+
+  if (status_ctx == NULL) return -1; // ways too early
+
+  status_snapshot->timestamp = time (NULL);
+
+  // these are written by check_cracked () under mux_display, only copy them while holding it
+
+  hc_thread_mutex_lock (status_ctx->mux_display);
+
+  status_snapshot->digests_done  = hashes->digests_done;
+  status_snapshot->salts_done    = hashes->salts_done;
+  status_snapshot->cracked_total = cpt_ctx->cpt_total;
+
+  hc_thread_mutex_unlock (status_ctx->mux_display);
+
+  // everything else is a counter owned by a device thread or a plain read
+
+  status_snapshot->status_number              = status_get_status_number              (hashcat_ctx);
+  status_snapshot->digests_cnt                = status_get_digests_cnt                (hashcat_ctx);
+  status_snapshot->salts_cnt                  = status_get_salts_cnt                  (hashcat_ctx);
+  status_snapshot->msec_running               = status_get_msec_running               (hashcat_ctx);
+  status_snapshot->progress_cur_relative_skip = status_get_progress_cur_relative_skip (hashcat_ctx);
+  status_snapshot->progress_end_relative_skip = status_get_progress_end_relative_skip (hashcat_ctx);
+  status_snapshot->progress_done              = status_get_progress_done              (hashcat_ctx);
+  status_snapshot->progress_rejected          = status_get_progress_rejected          (hashcat_ctx);
+  status_snapshot->restore_point              = status_get_restore_point              (hashcat_ctx);
+  status_snapshot->restore_total              = status_get_restore_total              (hashcat_ctx);
+  status_snapshot->hashes_msec_all            = status_get_hashes_msec_all            (hashcat_ctx);
+
+  status_snapshot->device_cnt = status_get_device_info_cnt (hashcat_ctx);
+
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  for (int device_id = 0; device_id < status_snapshot->device_cnt; device_id++)
+  {
+    status_snapshot_dev_t *device = status_snapshot->device_buf + device_id;
+
+    device->skipped_dev       = status_get_skipped_dev       (hashcat_ctx, device_id);
+    device->hashes_msec_dev   = status_get_hashes_msec_dev   (hashcat_ctx, device_id);
+    device->exec_msec_dev     = status_get_exec_msec_dev     (hashcat_ctx, device_id);
+    device->kernel_accel_dev  = status_get_kernel_accel_dev  (hashcat_ctx, device_id);
+    device->kernel_loops_dev  = status_get_kernel_loops_dev  (hashcat_ctx, device_id);
+    device->progress_done_dev = opencl_ctx->devices_param[device_id].progress_done;
+
+    device->temperature_dev = -1;
+    device->fanspeed_dev    = -1;
+    device->utilization_dev = -1;
+  }
+
+  if ((hwmon_ctx->enabled == true) && (user_options->gpu_temp_disable == false))
+  {
+    hc_thread_mutex_lock (status_ctx->mux_hwmon);
+
+    for (int device_id = 0; device_id < status_snapshot->device_cnt; device_id++)
+    {
+      status_snapshot_dev_t *device = status_snapshot->device_buf + device_id;
+
+      if (device->skipped_dev == true) continue;
+
+      device->temperature_dev = hm_get_temperature_with_device_id (hashcat_ctx, device_id);
+      device->fanspeed_dev    = hm_get_fanspeed_with_device_id    (hashcat_ctx, device_id);
+      device->utilization_dev = hm_get_utilization_with_device_id (hashcat_ctx, device_id);
+    }
+
+    hc_thread_mutex_unlock (status_ctx->mux_hwmon);
+  }
+
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include "memory.h"
 #include "event.h"
 #include "hashes.h"
+#include "compact.h"
 
 #include "debugfile.h"
 #include "filehandling.h"
@@ -15,6 +16,7 @@
 #include "interface.h"
 #include "logfile.h"
 #include "loopback.h"
+#include "metrics.h"
 #include "mpsp.h"
 #include "opencl.h"
 #include "outfile.h"
@@ -23,6 +25,7 @@
 #include "rp_kernel_on_cpu.h"
 #include "thread.h"
 #include "timer.h"
+#include "trace.h"
 
 int sort_by_digest_p0p1 (const void *v1, const void *v2, void *v3)
 {
@@ -168,13 +171,18 @@ int save_hash (hashcat_ctx_t *hashcat_ctx)
           fputc (separator, fp);
         }
 
-        char out_buf[HCBUFSIZ_LARGE]; // scratch buffer
-
-        out_buf[0] = 0;
+        if ((hashes->hash_info != NULL) && (hashes->hash_info[idx] != NULL) && (hashes->hash_info[idx]->orighash != NULL))
+        {
+          fputs (hashes->hash_info[idx]->orighash, fp);
+        }
+        else
+        {
+          char out_buf[HCBUFSIZ_LARGE]; // scratch buffer
 
-        ascii_digest (hashcat_ctx, out_buf, salt_pos, digest_pos);
+          const int out_len = ascii_digest (hashcat_ctx, out_buf, salt_pos, digest_pos);
 
-        fputs (out_buf, fp);
+          fwrite (out_buf, 1, (size_t) out_len, fp);
+        }
 
         fputc ('\n', fp);
       }
@@ -259,8 +267,12 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
 
   // no need for locking, we're in a mutex protected function
 
+  const u64 ts_potfile = trace_now (hashcat_ctx);
+
   potfile_write_append (hashcat_ctx, out_buf, plain_ptr, plain_len);
 
+  trace_span (hashcat_ctx, device_param, TRACE_POTFILE_WRITE, ts_potfile, plain_len);
+
   // outfile, can be either to file or stdout
   // if an error occurs opening the file, send to stdout as fallback
   // the fp gets opened for each cracked hash so that the user can modify (move) the outfile while hashcat runs
@@ -275,6 +287,21 @@ void check_hash (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
 
   EVENT_DATA (EVENT_CRACKER_HASH_CRACKED, tmp_buf, tmp_len);
 
+  // the same crack as a record, for library users which do not want to parse the line above
+
+  crack_record_t crack_record;
+
+  crack_record.device_id  = device_param->device_id;
+  crack_record.salt_pos   = salt_pos;
+  crack_record.digest_pos = digest_pos;
+  crack_record.hash_pos   = plain->hash_pos;
+  crack_record.crackpos   = crackpos;
+  crack_record.plain_len  = (u32) MIN (plain_len, (int) sizeof (crack_record.plain_buf));
+
+  memcpy (crack_record.plain_buf, plain_ptr, crack_record.plain_len);
+
+  EVENT_DATA (EVENT_CRACKER_CRACK_RECORD, &crack_record, sizeof (crack_record_t));
+
   // if enabled, update also the loopback file
 
   if (loopback_ctx->fp != NULL)
@@ -310,28 +337,44 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
   cl_int CL_err;
 
-  CL_err = hc_clEnqueueReadBuffer (hashcat_ctx, device_param->command_queue, device_param->d_result, CL_TRUE, 0, sizeof (u32), &num_cracked, 0, NULL, NULL);
-
-  if (CL_err != CL_SUCCESS)
+  if (device_param->is_host == true)
   {
-    event_log_error (hashcat_ctx, "clEnqueueReadBuffer(): %s", val2cstr_cl (CL_err));
+    num_cracked = device_param->host_result;
+  }
+  else
+  {
+    CL_err = hc_clEnqueueReadBuffer (hashcat_ctx, device_param->command_queue, device_param->d_result, CL_TRUE, 0, sizeof (u32), &num_cracked, 0, NULL, NULL);
 
-    return -1;
+    if (CL_err != CL_SUCCESS)
+    {
+      event_log_error (hashcat_ctx, "clEnqueueReadBuffer(): %s", val2cstr_cl (CL_err));
+
+      return -1;
+    }
   }
 
   if (num_cracked)
   {
     plain_t *cracked = (plain_t *) hccalloc (hashcat_ctx, num_cracked, sizeof (plain_t)); VERIFY_PTR (cracked);
 
-    CL_err = hc_clEnqueueReadBuffer (hashcat_ctx, device_param->command_queue, device_param->d_plain_bufs, CL_TRUE, 0, num_cracked * sizeof (plain_t), cracked, 0, NULL, NULL);
-
-    if (CL_err != CL_SUCCESS)
+    if (device_param->is_host == true)
     {
-      event_log_error (hashcat_ctx, "clEnqueueReadBuffer(): %s", val2cstr_cl (CL_err));
+      memcpy (cracked, device_param->host_plain_bufs, num_cracked * sizeof (plain_t));
+    }
+    else
+    {
+      CL_err = hc_clEnqueueReadBuffer (hashcat_ctx, device_param->command_queue, device_param->d_plain_bufs, CL_TRUE, 0, num_cracked * sizeof (plain_t), cracked, 0, NULL, NULL);
 
-      return -1;
+      if (CL_err != CL_SUCCESS)
+      {
+        event_log_error (hashcat_ctx, "clEnqueueReadBuffer(): %s", val2cstr_cl (CL_err));
+
+        return -1;
+      }
     }
 
+    compact_plains (hashcat_ctx, device_param, cracked, num_cracked);
+
     u32 cpt_cracked = 0;
 
     hc_thread_mutex_lock (status_ctx->mux_display);
@@ -344,17 +387,23 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
       if ((hashconfig->opts_type & OPTS_TYPE_PT_NEVERCRACK) == 0)
       {
+        // a multi-salt launch reports cracks of several salts, so take the one from the plain
+
+        const u32 plain_salt_pos = cracked[i].salt_pos;
+
+        salt_t *plain_salt_buf = &hashes->salts_buf[plain_salt_pos];
+
         hashes->digests_shown[hash_pos] = 1;
 
         hashes->digests_done++;
 
         cpt_cracked++;
 
-        salt_buf->digests_done++;
+        plain_salt_buf->digests_done++;
 
-        if (salt_buf->digests_done == salt_buf->digests_cnt)
+        if (plain_salt_buf->digests_done == plain_salt_buf->digests_cnt)
         {
-          hashes->salts_shown[salt_pos] = 1;
+          hashes->salts_shown[plain_salt_pos] = 1;
 
           hashes->salts_done++;
         }
@@ -369,6 +418,8 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
     hcfree (cracked);
 
+    metrics_cracked (hashcat_ctx, device_param, cpt_cracked);
+
     if (cpt_cracked > 0)
     {
       hc_thread_mutex_lock (status_ctx->mux_display);
@@ -393,25 +444,39 @@ int check_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
       memset (hashes->digests_shown_tmp, 0, salt_buf->digests_cnt * sizeof (u32));
 
-      CL_err = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_shown, CL_TRUE, salt_buf->digests_offset * sizeof (u32), salt_buf->digests_cnt * sizeof (u32), &hashes->digests_shown_tmp[salt_buf->digests_offset], 0, NULL, NULL);
-
-      if (CL_err != CL_SUCCESS)
+      if (device_param->is_host == true)
       {
-        event_log_error (hashcat_ctx, "clEnqueueWriteBuffer(): %s", val2cstr_cl (CL_err));
+        memset (&device_param->host_digests_shown[salt_buf->digests_offset], 0, salt_buf->digests_cnt * sizeof (u32));
+      }
+      else
+      {
+        CL_err = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_shown, CL_TRUE, salt_buf->digests_offset * sizeof (u32), salt_buf->digests_cnt * sizeof (u32), &hashes->digests_shown_tmp[salt_buf->digests_offset], 0, NULL, NULL);
 
-        return -1;
+        if (CL_err != CL_SUCCESS)
+        {
+          event_log_error (hashcat_ctx, "clEnqueueWriteBuffer(): %s", val2cstr_cl (CL_err));
+
+          return -1;
+        }
       }
     }
 
     num_cracked = 0;
 
-    CL_err = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_result, CL_TRUE, 0, sizeof (u32), &num_cracked, 0, NULL, NULL);
-
-    if (CL_err != CL_SUCCESS)
+    if (device_param->is_host == true)
+    {
+      device_param->host_result = num_cracked;
+    }
+    else
     {
-      event_log_error (hashcat_ctx, "clEnqueueWriteBuffer(): %s", val2cstr_cl (CL_err));
+      CL_err = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_result, CL_TRUE, 0, sizeof (u32), &num_cracked, 0, NULL, NULL);
 
-      return -1;
+      if (CL_err != CL_SUCCESS)
+      {
+        event_log_error (hashcat_ctx, "clEnqueueWriteBuffer(): %s", val2cstr_cl (CL_err));
+
+        return -1;
+      }
     }
   }
 
@@ -1146,6 +1211,17 @@ int hashes_init_stage2 (hashcat_ctx_t *hashcat_ctx)
 
         salts_cnt++;
       }
+      else
+      {
+        // same salt as the previous hash, the old salts and esalts buffers are freed below
+
+        hashes_buf[hashes_pos].salt = salt_buf;
+
+        if (hashconfig->esalt_size)
+        {
+          hashes_buf[hashes_pos].esalt = hashes_buf[hashes_pos - 1].esalt;
+        }
+      }
     }
 
     salt_buf->digests_cnt++;
@@ -1252,6 +1328,9 @@ int hashes_init_stage4 (hashcat_ctx_t *hashcat_ctx)
   if (hashes->salts_cnt == 1)
     hashconfig->opti_type |= OPTI_TYPE_SINGLE_SALT;
 
+  if (hashes->salts_cnt == 1)
+    hashconfig->opti_type &= ~OPTI_TYPE_MULTI_SALT;
+
   if (hashes->digests_cnt == 1)
     hashconfig->opti_type |= OPTI_TYPE_SINGLE_HASH;
 
@@ -0,0 +1,1072 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#define IS_GENERIC
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "bitops.h"
+#include "event.h"
+#include "thread.h"
+#include "timer.h"
+#include "interface.h"
+#include "mpsp.h"
+#include "rp_kernel_on_cpu.h"
+#include "metrics.h"
+#include "trace.h"
+#include "inc_hash_constants.h"
+#include "inc_hash_functions.cl"
+#include "host_backend.h"
+
+/**
+ * The host backend takes the place of the OpenCL runtime for a few fast hashes.
+ * It uses the same host buffers, parameters and plain_t records as the kernels do,
+ * so the dispatcher, check_cracked () and build_plain () do not need to know about it.
+ */
+
+typedef u32 u32v __attribute__ ((vector_size (HOST_LANES * sizeof (u32))));
+
+// the runtime picks the widest clone the CPU supports, the baseline build stays runnable everywhere
+
+#if defined (__GNUC__) && !defined (__clang__) && defined (__x86_64__) && defined (__linux__)
+#define HOST_TARGET_CLONES __attribute__ ((target_clones ("avx512f", "avx2", "default")))
+#else
+#define HOST_TARGET_CLONES
+#endif
+
+#define HOST_ROTL(a,n) (((a) << (n)) | ((a) >> (32 - (n))))
+
+#define HOST_MD4_STEP(f,a,b,c,d,x,K,s)  \
+{                                       \
+  a += (u32) K;                         \
+  a += x;                               \
+  a += f (b, c, d);                     \
+  a  = HOST_ROTL (a, s);                \
+}
+
+#define HOST_MD5_STEP(f,a,b,c,d,x,K,s)  \
+{                                       \
+  a += (u32) K;                         \
+  a += x;                               \
+  a += f (b, c, d);                     \
+  a  = HOST_ROTL (a, s);                \
+  a += b;                               \
+}
+
+#define HOST_SHA1_STEP(f,a,b,c,d,e,x,K) \
+{                                       \
+  e += (u32) K;                         \
+  e += x;                               \
+  e += f (b, c, d);                     \
+  e += HOST_ROTL (a,  5);               \
+  b  = HOST_ROTL (b, 30);               \
+}
+
+#define HOST_SHA256_S0(x) (HOST_ROTL ((x), 25) ^ HOST_ROTL ((x), 14) ^ ((x) >>  3))
+#define HOST_SHA256_S1(x) (HOST_ROTL ((x), 15) ^ HOST_ROTL ((x), 13) ^ ((x) >> 10))
+#define HOST_SHA256_S2(x) (HOST_ROTL ((x), 30) ^ HOST_ROTL ((x), 19) ^ HOST_ROTL ((x), 10))
+#define HOST_SHA256_S3(x) (HOST_ROTL ((x), 26) ^ HOST_ROTL ((x), 21) ^ HOST_ROTL ((x),  7))
+
+#define HOST_SHA256_STEP(a,b,c,d,e,f,g,h,x,K) \
+{                                             \
+  h += (u32) K;                               \
+  h += x;                                     \
+  h += HOST_SHA256_S3 (e);                    \
+  h += SHA256_F1o (e, f, g);                  \
+  d += h;                                     \
+  h += HOST_SHA256_S2 (a);                    \
+  h += SHA256_F0o (a, b, c);                  \
+}
+
+static const u32 k_sha256[64] =
+{
+  SHA256C00, SHA256C01, SHA256C02, SHA256C03, SHA256C04, SHA256C05, SHA256C06, SHA256C07,
+  SHA256C08, SHA256C09, SHA256C0a, SHA256C0b, SHA256C0c, SHA256C0d, SHA256C0e, SHA256C0f,
+  SHA256C10, SHA256C11, SHA256C12, SHA256C13, SHA256C14, SHA256C15, SHA256C16, SHA256C17,
+  SHA256C18, SHA256C19, SHA256C1a, SHA256C1b, SHA256C1c, SHA256C1d, SHA256C1e, SHA256C1f,
+  SHA256C20, SHA256C21, SHA256C22, SHA256C23, SHA256C24, SHA256C25, SHA256C26, SHA256C27,
+  SHA256C28, SHA256C29, SHA256C2a, SHA256C2b, SHA256C2c, SHA256C2d, SHA256C2e, SHA256C2f,
+  SHA256C30, SHA256C31, SHA256C32, SHA256C33, SHA256C34, SHA256C35, SHA256C36, SHA256C37,
+  SHA256C38, SHA256C39, SHA256C3a, SHA256C3b, SHA256C3c, SHA256C3d, SHA256C3e, SHA256C3f,
+};
+
+static const u32 iv_md4[4]    = { MD4M_A, MD4M_B, MD4M_C, MD4M_D };
+static const u32 iv_md5[4]    = { MD5M_A, MD5M_B, MD5M_C, MD5M_D };
+static const u32 iv_sha1[5]   = { SHA1M_A, SHA1M_B, SHA1M_C, SHA1M_D, SHA1M_E };
+static const u32 iv_sha256[8] = { SHA256M_A, SHA256M_B, SHA256M_C, SHA256M_D, SHA256M_E, SHA256M_F, SHA256M_G, SHA256M_H };
+
+bool host_backend_supported (const u32 hash_mode)
+{
+  switch (hash_mode)
+  {
+    case    0: return true;
+    case  100: return true;
+    case 1000: return true;
+    case 1400: return true;
+    case 2000: return true;
+  }
+
+  return false;
+}
+
+/**
+ * transforms, HOST_LANES candidates at once
+ */
+
+static inline void host_md4_transform (const u32v w[16], u32v digest[4])
+{
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+
+  HOST_MD4_STEP (MD4_Fo, a, b, c, d, w[ 0], MD4C00, MD4S00);
+  HOST_MD4_STEP (MD4_Fo, d, a, b, c, w[ 1], MD4C00, MD4S01);
+  HOST_MD4_STEP (MD4_Fo, c, d, a, b, w[ 2], MD4C00, MD4S02);
+  HOST_MD4_STEP (MD4_Fo, b, c, d, a, w[ 3], MD4C00, MD4S03);
+  HOST_MD4_STEP (MD4_Fo, a, b, c, d, w[ 4], MD4C00, MD4S00);
+  HOST_MD4_STEP (MD4_Fo, d, a, b, c, w[ 5], MD4C00, MD4S01);
+  HOST_MD4_STEP (MD4_Fo, c, d, a, b, w[ 6], MD4C00, MD4S02);
+  HOST_MD4_STEP (MD4_Fo, b, c, d, a, w[ 7], MD4C00, MD4S03);
+  HOST_MD4_STEP (MD4_Fo, a, b, c, d, w[ 8], MD4C00, MD4S00);
+  HOST_MD4_STEP (MD4_Fo, d, a, b, c, w[ 9], MD4C00, MD4S01);
+  HOST_MD4_STEP (MD4_Fo, c, d, a, b, w[10], MD4C00, MD4S02);
+  HOST_MD4_STEP (MD4_Fo, b, c, d, a, w[11], MD4C00, MD4S03);
+  HOST_MD4_STEP (MD4_Fo, a, b, c, d, w[12], MD4C00, MD4S00);
+  HOST_MD4_STEP (MD4_Fo, d, a, b, c, w[13], MD4C00, MD4S01);
+  HOST_MD4_STEP (MD4_Fo, c, d, a, b, w[14], MD4C00, MD4S02);
+  HOST_MD4_STEP (MD4_Fo, b, c, d, a, w[15], MD4C00, MD4S03);
+
+  HOST_MD4_STEP (MD4_Go, a, b, c, d, w[ 0], MD4C01, MD4S10);
+  HOST_MD4_STEP (MD4_Go, d, a, b, c, w[ 4], MD4C01, MD4S11);
+  HOST_MD4_STEP (MD4_Go, c, d, a, b, w[ 8], MD4C01, MD4S12);
+  HOST_MD4_STEP (MD4_Go, b, c, d, a, w[12], MD4C01, MD4S13);
+  HOST_MD4_STEP (MD4_Go, a, b, c, d, w[ 1], MD4C01, MD4S10);
+  HOST_MD4_STEP (MD4_Go, d, a, b, c, w[ 5], MD4C01, MD4S11);
+  HOST_MD4_STEP (MD4_Go, c, d, a, b, w[ 9], MD4C01, MD4S12);
+  HOST_MD4_STEP (MD4_Go, b, c, d, a, w[13], MD4C01, MD4S13);
+  HOST_MD4_STEP (MD4_Go, a, b, c, d, w[ 2], MD4C01, MD4S10);
+  HOST_MD4_STEP (MD4_Go, d, a, b, c, w[ 6], MD4C01, MD4S11);
+  HOST_MD4_STEP (MD4_Go, c, d, a, b, w[10], MD4C01, MD4S12);
+  HOST_MD4_STEP (MD4_Go, b, c, d, a, w[14], MD4C01, MD4S13);
+  HOST_MD4_STEP (MD4_Go, a, b, c, d, w[ 3], MD4C01, MD4S10);
+  HOST_MD4_STEP (MD4_Go, d, a, b, c, w[ 7], MD4C01, MD4S11);
+  HOST_MD4_STEP (MD4_Go, c, d, a, b, w[11], MD4C01, MD4S12);
+  HOST_MD4_STEP (MD4_Go, b, c, d, a, w[15], MD4C01, MD4S13);
+
+  HOST_MD4_STEP (MD4_H , a, b, c, d, w[ 0], MD4C02, MD4S20);
+  HOST_MD4_STEP (MD4_H , d, a, b, c, w[ 8], MD4C02, MD4S21);
+  HOST_MD4_STEP (MD4_H , c, d, a, b, w[ 4], MD4C02, MD4S22);
+  HOST_MD4_STEP (MD4_H , b, c, d, a, w[12], MD4C02, MD4S23);
+  HOST_MD4_STEP (MD4_H , a, b, c, d, w[ 2], MD4C02, MD4S20);
+  HOST_MD4_STEP (MD4_H , d, a, b, c, w[10], MD4C02, MD4S21);
+  HOST_MD4_STEP (MD4_H , c, d, a, b, w[ 6], MD4C02, MD4S22);
+  HOST_MD4_STEP (MD4_H , b, c, d, a, w[14], MD4C02, MD4S23);
+  HOST_MD4_STEP (MD4_H , a, b, c, d, w[ 1], MD4C02, MD4S20);
+  HOST_MD4_STEP (MD4_H , d, a, b, c, w[ 9], MD4C02, MD4S21);
+  HOST_MD4_STEP (MD4_H , c, d, a, b, w[ 5], MD4C02, MD4S22);
+  HOST_MD4_STEP (MD4_H , b, c, d, a, w[13], MD4C02, MD4S23);
+  HOST_MD4_STEP (MD4_H , a, b, c, d, w[ 3], MD4C02, MD4S20);
+  HOST_MD4_STEP (MD4_H , d, a, b, c, w[11], MD4C02, MD4S21);
+  HOST_MD4_STEP (MD4_H , c, d, a, b, w[ 7], MD4C02, MD4S22);
+  HOST_MD4_STEP (MD4_H , b, c, d, a, w[15], MD4C02, MD4S23);
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+}
+
+static inline void host_md5_transform (const u32v w[16], u32v digest[4])
+{
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+
+  HOST_MD5_STEP (MD5_Fo, a, b, c, d, w[ 0], MD5C00, MD5S00);
+  HOST_MD5_STEP (MD5_Fo, d, a, b, c, w[ 1], MD5C01, MD5S01);
+  HOST_MD5_STEP (MD5_Fo, c, d, a, b, w[ 2], MD5C02, MD5S02);
+  HOST_MD5_STEP (MD5_Fo, b, c, d, a, w[ 3], MD5C03, MD5S03);
+  HOST_MD5_STEP (MD5_Fo, a, b, c, d, w[ 4], MD5C04, MD5S00);
+  HOST_MD5_STEP (MD5_Fo, d, a, b, c, w[ 5], MD5C05, MD5S01);
+  HOST_MD5_STEP (MD5_Fo, c, d, a, b, w[ 6], MD5C06, MD5S02);
+  HOST_MD5_STEP (MD5_Fo, b, c, d, a, w[ 7], MD5C07, MD5S03);
+  HOST_MD5_STEP (MD5_Fo, a, b, c, d, w[ 8], MD5C08, MD5S00);
+  HOST_MD5_STEP (MD5_Fo, d, a, b, c, w[ 9], MD5C09, MD5S01);
+  HOST_MD5_STEP (MD5_Fo, c, d, a, b, w[10], MD5C0a, MD5S02);
+  HOST_MD5_STEP (MD5_Fo, b, c, d, a, w[11], MD5C0b, MD5S03);
+  HOST_MD5_STEP (MD5_Fo, a, b, c, d, w[12], MD5C0c, MD5S00);
+  HOST_MD5_STEP (MD5_Fo, d, a, b, c, w[13], MD5C0d, MD5S01);
+  HOST_MD5_STEP (MD5_Fo, c, d, a, b, w[14], MD5C0e, MD5S02);
+  HOST_MD5_STEP (MD5_Fo, b, c, d, a, w[15], MD5C0f, MD5S03);
+
+  HOST_MD5_STEP (MD5_Go, a, b, c, d, w[ 1], MD5C10, MD5S10);
+  HOST_MD5_STEP (MD5_Go, d, a, b, c, w[ 6], MD5C11, MD5S11);
+  HOST_MD5_STEP (MD5_Go, c, d, a, b, w[11], MD5C12, MD5S12);
+  HOST_MD5_STEP (MD5_Go, b, c, d, a, w[ 0], MD5C13, MD5S13);
+  HOST_MD5_STEP (MD5_Go, a, b, c, d, w[ 5], MD5C14, MD5S10);
+  HOST_MD5_STEP (MD5_Go, d, a, b, c, w[10], MD5C15, MD5S11);
+  HOST_MD5_STEP (MD5_Go, c, d, a, b, w[15], MD5C16, MD5S12);
+  HOST_MD5_STEP (MD5_Go, b, c, d, a, w[ 4], MD5C17, MD5S13);
+  HOST_MD5_STEP (MD5_Go, a, b, c, d, w[ 9], MD5C18, MD5S10);
+  HOST_MD5_STEP (MD5_Go, d, a, b, c, w[14], MD5C19, MD5S11);
+  HOST_MD5_STEP (MD5_Go, c, d, a, b, w[ 3], MD5C1a, MD5S12);
+  HOST_MD5_STEP (MD5_Go, b, c, d, a, w[ 8], MD5C1b, MD5S13);
+  HOST_MD5_STEP (MD5_Go, a, b, c, d, w[13], MD5C1c, MD5S10);
+  HOST_MD5_STEP (MD5_Go, d, a, b, c, w[ 2], MD5C1d, MD5S11);
+  HOST_MD5_STEP (MD5_Go, c, d, a, b, w[ 7], MD5C1e, MD5S12);
+  HOST_MD5_STEP (MD5_Go, b, c, d, a, w[12], MD5C1f, MD5S13);
+
+  HOST_MD5_STEP (MD5_H , a, b, c, d, w[ 5], MD5C20, MD5S20);
+  HOST_MD5_STEP (MD5_H , d, a, b, c, w[ 8], MD5C21, MD5S21);
+  HOST_MD5_STEP (MD5_H , c, d, a, b, w[11], MD5C22, MD5S22);
+  HOST_MD5_STEP (MD5_H , b, c, d, a, w[14], MD5C23, MD5S23);
+  HOST_MD5_STEP (MD5_H , a, b, c, d, w[ 1], MD5C24, MD5S20);
+  HOST_MD5_STEP (MD5_H , d, a, b, c, w[ 4], MD5C25, MD5S21);
+  HOST_MD5_STEP (MD5_H , c, d, a, b, w[ 7], MD5C26, MD5S22);
+  HOST_MD5_STEP (MD5_H , b, c, d, a, w[10], MD5C27, MD5S23);
+  HOST_MD5_STEP (MD5_H , a, b, c, d, w[13], MD5C28, MD5S20);
+  HOST_MD5_STEP (MD5_H , d, a, b, c, w[ 0], MD5C29, MD5S21);
+  HOST_MD5_STEP (MD5_H , c, d, a, b, w[ 3], MD5C2a, MD5S22);
+  HOST_MD5_STEP (MD5_H , b, c, d, a, w[ 6], MD5C2b, MD5S23);
+  HOST_MD5_STEP (MD5_H , a, b, c, d, w[ 9], MD5C2c, MD5S20);
+  HOST_MD5_STEP (MD5_H , d, a, b, c, w[12], MD5C2d, MD5S21);
+  HOST_MD5_STEP (MD5_H , c, d, a, b, w[15], MD5C2e, MD5S22);
+  HOST_MD5_STEP (MD5_H , b, c, d, a, w[ 2], MD5C2f, MD5S23);
+
+  HOST_MD5_STEP (MD5_I , a, b, c, d, w[ 0], MD5C30, MD5S30);
+  HOST_MD5_STEP (MD5_I , d, a, b, c, w[ 7], MD5C31, MD5S31);
+  HOST_MD5_STEP (MD5_I , c, d, a, b, w[14], MD5C32, MD5S32);
+  HOST_MD5_STEP (MD5_I , b, c, d, a, w[ 5], MD5C33, MD5S33);
+  HOST_MD5_STEP (MD5_I , a, b, c, d, w[12], MD5C34, MD5S30);
+  HOST_MD5_STEP (MD5_I , d, a, b, c, w[ 3], MD5C35, MD5S31);
+  HOST_MD5_STEP (MD5_I , c, d, a, b, w[10], MD5C36, MD5S32);
+  HOST_MD5_STEP (MD5_I , b, c, d, a, w[ 1], MD5C37, MD5S33);
+  HOST_MD5_STEP (MD5_I , a, b, c, d, w[ 8], MD5C38, MD5S30);
+  HOST_MD5_STEP (MD5_I , d, a, b, c, w[15], MD5C39, MD5S31);
+  HOST_MD5_STEP (MD5_I , c, d, a, b, w[ 6], MD5C3a, MD5S32);
+  HOST_MD5_STEP (MD5_I , b, c, d, a, w[13], MD5C3b, MD5S33);
+  HOST_MD5_STEP (MD5_I , a, b, c, d, w[ 4], MD5C3c, MD5S30);
+  HOST_MD5_STEP (MD5_I , d, a, b, c, w[11], MD5C3d, MD5S31);
+  HOST_MD5_STEP (MD5_I , c, d, a, b, w[ 2], MD5C3e, MD5S32);
+  HOST_MD5_STEP (MD5_I , b, c, d, a, w[ 9], MD5C3f, MD5S33);
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+}
+
+static inline void host_sha1_transform (const u32v block[16], u32v digest[5])
+{
+  u32v w[16];
+
+  for (int i = 0; i < 16; i++) w[i] = block[i];
+
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+  u32v e = digest[4];
+
+  // five steps per iteration, that's where the register names are back in place
+
+  #define HOST_SHA1_EXPAND(t)                                                                         \
+  for (int j = (t); j < (t) + 5; j++)                                                                 \
+  {                                                                                                   \
+    if (j < 16) continue;                                                                             \
+                                                                                                      \
+    w[j & 15] = HOST_ROTL (w[(j - 3) & 15] ^ w[(j - 8) & 15] ^ w[(j - 14) & 15] ^ w[j & 15], 1);     \
+  }
+
+  #define HOST_SHA1_ROUND(f,t,K)                                          \
+  {                                                                       \
+    HOST_SHA1_EXPAND (t);                                                 \
+                                                                          \
+    HOST_SHA1_STEP (f, a, b, c, d, e, w[((t) + 0) & 15], K);              \
+    HOST_SHA1_STEP (f, e, a, b, c, d, w[((t) + 1) & 15], K);              \
+    HOST_SHA1_STEP (f, d, e, a, b, c, w[((t) + 2) & 15], K);              \
+    HOST_SHA1_STEP (f, c, d, e, a, b, w[((t) + 3) & 15], K);              \
+    HOST_SHA1_STEP (f, b, c, d, e, a, w[((t) + 4) & 15], K);              \
+  }
+
+  for (int t =  0; t < 20; t += 5) HOST_SHA1_ROUND (SHA1_F0o, t, SHA1C00);
+  for (int t = 20; t < 40; t += 5) HOST_SHA1_ROUND (SHA1_F1,  t, SHA1C01);
+  for (int t = 40; t < 60; t += 5) HOST_SHA1_ROUND (SHA1_F2o, t, SHA1C02);
+  for (int t = 60; t < 80; t += 5) HOST_SHA1_ROUND (SHA1_F1,  t, SHA1C03);
+
+  #undef HOST_SHA1_ROUND
+  #undef HOST_SHA1_EXPAND
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+  digest[4] += e;
+}
+
+static inline void host_sha256_transform (const u32v block[16], u32v digest[8])
+{
+  u32v w[16];
+
+  for (int i = 0; i < 16; i++) w[i] = block[i];
+
+  u32v a = digest[0];
+  u32v b = digest[1];
+  u32v c = digest[2];
+  u32v d = digest[3];
+  u32v e = digest[4];
+  u32v f = digest[5];
+  u32v g = digest[6];
+  u32v h = digest[7];
+
+  // eight steps per iteration, same as with SHA1 above
+
+  for (int t = 0; t < 64; t += 8)
+  {
+    for (int j = t; j < t + 8; j++)
+    {
+      if (j < 16) continue;
+
+      w[j & 15] = HOST_SHA256_S1 (w[(j - 2) & 15]) + w[(j - 7) & 15] + HOST_SHA256_S0 (w[(j - 15) & 15]) + w[j & 15];
+    }
+
+    HOST_SHA256_STEP (a, b, c, d, e, f, g, h, w[(t + 0) & 15], k_sha256[t + 0]);
+    HOST_SHA256_STEP (h, a, b, c, d, e, f, g, w[(t + 1) & 15], k_sha256[t + 1]);
+    HOST_SHA256_STEP (g, h, a, b, c, d, e, f, w[(t + 2) & 15], k_sha256[t + 2]);
+    HOST_SHA256_STEP (f, g, h, a, b, c, d, e, w[(t + 3) & 15], k_sha256[t + 3]);
+    HOST_SHA256_STEP (e, f, g, h, a, b, c, d, w[(t + 4) & 15], k_sha256[t + 4]);
+    HOST_SHA256_STEP (d, e, f, g, h, a, b, c, w[(t + 5) & 15], k_sha256[t + 5]);
+    HOST_SHA256_STEP (c, d, e, f, g, h, a, b, w[(t + 6) & 15], k_sha256[t + 6]);
+    HOST_SHA256_STEP (b, c, d, e, f, g, h, a, w[(t + 7) & 15], k_sha256[t + 7]);
+  }
+
+  digest[0] += a;
+  digest[1] += b;
+  digest[2] += c;
+  digest[3] += d;
+  digest[4] += e;
+  digest[5] += f;
+  digest[6] += g;
+  digest[7] += h;
+}
+
+HOST_TARGET_CLONES
+static void host_hash (const u32 hash_type, const u32v w[HOST_BLOCKS_MAX][16], const u32v *blocks, const u32 blocks_max, u32v digest[8])
+{
+  const u32 *iv = NULL;
+
+  u32 iv_cnt = 0;
+
+  switch (hash_type)
+  {
+    case HASH_TYPE_MD4:    iv = iv_md4;    iv_cnt = 4; break;
+    case HASH_TYPE_MD5:    iv = iv_md5;    iv_cnt = 4; break;
+    case HASH_TYPE_SHA1:   iv = iv_sha1;   iv_cnt = 5; break;
+    case HASH_TYPE_SHA256: iv = iv_sha256; iv_cnt = 8; break;
+  }
+
+  for (u32 i = 0; i < iv_cnt; i++) digest[i] = (u32v) { 0 } + iv[i];
+
+  for (u32 block = 0; block < blocks_max; block++)
+  {
+    u32v tmp[8];
+
+    for (u32 i = 0; i < iv_cnt; i++) tmp[i] = digest[i];
+
+    switch (hash_type)
+    {
+      case HASH_TYPE_MD4:    host_md4_transform    (w[block], tmp); break;
+      case HASH_TYPE_MD5:    host_md5_transform    (w[block], tmp); break;
+      case HASH_TYPE_SHA1:   host_sha1_transform   (w[block], tmp); break;
+      case HASH_TYPE_SHA256: host_sha256_transform (w[block], tmp); break;
+    }
+
+    // lanes with a shorter message keep the state of their last block
+
+    const u32v active = (u32v) (*blocks > block);
+
+    for (u32 i = 0; i < iv_cnt; i++) digest[i] = (tmp[i] & active) | (digest[i] & ~active);
+  }
+
+  // the parsers store the digests without the initial values, see md5_parse_hash () and friends
+
+  for (u32 i = 0; i < iv_cnt; i++) digest[i] -= iv[i];
+}
+
+/**
+ * candidates and compare, the same as in the kernels
+ */
+
+static u32 host_candidate (const host_launch_t *launch, const u8 *base_buf, const u32 base_len, const u32 il_pos, u8 *plain_buf)
+{
+  u32 plain_len = 0;
+
+  if (launch->amp_mode == HOST_AMP_RULES)
+  {
+    u32 buf[16];
+
+    memcpy (buf, base_buf, sizeof (buf));
+
+    const kernel_rule_t *rules_buf = (const kernel_rule_t *) launch->rules_buf;
+
+    plain_len = apply_rules ((u32 *) rules_buf[il_pos].cmds, &buf[0], &buf[4], base_len);
+
+    plain_len = MIN (plain_len, sizeof (buf));
+
+    memcpy (plain_buf, buf, plain_len);
+  }
+  else
+  {
+    const comb_t *comb = &launch->combs_buf[il_pos];
+
+    const u32 comb_len = MIN (comb->pw_len, sizeof (comb->i));
+
+    if (launch->amp_mode == HOST_AMP_APPEND)
+    {
+      memcpy (plain_buf,            base_buf, base_len);
+      memcpy (plain_buf + base_len, comb->i,  comb_len);
+    }
+    else
+    {
+      memcpy (plain_buf,            comb->i,  comb_len);
+      memcpy (plain_buf + comb_len, base_buf, base_len);
+    }
+
+    plain_len = base_len + comb_len;
+  }
+
+  // same as process_stdout (), a pw_max of PW_DICTMAX1 only limits the base words of the amplifier modes
+
+  if ((launch->amp_mode == HOST_AMP_RULES) || (launch->pw_max != PW_DICTMAX1))
+  {
+    plain_len = MIN (plain_len, launch->pw_max);
+  }
+
+  return MIN (plain_len, PW_MAX);
+}
+
+static u32 host_message (const host_launch_t *launch, const u8 *plain_buf, const u32 plain_len, u32 msg_buf[HOST_BLOCKS_MAX * 16])
+{
+  u8 *msg_ptr = (u8 *) msg_buf;
+
+  memset (msg_buf, 0, HOST_BLOCKS_MAX * 64);
+
+  u32 msg_len = plain_len;
+
+  if (launch->unicode == true)
+  {
+    for (u32 i = 0; i < plain_len; i++) msg_ptr[i * 2] = plain_buf[i];
+
+    msg_len *= 2;
+  }
+  else
+  {
+    memcpy (msg_ptr, plain_buf, plain_len);
+  }
+
+  msg_ptr[msg_len] = 0x80;
+
+  const u32 blocks = ((msg_len + 8) / 64) + 1;
+
+  const u32 last = (blocks * 16) - 1;
+
+  if (launch->big_endian == true)
+  {
+    for (u32 i = 0; i < last; i++) msg_buf[i] = byte_swap_32 (msg_buf[i]);
+
+    msg_buf[last] = msg_len * 8;
+  }
+  else
+  {
+    msg_buf[last - 1] = msg_len * 8;
+  }
+
+  return blocks;
+}
+
+static bool host_check_bitmaps (const host_launch_t *launch, const u32 digest_tp[4])
+{
+  const u32 mask = launch->bitmap_mask;
+
+  for (u32 i = 0; i < 8; i++)
+  {
+    const u32 shift = (i < 4) ? launch->bitmap_shift1 : launch->bitmap_shift2;
+
+    const u32 d = digest_tp[i & 3];
+
+    if ((launch->bitmaps[i][(d >> shift) & mask] & (1u << (d & 0x1f))) == 0) return false;
+  }
+
+  return true;
+}
+
+static int host_find_hash (const host_launch_t *launch, const u32 digest_tp[4])
+{
+  const u32 *digests_buf = launch->digests_buf + ((size_t) launch->digests_offset * launch->dgst_words);
+
+  // same search as find_hash () in the kernels, the digests are sorted by sort_by_digest_p0p1 ()
+
+  for (u32 l = 0, r = launch->digests_cnt; r; r >>= 1)
+  {
+    const u32 m = r >> 1;
+
+    const u32 c = l + m;
+
+    const u32 *digest = digests_buf + ((size_t) c * launch->dgst_words);
+
+    int cmp = 0;
+
+    if      (digest_tp[3] > digest[launch->dgst_pos3]) cmp =  1;
+    else if (digest_tp[3] < digest[launch->dgst_pos3]) cmp = -1;
+    else if (digest_tp[2] > digest[launch->dgst_pos2]) cmp =  1;
+    else if (digest_tp[2] < digest[launch->dgst_pos2]) cmp = -1;
+    else if (digest_tp[1] > digest[launch->dgst_pos1]) cmp =  1;
+    else if (digest_tp[1] < digest[launch->dgst_pos1]) cmp = -1;
+    else if (digest_tp[0] > digest[launch->dgst_pos0]) cmp =  1;
+    else if (digest_tp[0] < digest[launch->dgst_pos0]) cmp = -1;
+
+    if (cmp == 0) return (int) c;
+
+    if (cmp > 0)
+    {
+      l += m + 1;
+
+      r--;
+    }
+  }
+
+  return -1;
+}
+
+static void host_compare (const host_launch_t *launch, const u32 *digest, const u32 gidvid, const u32 il_pos)
+{
+  const u32 digest_tp[4] =
+  {
+    digest[launch->dgst_pos0],
+    digest[launch->dgst_pos1],
+    digest[launch->dgst_pos2],
+    digest[launch->dgst_pos3],
+  };
+
+  if (host_check_bitmaps (launch, digest_tp) == false) return;
+
+  const int digest_pos = host_find_hash (launch, digest_tp);
+
+  if (digest_pos == -1) return;
+
+  const u32 final_hash_pos = launch->digests_offset + (u32) digest_pos;
+
+  if (__sync_fetch_and_add (&launch->digests_shown[final_hash_pos], 1) != 0) return;
+
+  const u32 idx = __sync_fetch_and_add (launch->result, 1);
+
+  plain_t *plain = &launch->plains_buf[idx];
+
+  plain->salt_pos   = launch->salt_pos;
+  plain->digest_pos = (u32) digest_pos;   // relative
+  plain->hash_pos   = final_hash_pos;     // absolute
+  plain->gidvid     = gidvid;
+  plain->il_pos     = il_pos;
+}
+
+static void host_crack (const host_launch_t *launch, const u64 pos, const u64 cnt)
+{
+  u32v w[HOST_BLOCKS_MAX][16];
+  u32v blocks;
+  u32v digest[8];
+
+  memset (w, 0, sizeof (w));
+
+  blocks = (u32v) { 0 };
+
+  u32 lanes_gidvid[HOST_LANES];
+  u32 lanes_il_pos[HOST_LANES];
+
+  u32 lanes      = 0;
+  u32 blocks_max = 0;
+
+  u32 gidvid = (u32) (pos / launch->il_cnt);
+  u32 il_pos = (u32) (pos % launch->il_cnt);
+
+  u8  base_buf[64];
+  u32 base_len    = 0;
+  u32 base_gidvid = (u32) -1;
+
+  u8  plain_buf[128];
+  u32 msg_buf[HOST_BLOCKS_MAX * 16];
+
+  for (u64 i = 0; i < cnt; i++)
+  {
+    if (base_gidvid != gidvid)
+    {
+      const pw_t *pw = &launch->pws_buf[gidvid];
+
+      memcpy (base_buf, pw->i, sizeof (base_buf));
+
+      base_len    = MIN (pw->pw_len, sizeof (base_buf));
+      base_gidvid = gidvid;
+    }
+
+    const u32 plain_len = host_candidate (launch, base_buf, base_len, il_pos, plain_buf);
+
+    const u32 msg_blocks = host_message (launch, plain_buf, plain_len, msg_buf);
+
+    for (u32 block = 0; block < HOST_BLOCKS_MAX; block++)
+    {
+      for (u32 j = 0; j < 16; j++) w[block][j][lanes] = msg_buf[(block * 16) + j];
+    }
+
+    blocks[lanes] = msg_blocks;
+
+    blocks_max = MAX (blocks_max, msg_blocks);
+
+    lanes_gidvid[lanes] = gidvid;
+    lanes_il_pos[lanes] = il_pos;
+
+    lanes++;
+
+    il_pos++;
+
+    if (il_pos == launch->il_cnt)
+    {
+      il_pos = 0;
+
+      gidvid++;
+    }
+
+    if ((lanes < HOST_LANES) && (i + 1 < cnt)) continue;
+
+    host_hash (launch->hash_type, (const u32v (*)[16]) w, &blocks, blocks_max, digest);
+
+    for (u32 lane = 0; lane < lanes; lane++)
+    {
+      u32 digest_lane[8];
+
+      for (u32 j = 0; j < launch->dgst_words; j++) digest_lane[j] = digest[j][lane];
+
+      host_compare (launch, digest_lane, lanes_gidvid[lane], lanes_il_pos[lane]);
+    }
+
+    lanes      = 0;
+    blocks_max = 0;
+  }
+}
+
+static void *thread_host_crack (void *p)
+{
+  host_worker_t *worker = (host_worker_t *) p;
+
+  host_crack (worker->launch, worker->pos, worker->cnt);
+
+  return NULL;
+}
+
+/**
+ * device and session
+ */
+
+int host_backend_device_init (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  u32 device_processors = 1;
+  u64 device_global_mem = 0;
+
+  #if defined (_WIN)
+  SYSTEM_INFO system_info;
+
+  GetSystemInfo (&system_info);
+
+  device_processors = system_info.dwNumberOfProcessors;
+
+  MEMORYSTATUSEX memory_status;
+
+  memory_status.dwLength = sizeof (memory_status);
+
+  if (GlobalMemoryStatusEx (&memory_status) != 0) device_global_mem = memory_status.ullTotalPhys;
+  #else
+  const long cpus_online = sysconf (_SC_NPROCESSORS_ONLN);
+
+  if (cpus_online > 0) device_processors = (u32) cpus_online;
+
+  const long phys_pages = sysconf (_SC_PHYS_PAGES);
+  const long page_size  = sysconf (_SC_PAGESIZE);
+
+  if ((phys_pages > 0) && (page_size > 0)) device_global_mem = (u64) phys_pages * (u64) page_size;
+  #endif
+
+  if (device_global_mem == 0) device_global_mem = 1024 * 1024 * 1024;
+
+  device_param->is_host             = true;
+  device_param->device_type         = CL_DEVICE_TYPE_CPU;
+  device_param->device_vendor_id    = VENDOR_ID_GENERIC;
+  device_param->platform_vendor_id  = VENDOR_ID_GENERIC;
+
+  device_param->device_name         = hcstrdup (hashcat_ctx, "Host CPU");
+  device_param->device_vendor       = hcstrdup (hashcat_ctx, "Host");
+  device_param->device_name_chksum  = hcstrdup (hashcat_ctx, "host");
+  device_param->device_version      = hcstrdup (hashcat_ctx, "native");
+  device_param->driver_version      = hcstrdup (hashcat_ctx, "native");
+
+  // same as most OpenCL CPU runtimes, a single allocation may take a quarter of the memory
+
+  device_param->device_processors         = device_processors;
+  device_param->device_global_mem         = device_global_mem;
+  device_param->device_maxmem_alloc       = device_global_mem / 4;
+  device_param->device_maxclock_frequency = 0;
+  device_param->device_maxworkgroup_size  = HOST_LANES;
+
+  device_param->host_threads = device_processors;
+
+  return 0;
+}
+
+int host_backend_session_begin (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  hashes_t             *hashes              = hashcat_ctx->hashes;
+  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  if (host_backend_supported (hashconfig->hash_mode) == false)
+  {
+    event_log_error (hashcat_ctx, "* Device #%u: Hash-mode %u is not supported by --backend-host", device_param->device_id + 1, hashconfig->hash_mode);
+
+    return -1;
+  }
+
+  device_param->vector_width = HOST_LANES;
+
+  device_param->kernel_accel_min = 1;
+  device_param->kernel_accel_max = 1024;
+
+  device_param->kernel_loops_min = 1;
+  device_param->kernel_loops_max = 1024;
+
+  if (user_options->kernel_accel_chgd == true)
+  {
+    device_param->kernel_accel_min = user_options->kernel_accel;
+    device_param->kernel_accel_max = user_options->kernel_accel;
+  }
+
+  if (user_options->kernel_loops_chgd == true)
+  {
+    device_param->kernel_loops_min = user_options->kernel_loops;
+    device_param->kernel_loops_max = user_options->kernel_loops;
+  }
+
+  // a work-group is one group of lanes, the workers split a launch among them
+
+  device_param->kernel_threads = HOST_LANES;
+
+  device_param->kernel_salts = 1;
+
+  device_param->hardware_power = device_param->device_processors * device_param->kernel_threads;
+
+  const u32 kernel_power_max = device_param->device_processors * device_param->kernel_threads * device_param->kernel_accel_max;
+
+  device_param->size_pws        = kernel_power_max * sizeof (pw_t);
+  device_param->size_tmps       = 4;
+  device_param->size_hooks      = 4;
+  device_param->size_bfs        = KERNEL_BFS   * sizeof (bf_t);
+  device_param->size_combs      = KERNEL_COMBS * sizeof (comb_t);
+  device_param->size_rules      = straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
+  device_param->size_rules_c    = KERNEL_RULES                   * sizeof (kernel_rule_t);
+  device_param->size_root_css   = SP_PW_MAX *           sizeof (cs_t);
+  device_param->size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+  device_param->size_plains     = hashes->digests_cnt * sizeof (plain_t);
+  device_param->size_digests    = hashes->digests_cnt * hashconfig->dgst_size;
+  device_param->size_shown      = hashes->digests_cnt * sizeof (u32);
+  device_param->size_salts      = hashes->salts_cnt   * sizeof (salt_t);
+  device_param->size_results    = sizeof (u32);
+
+  // host memory is all the device memory there is, the amplifiers are resident whenever they were loaded
+
+  device_param->combs_resident = (user_options->attack_mode == ATTACK_MODE_COMBI) && (combinator_ctx->combs_buf != NULL);
+
+  device_param->size_combs_all = (device_param->combs_resident == true) ? combinator_ctx->combs_cnt * sizeof (comb_t) : 0;
+
+  device_param->pws_buf            = (pw_t *)    hccalloc (hashcat_ctx, kernel_power_max,    sizeof (pw_t));    VERIFY_PTR (device_param->pws_buf);
+  device_param->combs_buf          = (comb_t *)  hccalloc (hashcat_ctx, KERNEL_COMBS,        sizeof (comb_t));  VERIFY_PTR (device_param->combs_buf);
+  device_param->host_digests_shown = (u32 *)     hccalloc (hashcat_ctx, hashes->digests_cnt, sizeof (u32));     VERIFY_PTR (device_param->host_digests_shown);
+  device_param->host_plain_bufs    = (plain_t *) hccalloc (hashcat_ctx, hashes->digests_cnt, sizeof (plain_t)); VERIFY_PTR (device_param->host_plain_bufs);
+
+  memcpy (device_param->host_digests_shown, hashes->digests_shown, device_param->size_shown);
+
+  device_param->host_result = 0;
+
+  device_param->kernel_params_buf32[24] = bitmap_ctx->bitmap_mask;
+  device_param->kernel_params_buf32[25] = bitmap_ctx->bitmap_shift1;
+  device_param->kernel_params_buf32[26] = bitmap_ctx->bitmap_shift2;
+  device_param->kernel_params_buf32[27] = 0; // salt_pos
+  device_param->kernel_params_buf32[28] = 0; // loop_pos
+  device_param->kernel_params_buf32[29] = 0; // loop_cnt
+  device_param->kernel_params_buf32[30] = 0; // kernel_rules_cnt
+  device_param->kernel_params_buf32[31] = 0; // digests_cnt
+  device_param->kernel_params_buf32[32] = 0; // digests_offset
+  device_param->kernel_params_buf32[33] = 0; // combs_mode
+  device_param->kernel_params_buf32[34] = 0; // gid_max
+
+  device_param->kernel_params_mp_buf64[3] = 0;
+  device_param->kernel_params_mp_buf32[4] = 0;
+
+  device_param->kernel_params_mp_l_buf64[3] = 0;
+  device_param->kernel_params_mp_l_buf32[4] = 0;
+  device_param->kernel_params_mp_l_buf32[5] = 0;
+
+  device_param->kernel_params_mp_r_buf64[3] = 0;
+  device_param->kernel_params_mp_r_buf32[4] = 0;
+  device_param->kernel_params_mp_r_buf32[5] = 0;
+
+  return 0;
+}
+
+void host_backend_session_destroy (hc_device_param_t *device_param)
+{
+  if (device_param->is_host == false) return;
+
+  hcfree (device_param->host_digests_shown);
+  hcfree (device_param->host_plain_bufs);
+
+  device_param->host_digests_shown = NULL;
+  device_param->host_plain_bufs    = NULL;
+  device_param->host_result        = 0;
+}
+
+/**
+ * launches
+ */
+
+int host_backend_run_mp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num)
+{
+  mask_ctx_t *mask_ctx = hashcat_ctx->mask_ctx;
+
+  // the same layout the mp kernels produce, see build_plain ()
+
+  if (kern_run == KERN_RUN_MP_L)
+  {
+    const u64 off   = device_param->kernel_params_mp_l_buf64[3];
+    const u32 len   = device_param->kernel_params_mp_l_buf32[4];
+    const u32 start = device_param->kernel_params_mp_l_buf32[5];
+
+    for (u32 i = 0; i < num; i++)
+    {
+      pw_t *pw = &device_param->pws_buf[i];
+
+      sp_exec (off + i, (char *) pw->i, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + len);
+
+      pw->pw_len = len;
+    }
+  }
+  else
+  {
+    const u64 off   = (kern_run == KERN_RUN_MP_R) ? device_param->kernel_params_mp_r_buf64[3] : device_param->kernel_params_mp_buf64[3];
+    const u32 len   = (kern_run == KERN_RUN_MP_R) ? device_param->kernel_params_mp_r_buf32[4] : device_param->kernel_params_mp_buf32[4];
+    const u32 start = (kern_run == KERN_RUN_MP_R) ? device_param->kernel_params_mp_r_buf32[5] : 0;
+
+    for (u32 i = 0; i < num; i++)
+    {
+      comb_t *comb = &device_param->combs_buf[i];
+
+      sp_exec (off + i, (char *) comb->i, mask_ctx->root_css_buf, mask_ctx->markov_css_buf, start, start + len);
+
+      comb->pw_len = len;
+    }
+  }
+
+  return 0;
+}
+
+int host_backend_run (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num, const u32 event_update, const u32 iteration)
+{
+  bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  hashes_t             *hashes              = hashcat_ctx->hashes;
+  status_ctx_t         *status_ctx          = hashcat_ctx->status_ctx;
+  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  device_param->kernel_params_buf32[34] = num;
+
+  host_launch_t launch;
+
+  memset (&launch, 0, sizeof (launch));
+
+  launch.hash_type  = hashconfig->hash_type;
+  launch.dgst_words = hashconfig->dgst_size / 4;
+  launch.dgst_pos0  = hashconfig->dgst_pos0;
+  launch.dgst_pos1  = hashconfig->dgst_pos1;
+  launch.dgst_pos2  = hashconfig->dgst_pos2;
+  launch.dgst_pos3  = hashconfig->dgst_pos3;
+  launch.unicode    = (hashconfig->opts_type & OPTS_TYPE_PT_UNICODE) && (user_options->attack_mode != ATTACK_MODE_BF);
+  launch.big_endian = (hashconfig->hash_type == HASH_TYPE_SHA1) || (hashconfig->hash_type == HASH_TYPE_SHA256);
+  launch.pw_max     = hashconfig->pw_max;
+
+  // in BF mode the mask is already UTF-16LE expanded, see mp_css_unicode_expand ()
+
+  launch.pws_buf    = device_param->pws_buf;
+  launch.combs_buf  = device_param->combs_buf;
+  launch.pws_cnt    = num;
+  launch.il_cnt     = device_param->kernel_params_buf32[30];
+  launch.salt_pos   = device_param->kernel_params_buf32[27];
+
+  if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+  {
+    static const kernel_rule_t kernel_rule_noop = { { RULE_OP_MANGLE_NOOP } };
+
+    launch.amp_mode  = HOST_AMP_RULES;
+    launch.rules_buf = &kernel_rule_noop;
+    launch.rules_cnt = 1;
+
+    if ((device_param->host_rules == false) && (straight_ctx->kernel_rules_cnt > device_param->innerloop_pos))
+    {
+      launch.rules_buf = straight_ctx->kernel_rules_buf + device_param->innerloop_pos;
+      launch.rules_cnt = straight_ctx->kernel_rules_cnt - device_param->innerloop_pos;
+    }
+
+    // autotune asks for more loops than there are rules left
+
+    launch.il_cnt = MIN (launch.il_cnt, launch.rules_cnt);
+  }
+  else if (user_options->attack_mode == ATTACK_MODE_COMBI)
+  {
+    launch.amp_mode = (combinator_ctx->combs_mode == COMBINATOR_MODE_BASE_LEFT) ? HOST_AMP_APPEND : HOST_AMP_PREPEND;
+  }
+  else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+  {
+    launch.amp_mode = HOST_AMP_APPEND;
+  }
+  else
+  {
+    // BF is the r part from mp_r || the l part from mp_l, HYBRID2 is the mask || the base word
+
+    launch.amp_mode = HOST_AMP_PREPEND;
+  }
+
+  launch.il_cnt = MIN (launch.il_cnt, KERNEL_COMBS);
+
+  const compact_image_t *image = device_param->compact_image;
+
+  if (image == NULL)
+  {
+    launch.digests_buf = (const u32 *) hashes->digests_buf;
+
+    launch.bitmaps[0] = bitmap_ctx->bitmap_s1_a;
+    launch.bitmaps[1] = bitmap_ctx->bitmap_s1_b;
+    launch.bitmaps[2] = bitmap_ctx->bitmap_s1_c;
+    launch.bitmaps[3] = bitmap_ctx->bitmap_s1_d;
+    launch.bitmaps[4] = bitmap_ctx->bitmap_s2_a;
+    launch.bitmaps[5] = bitmap_ctx->bitmap_s2_b;
+    launch.bitmaps[6] = bitmap_ctx->bitmap_s2_c;
+    launch.bitmaps[7] = bitmap_ctx->bitmap_s2_d;
+  }
+  else
+  {
+    launch.digests_buf = (const u32 *) image->digests_buf;
+
+    for (u32 i = 0; i < 8; i++) launch.bitmaps[i] = image->bitmap_bufs + (bitmap_ctx->bitmap_nums * i);
+  }
+
+  launch.digests_cnt    = device_param->kernel_params_buf32[31];
+  launch.digests_offset = device_param->kernel_params_buf32[32];
+  launch.bitmap_mask    = device_param->kernel_params_buf32[24];
+  launch.bitmap_shift1  = device_param->kernel_params_buf32[25];
+  launch.bitmap_shift2  = device_param->kernel_params_buf32[26];
+
+  launch.digests_shown  = device_param->host_digests_shown;
+  launch.result         = &device_param->host_result;
+  launch.plains_buf     = device_param->host_plain_bufs;
+
+  hc_timer_t timer_exec;
+
+  hc_timer_set (&timer_exec);
+
+  const u64 work_cnt = (u64) launch.pws_cnt * launch.il_cnt;
+
+  if (work_cnt > 0)
+  {
+    // one worker per core, each takes a contiguous range of whole lane groups
+
+    const u64 groups_cnt = (work_cnt + HOST_LANES - 1) / HOST_LANES;
+
+    const u32 threads_cnt = (u32) MIN ((u64) device_param->host_threads, groups_cnt);
+
+    if (threads_cnt <= 1)
+    {
+      host_crack (&launch, 0, work_cnt);
+    }
+    else
+    {
+      hc_thread_t   *threads = (hc_thread_t *)   hccalloc (hashcat_ctx, threads_cnt, sizeof (hc_thread_t));   VERIFY_PTR (threads);
+      host_worker_t *workers = (host_worker_t *) hccalloc (hashcat_ctx, threads_cnt, sizeof (host_worker_t)); VERIFY_PTR (workers);
+
+      const u64 groups_per_thread = groups_cnt / threads_cnt;
+      const u64 groups_left       = groups_cnt % threads_cnt;
+
+      u64 pos = 0;
+
+      for (u32 thread_id = 0; thread_id < threads_cnt; thread_id++)
+      {
+        const u64 groups = groups_per_thread + ((thread_id < groups_left) ? 1 : 0);
+
+        host_worker_t *worker = &workers[thread_id];
+
+        worker->launch = &launch;
+        worker->pos    = pos;
+        worker->cnt    = MIN (groups * HOST_LANES, work_cnt - pos);
+
+        pos += worker->cnt;
+
+        hc_thread_create (threads[thread_id], thread_host_crack, worker);
+      }
+
+      hc_thread_wait (threads_cnt, threads);
+
+      hcfree (workers);
+      hcfree (threads);
+    }
+  }
+
+  const double exec_us = hc_timer_get (timer_exec) * 1000;
+
+  metrics_kernel_exec (hashcat_ctx, device_param, kern_run, exec_us);
+
+  trace_device (hashcat_ctx, device_param, kern_run, exec_us);
+
+  if (status_ctx->devices_status == STATUS_RUNNING)
+  {
+    if (iteration < EXPECTED_ITERATIONS)
+    {
+      switch (kern_run)
+      {
+        case KERN_RUN_1: device_param->exec_us_prev1[iteration] = exec_us; break;
+        case KERN_RUN_2: device_param->exec_us_prev2[iteration] = exec_us; break;
+        case KERN_RUN_3: device_param->exec_us_prev3[iteration] = exec_us; break;
+      }
+    }
+  }
+
+  if (event_update)
+  {
+    u32 exec_pos = device_param->exec_pos;
+
+    device_param->exec_msec[exec_pos] = exec_us / 1000;
+
+    exec_pos++;
+
+    if (exec_pos == EXEC_CACHE)
+    {
+      exec_pos = 0;
+    }
+
+    device_param->exec_pos = exec_pos;
+  }
+
+  return 0;
+}
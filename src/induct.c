@@ -39,6 +39,8 @@ int induct_ctx_init (hashcat_ctx_t *hashcat_ctx)
   if (user_options->usage       == true) return 0;
   if (user_options->version     == true) return 0;
 
+  if (user_options->kernel_warmup != NULL) return 0;
+
   if (user_options->attack_mode == ATTACK_MODE_BF)    return 0;
   if (user_options->attack_mode == ATTACK_MODE_COMBI) return 0;
 
@@ -41,6 +41,7 @@ static const char OPTI_STR_USES_BITS_8[]       = "Uses-8-Bit";
 static const char OPTI_STR_USES_BITS_16[]      = "Uses-16-Bit";
 static const char OPTI_STR_USES_BITS_32[]      = "Uses-32-Bit";
 static const char OPTI_STR_USES_BITS_64[]      = "Uses-64-Bit";
+static const char OPTI_STR_MULTI_SALT[]        = "Multi-Salt";
 
 static const char PA_000[] = "OK";
 static const char PA_001[] = "Ignored due to comment";
@@ -480,59 +481,65 @@ static void phpass_encode (u8 digest[16], u8 buf[22])
   buf[21] = int_to_itoa64 (l & 0x3f);
 }
 
-static void md5crypt_decode (u8 digest[16], u8 buf[22])
+static bool md5crypt_decode (u8 digest[16], u8 buf[22])
 {
+  u8 v[22];
+
+  if (itoa64_to_int_buf (buf, 22, v) == false) return false;
+
   int l;
 
-  l  = itoa64_to_int (buf[ 0]) <<  0;
-  l |= itoa64_to_int (buf[ 1]) <<  6;
-  l |= itoa64_to_int (buf[ 2]) << 12;
-  l |= itoa64_to_int (buf[ 3]) << 18;
+  l  = v[ 0] <<  0;
+  l |= v[ 1] <<  6;
+  l |= v[ 2] << 12;
+  l |= v[ 3] << 18;
 
   digest[ 0] = (l >> 16) & 0xff;
   digest[ 6] = (l >>  8) & 0xff;
   digest[12] = (l >>  0) & 0xff;
 
-  l  = itoa64_to_int (buf[ 4]) <<  0;
-  l |= itoa64_to_int (buf[ 5]) <<  6;
-  l |= itoa64_to_int (buf[ 6]) << 12;
-  l |= itoa64_to_int (buf[ 7]) << 18;
+  l  = v[ 4] <<  0;
+  l |= v[ 5] <<  6;
+  l |= v[ 6] << 12;
+  l |= v[ 7] << 18;
 
   digest[ 1] = (l >> 16) & 0xff;
   digest[ 7] = (l >>  8) & 0xff;
   digest[13] = (l >>  0) & 0xff;
 
-  l  = itoa64_to_int (buf[ 8]) <<  0;
-  l |= itoa64_to_int (buf[ 9]) <<  6;
-  l |= itoa64_to_int (buf[10]) << 12;
-  l |= itoa64_to_int (buf[11]) << 18;
+  l  = v[ 8] <<  0;
+  l |= v[ 9] <<  6;
+  l |= v[10] << 12;
+  l |= v[11] << 18;
 
   digest[ 2] = (l >> 16) & 0xff;
   digest[ 8] = (l >>  8) & 0xff;
   digest[14] = (l >>  0) & 0xff;
 
-  l  = itoa64_to_int (buf[12]) <<  0;
-  l |= itoa64_to_int (buf[13]) <<  6;
-  l |= itoa64_to_int (buf[14]) << 12;
-  l |= itoa64_to_int (buf[15]) << 18;
+  l  = v[12] <<  0;
+  l |= v[13] <<  6;
+  l |= v[14] << 12;
+  l |= v[15] << 18;
 
   digest[ 3] = (l >> 16) & 0xff;
   digest[ 9] = (l >>  8) & 0xff;
   digest[15] = (l >>  0) & 0xff;
 
-  l  = itoa64_to_int (buf[16]) <<  0;
-  l |= itoa64_to_int (buf[17]) <<  6;
-  l |= itoa64_to_int (buf[18]) << 12;
-  l |= itoa64_to_int (buf[19]) << 18;
+  l  = v[16] <<  0;
+  l |= v[17] <<  6;
+  l |= v[18] << 12;
+  l |= v[19] << 18;
 
   digest[ 4] = (l >> 16) & 0xff;
   digest[10] = (l >>  8) & 0xff;
   digest[ 5] = (l >>  0) & 0xff;
 
-  l  = itoa64_to_int (buf[20]) <<  0;
-  l |= itoa64_to_int (buf[21]) <<  6;
+  l  = v[20] <<  0;
+  l |= v[21] <<  6;
 
   digest[11] = (l >>  0) & 0xff;
+
+  return true;
 }
 
 static void md5crypt_encode (u8 digest[16], u8 buf[22])
@@ -2143,7 +2150,7 @@ int bcrypt_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_U
 
   u8 tmp_buf[100] = { 0 };
 
-  base64_decode (bf64_to_int, (const u8 *) salt_pos, 22, tmp_buf);
+  if (bf64_decode ((const u8 *) salt_pos, 22, tmp_buf) == -1) return (PARSER_SALT_VALUE);
 
   char *salt_buf_ptr = (char *) salt->salt_buf;
 
@@ -2158,7 +2165,7 @@ int bcrypt_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_U
 
   memset (tmp_buf, 0, sizeof (tmp_buf));
 
-  base64_decode (bf64_to_int, (const u8 *) hash_pos, 31, tmp_buf);
+  if (bf64_decode ((const u8 *) hash_pos, 31, tmp_buf) == -1) return (PARSER_HASH_VALUE);
 
   memcpy (digest, tmp_buf, 24);
 
@@ -2918,7 +2925,7 @@ int md5crypt_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE
 
   if (hash_len != 22) return (PARSER_HASH_LENGTH);
 
-  md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos);
+  if (md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos) == false) return (PARSER_HASH_VALUE);
 
   return (PARSER_OK);
 }
@@ -2973,7 +2980,7 @@ int md5apr1_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_
 
   hash_pos++;
 
-  md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos);
+  if (md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos) == false) return (PARSER_HASH_VALUE);
 
   return (PARSER_OK);
 }
@@ -3070,15 +3077,7 @@ int md4_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UNUS
 
   u32 *digest = (u32 *) hash_buf->digest;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-
-  digest[0] = byte_swap_32 (digest[0]);
-  digest[1] = byte_swap_32 (digest[1]);
-  digest[2] = byte_swap_32 (digest[2]);
-  digest[3] = byte_swap_32 (digest[3]);
+  if (hex_decode ((const u8 *) input_buf, 32, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
 
   digest[0] -= MD4M_A;
   digest[1] -= MD4M_B;
@@ -3103,15 +3102,7 @@ int md4s_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UNU
 
   salt_t *salt = hash_buf->salt;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-
-  digest[0] = byte_swap_32 (digest[0]);
-  digest[1] = byte_swap_32 (digest[1]);
-  digest[2] = byte_swap_32 (digest[2]);
-  digest[3] = byte_swap_32 (digest[3]);
+  if (hex_decode ((const u8 *) input_buf, 32, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
 
   digest[0] -= MD4M_A;
   digest[1] -= MD4M_B;
@@ -3141,15 +3132,7 @@ int md5_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UNUS
 
   u32 *digest = (u32 *) hash_buf->digest;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-
-  digest[0] = byte_swap_32 (digest[0]);
-  digest[1] = byte_swap_32 (digest[1]);
-  digest[2] = byte_swap_32 (digest[2]);
-  digest[3] = byte_swap_32 (digest[3]);
+  if (hex_decode ((const u8 *) input_buf, 32, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
 
   digest[0] -= MD5M_A;
   digest[1] -= MD5M_B;
@@ -3191,15 +3174,7 @@ int md5s_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UNU
 
   salt_t *salt = hash_buf->salt;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-
-  digest[0] = byte_swap_32 (digest[0]);
-  digest[1] = byte_swap_32 (digest[1]);
-  digest[2] = byte_swap_32 (digest[2]);
-  digest[3] = byte_swap_32 (digest[3]);
+  if (hex_decode ((const u8 *) input_buf, 32, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
 
   digest[0] -= MD5M_A;
   digest[1] -= MD5M_B;
@@ -4097,11 +4072,13 @@ int sha1_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UNU
 
   u32 *digest = (u32 *) hash_buf->digest;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-  digest[4] = hex_to_u32 ((const u8 *) &input_buf[32]);
+  if (hex_decode ((const u8 *) input_buf, 40, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_32 (digest[0]);
+  digest[1] = byte_swap_32 (digest[1]);
+  digest[2] = byte_swap_32 (digest[2]);
+  digest[3] = byte_swap_32 (digest[3]);
+  digest[4] = byte_swap_32 (digest[4]);
 
   digest[0] -= SHA1M_A;
   digest[1] -= SHA1M_B;
@@ -4146,11 +4123,13 @@ int sha1s_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_UN
 
   salt_t *salt = hash_buf->salt;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-  digest[4] = hex_to_u32 ((const u8 *) &input_buf[32]);
+  if (hex_decode ((const u8 *) input_buf, 40, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_32 (digest[0]);
+  digest[1] = byte_swap_32 (digest[1]);
+  digest[2] = byte_swap_32 (digest[2]);
+  digest[3] = byte_swap_32 (digest[3]);
+  digest[4] = byte_swap_32 (digest[4]);
 
   digest[0] -= SHA1M_A;
   digest[1] -= SHA1M_B;
@@ -4584,14 +4563,16 @@ int sha256_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_U
 
   u32 *digest = (u32 *) hash_buf->digest;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-  digest[4] = hex_to_u32 ((const u8 *) &input_buf[32]);
-  digest[5] = hex_to_u32 ((const u8 *) &input_buf[40]);
-  digest[6] = hex_to_u32 ((const u8 *) &input_buf[48]);
-  digest[7] = hex_to_u32 ((const u8 *) &input_buf[56]);
+  if (hex_decode ((const u8 *) input_buf, 64, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_32 (digest[0]);
+  digest[1] = byte_swap_32 (digest[1]);
+  digest[2] = byte_swap_32 (digest[2]);
+  digest[3] = byte_swap_32 (digest[3]);
+  digest[4] = byte_swap_32 (digest[4]);
+  digest[5] = byte_swap_32 (digest[5]);
+  digest[6] = byte_swap_32 (digest[6]);
+  digest[7] = byte_swap_32 (digest[7]);
 
   digest[0] -= SHA256M_A;
   digest[1] -= SHA256M_B;
@@ -4620,14 +4601,16 @@ int sha256s_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_
 
   salt_t *salt = hash_buf->salt;
 
-  digest[0] = hex_to_u32 ((const u8 *) &input_buf[ 0]);
-  digest[1] = hex_to_u32 ((const u8 *) &input_buf[ 8]);
-  digest[2] = hex_to_u32 ((const u8 *) &input_buf[16]);
-  digest[3] = hex_to_u32 ((const u8 *) &input_buf[24]);
-  digest[4] = hex_to_u32 ((const u8 *) &input_buf[32]);
-  digest[5] = hex_to_u32 ((const u8 *) &input_buf[40]);
-  digest[6] = hex_to_u32 ((const u8 *) &input_buf[48]);
-  digest[7] = hex_to_u32 ((const u8 *) &input_buf[56]);
+  if (hex_decode ((const u8 *) input_buf, 64, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_32 (digest[0]);
+  digest[1] = byte_swap_32 (digest[1]);
+  digest[2] = byte_swap_32 (digest[2]);
+  digest[3] = byte_swap_32 (digest[3]);
+  digest[4] = byte_swap_32 (digest[4]);
+  digest[5] = byte_swap_32 (digest[5]);
+  digest[6] = byte_swap_32 (digest[6]);
+  digest[7] = byte_swap_32 (digest[7]);
 
   digest[0] -= SHA256M_A;
   digest[1] -= SHA256M_B;
@@ -4688,14 +4671,16 @@ int sha512_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_U
 
   u64 *digest = (u64 *) hash_buf->digest;
 
-  digest[0] = hex_to_u64 ((const u8 *) &input_buf[  0]);
-  digest[1] = hex_to_u64 ((const u8 *) &input_buf[ 16]);
-  digest[2] = hex_to_u64 ((const u8 *) &input_buf[ 32]);
-  digest[3] = hex_to_u64 ((const u8 *) &input_buf[ 48]);
-  digest[4] = hex_to_u64 ((const u8 *) &input_buf[ 64]);
-  digest[5] = hex_to_u64 ((const u8 *) &input_buf[ 80]);
-  digest[6] = hex_to_u64 ((const u8 *) &input_buf[ 96]);
-  digest[7] = hex_to_u64 ((const u8 *) &input_buf[112]);
+  if (hex_decode ((const u8 *) input_buf, 128, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_64 (digest[0]);
+  digest[1] = byte_swap_64 (digest[1]);
+  digest[2] = byte_swap_64 (digest[2]);
+  digest[3] = byte_swap_64 (digest[3]);
+  digest[4] = byte_swap_64 (digest[4]);
+  digest[5] = byte_swap_64 (digest[5]);
+  digest[6] = byte_swap_64 (digest[6]);
+  digest[7] = byte_swap_64 (digest[7]);
 
   digest[0] -= SHA512M_A;
   digest[1] -= SHA512M_B;
@@ -4724,14 +4709,16 @@ int sha512s_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_
 
   salt_t *salt = hash_buf->salt;
 
-  digest[0] = hex_to_u64 ((const u8 *) &input_buf[  0]);
-  digest[1] = hex_to_u64 ((const u8 *) &input_buf[ 16]);
-  digest[2] = hex_to_u64 ((const u8 *) &input_buf[ 32]);
-  digest[3] = hex_to_u64 ((const u8 *) &input_buf[ 48]);
-  digest[4] = hex_to_u64 ((const u8 *) &input_buf[ 64]);
-  digest[5] = hex_to_u64 ((const u8 *) &input_buf[ 80]);
-  digest[6] = hex_to_u64 ((const u8 *) &input_buf[ 96]);
-  digest[7] = hex_to_u64 ((const u8 *) &input_buf[112]);
+  if (hex_decode ((const u8 *) input_buf, 128, (u8 *) digest) == false) return (PARSER_HASH_VALUE);
+
+  digest[0] = byte_swap_64 (digest[0]);
+  digest[1] = byte_swap_64 (digest[1]);
+  digest[2] = byte_swap_64 (digest[2]);
+  digest[3] = byte_swap_64 (digest[3]);
+  digest[4] = byte_swap_64 (digest[4]);
+  digest[5] = byte_swap_64 (digest[5]);
+  digest[6] = byte_swap_64 (digest[6]);
+  digest[7] = byte_swap_64 (digest[7]);
 
   digest[0] -= SHA512M_A;
   digest[1] -= SHA512M_B;
@@ -5350,7 +5337,7 @@ int md5aix_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_U
 
   hash_pos++;
 
-  md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos);
+  if (md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos) == false) return (PARSER_HASH_VALUE);
 
   return (PARSER_OK);
 }
@@ -7628,7 +7615,7 @@ int juniper_parse_hash (char *input_buf, u32 input_len, hash_t *hash_buf, MAYBE_
 
   hash_pos++;
 
-  md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos);
+  if (md5crypt_decode ((unsigned char *) digest, (unsigned char *) hash_pos) == false) return (PARSER_HASH_VALUE);
 
   return (PARSER_OK);
 }
@@ -12620,6 +12607,7 @@ char *stroptitype (const u32 opti_type)
     case OPTI_TYPE_USES_BITS_16:      return ((char *) OPTI_STR_USES_BITS_16);
     case OPTI_TYPE_USES_BITS_32:      return ((char *) OPTI_STR_USES_BITS_32);
     case OPTI_TYPE_USES_BITS_64:      return ((char *) OPTI_STR_USES_BITS_64);
+    case OPTI_TYPE_MULTI_SALT:        return ((char *) OPTI_STR_MULTI_SALT);
   }
 
   return (NULL);
@@ -12934,8 +12922,202 @@ void to_hccap_t (hashcat_ctx_t *hashcat_ctx, hccap_t *hccap, const u32 salt_pos,
   }
 }
 
+/**
+ * ascii_digest fast path, for modes which print nothing but the hex digest and an optional salt
+ * the encoders write into out_buf and return the length, see hashconfig->ascii_digest_func
+ */
+
+static u32 ascii_digest_salt (const hashconfig_t *hashconfig, const salt_t *salt, u8 *out_buf)
+{
+  if (hashconfig->salt_type != SALT_TYPE_INTERN) return 0;
+
+  const u32 opts_type = hashconfig->opts_type;
+
+  u32 salt_buf[16];
+
+  memcpy (salt_buf, salt->salt_buf, sizeof (salt_buf));
+
+  u8 *ptr = (u8 *) salt_buf;
+
+  u32 len = salt->salt_len;
+
+  if (opts_type & OPTS_TYPE_ST_UNICODE)
+  {
+    len = len / 2;
+
+    for (u32 i = 0, j = 0; i < len; i += 1, j += 2)
+    {
+      ptr[i] = ptr[j];
+    }
+  }
+
+  out_buf[0] = hashconfig->separator;
+
+  if (opts_type & OPTS_TYPE_ST_HEX)
+  {
+    hex_encode_lower (ptr, (int) len, out_buf + 1);
+
+    return 1 + (len * 2);
+  }
+
+  memcpy (out_buf + 1, ptr, len);
+
+  return 1 + len;
+}
+
+static int ascii_digest_hex32 (const hashconfig_t *hashconfig, const hashes_t *hashes, char *out_buf, const u32 salt_pos, const u32 digest_pos)
+{
+  const salt_t *salt = &hashes->salts_buf[salt_pos];
+
+  const u32 *digest = (const u32 *) ((const u8 *) hashes->digests_buf + ((salt->digests_offset + digest_pos) * hashconfig->dgst_size));
+
+  u32 digest_cnt = 0;
+
+  switch (hashconfig->hash_type)
+  {
+    case HASH_TYPE_MD4:       digest_cnt =  4; break;
+    case HASH_TYPE_MD5:       digest_cnt =  4; break;
+    case HASH_TYPE_SHA1:      digest_cnt =  5; break;
+    case HASH_TYPE_SHA256:    digest_cnt =  8; break;
+    case HASH_TYPE_RIPEMD160: digest_cnt =  5; break;
+    case HASH_TYPE_WHIRLPOOL: digest_cnt = 16; break;
+    case HASH_TYPE_GOST:      digest_cnt =  8; break;
+  }
+
+  u32 digest_buf[16];
+
+  for (u32 i = 0; i < digest_cnt; i++) digest_buf[i] = digest[i];
+
+  if (hashconfig->opti_type & OPTI_TYPE_PRECOMPUTE_MERKLE)
+  {
+    switch (hashconfig->hash_type)
+    {
+      case HASH_TYPE_MD4:
+        digest_buf[0] += MD4M_A;
+        digest_buf[1] += MD4M_B;
+        digest_buf[2] += MD4M_C;
+        digest_buf[3] += MD4M_D;
+        break;
+
+      case HASH_TYPE_MD5:
+        digest_buf[0] += MD5M_A;
+        digest_buf[1] += MD5M_B;
+        digest_buf[2] += MD5M_C;
+        digest_buf[3] += MD5M_D;
+        break;
+
+      case HASH_TYPE_SHA1:
+        digest_buf[0] += SHA1M_A;
+        digest_buf[1] += SHA1M_B;
+        digest_buf[2] += SHA1M_C;
+        digest_buf[3] += SHA1M_D;
+        digest_buf[4] += SHA1M_E;
+        break;
+
+      case HASH_TYPE_SHA256:
+        digest_buf[0] += SHA256M_A;
+        digest_buf[1] += SHA256M_B;
+        digest_buf[2] += SHA256M_C;
+        digest_buf[3] += SHA256M_D;
+        digest_buf[4] += SHA256M_E;
+        digest_buf[5] += SHA256M_F;
+        digest_buf[6] += SHA256M_G;
+        digest_buf[7] += SHA256M_H;
+        break;
+    }
+  }
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_GENERATE_LE)
+  {
+    for (u32 i = 0; i < digest_cnt; i++) digest_buf[i] = byte_swap_32 (digest_buf[i]);
+  }
+
+  u8 *out = (u8 *) out_buf;
+
+  for (u32 i = 0; i < digest_cnt; i++) bin_to_hex_lower (digest_buf[i], out + (i * 8));
+
+  u32 out_len = digest_cnt * 8;
+
+  out_len += ascii_digest_salt (hashconfig, salt, out + out_len);
+
+  out[out_len] = 0;
+
+  return (int) out_len;
+}
+
+static int ascii_digest_hex64 (const hashconfig_t *hashconfig, const hashes_t *hashes, char *out_buf, const u32 salt_pos, const u32 digest_pos)
+{
+  const salt_t *salt = &hashes->salts_buf[salt_pos];
+
+  const u64 *digest = (const u64 *) ((const u8 *) hashes->digests_buf + ((salt->digests_offset + digest_pos) * hashconfig->dgst_size));
+
+  u32 digest_cnt = 0;
+
+  switch (hashconfig->hash_type)
+  {
+    case HASH_TYPE_SHA384: digest_cnt = 6; break;
+    case HASH_TYPE_SHA512: digest_cnt = 8; break;
+  }
+
+  u64 digest_buf[8];
+
+  for (u32 i = 0; i < digest_cnt; i++) digest_buf[i] = digest[i];
+
+  if (hashconfig->opti_type & OPTI_TYPE_PRECOMPUTE_MERKLE)
+  {
+    switch (hashconfig->hash_type)
+    {
+      case HASH_TYPE_SHA384:
+        digest_buf[0] += SHA384M_A;
+        digest_buf[1] += SHA384M_B;
+        digest_buf[2] += SHA384M_C;
+        digest_buf[3] += SHA384M_D;
+        digest_buf[4] += SHA384M_E;
+        digest_buf[5] += SHA384M_F;
+        break;
+
+      case HASH_TYPE_SHA512:
+        digest_buf[0] += SHA512M_A;
+        digest_buf[1] += SHA512M_B;
+        digest_buf[2] += SHA512M_C;
+        digest_buf[3] += SHA512M_D;
+        digest_buf[4] += SHA512M_E;
+        digest_buf[5] += SHA512M_F;
+        digest_buf[6] += SHA512M_G;
+        digest_buf[7] += SHA512M_H;
+        break;
+    }
+  }
+
+  if (hashconfig->opts_type & OPTS_TYPE_PT_GENERATE_LE)
+  {
+    for (u32 i = 0; i < digest_cnt; i++) digest_buf[i] = byte_swap_64 (digest_buf[i]);
+  }
+
+  u8 *out = (u8 *) out_buf;
+
+  for (u32 i = 0; i < digest_cnt; i++)
+  {
+    bin_to_hex_lower ((u32) (digest_buf[i] >> 32), out + (i * 16) + 0);
+    bin_to_hex_lower ((u32) (digest_buf[i] >>  0), out + (i * 16) + 8);
+  }
+
+  u32 out_len = digest_cnt * 16;
+
+  out_len += ascii_digest_salt (hashconfig, salt, out + out_len);
+
+  out[out_len] = 0;
+
+  return (int) out_len;
+}
+
 int ascii_digest (hashcat_ctx_t *hashcat_ctx, char *out_buf, const u32 salt_pos, const u32 digest_pos)
 {
+  if (hashcat_ctx->hashconfig->ascii_digest_func)
+  {
+    return hashcat_ctx->hashconfig->ascii_digest_func (hashcat_ctx->hashconfig, hashcat_ctx->hashes, out_buf, salt_pos, digest_pos);
+  }
+
   const hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
   const hashes_t     *hashes     = hashcat_ctx->hashes;
 
@@ -15920,7 +16102,7 @@ int ascii_digest (hashcat_ctx_t *hashcat_ctx, char *out_buf, const u32 salt_pos,
     out_buf[pos + 1 + salt.salt_len] = 0;
   }
 
-  return 0;
+  return (int) strlen (out_buf);
 }
 
 int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
@@ -15988,7 +16170,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16011,7 +16194,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16034,7 +16218,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16056,7 +16241,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_PREPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16078,7 +16264,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_PREPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16100,7 +16287,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_PREPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16122,7 +16310,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_PREPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 0;
                  hashconfig->dgst_pos1      = 3;
                  hashconfig->dgst_pos2      = 2;
@@ -16269,7 +16458,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 3;
                  hashconfig->dgst_pos1      = 4;
                  hashconfig->dgst_pos2      = 2;
@@ -16291,7 +16481,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 3;
                  hashconfig->dgst_pos1      = 4;
                  hashconfig->dgst_pos2      = 2;
@@ -16314,7 +16505,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 3;
                  hashconfig->dgst_pos1      = 4;
                  hashconfig->dgst_pos2      = 2;
@@ -16797,7 +16989,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 3;
                  hashconfig->dgst_pos1      = 7;
                  hashconfig->dgst_pos2      = 2;
@@ -18759,7 +18952,8 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
                                             | OPTI_TYPE_EARLY_SKIP
                                             | OPTI_TYPE_NOT_ITERATED
                                             | OPTI_TYPE_APPENDED_SALT
-                                            | OPTI_TYPE_RAW_HASH;
+                                            | OPTI_TYPE_RAW_HASH
+                                            | OPTI_TYPE_MULTI_SALT;
                  hashconfig->dgst_pos0      = 3;
                  hashconfig->dgst_pos1      = 7;
                  hashconfig->dgst_pos2      = 2;
@@ -19773,6 +19967,56 @@ int hashconfig_init (hashcat_ctx_t *hashcat_ctx)
     case 13763: hashconfig->tmp_size = sizeof (tc_tmp_t);              break;
   };
 
+  // ascii_digest_func
+
+  hashconfig->ascii_digest_func = NULL;
+
+  switch (hashconfig->hash_mode)
+  {
+    case     0: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    10: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    11: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    12: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    20: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    21: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    30: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    40: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    50: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case    60: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   100: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   110: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   120: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   130: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   140: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   150: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   160: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case   900: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1000: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1100: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1400: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1410: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1420: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1430: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1440: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1450: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1460: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  1700: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1710: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1720: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1730: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1740: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1750: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  1760: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+    case  2600: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  4300: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  6000: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  6100: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case  6900: hashconfig->ascii_digest_func = ascii_digest_hex32; break;
+    case 10800: hashconfig->ascii_digest_func = ascii_digest_hex64; break;
+  }
+
+  if (hashconfig->opts_type & OPTS_TYPE_ST_GENERATE_LE) hashconfig->ascii_digest_func = NULL;
+
   // hook_size
 
   hashconfig->hook_size = 4;
@@ -404,7 +404,14 @@ static void main_outerloop_mainscreen (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx,
 
   if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
   {
-    event_log_info (hashcat_ctx, "Rules: %u", straight_ctx->kernel_rules_cnt);
+    if (straight_ctx->kernel_rules_folded)
+    {
+      event_log_info (hashcat_ctx, "Rules: %u (%u redundant rules folded)", straight_ctx->kernel_rules_cnt, straight_ctx->kernel_rules_folded);
+    }
+    else
+    {
+      event_log_info (hashcat_ctx, "Rules: %u", straight_ctx->kernel_rules_cnt);
+    }
   }
 
   if (user_options->quiet == false) event_log_info (hashcat_ctx, "");
@@ -629,6 +636,13 @@ static void main_monitor_status_refresh (MAYBE_UNUSED hashcat_ctx_t *hashcat_ctx
   const user_options_t       *user_options       = hashcat_ctx->user_options;
   const user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
 
+  if (user_options->status_json == true)
+  {
+    status_display_json (hashcat_ctx);
+
+    return;
+  }
+
   if ((user_options_extra->wordlist_mode == WL_MODE_FILE) || (user_options_extra->wordlist_mode == WL_MODE_MASK))
   {
     if (user_options->quiet == false)
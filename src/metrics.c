@@ -0,0 +1,377 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "hwmon.h"
+#include "status.h"
+#include "thread.h"
+#include "metrics.h"
+
+// upper bounds of the kernel histogram buckets in microseconds, the last bucket is +Inf
+
+static const u64 METRICS_BOUNDS[METRICS_BUCKETS - 1] = { 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000 };
+
+static const u32 METRICS_KERN_RUN[METRICS_KERN] = { KERN_RUN_1, KERN_RUN_12, KERN_RUN_2, KERN_RUN_23, KERN_RUN_3 };
+
+int metrics_init (hashcat_ctx_t *hashcat_ctx)
+{
+  metrics_ctx_t  *metrics_ctx  = hashcat_ctx->metrics_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  metrics_ctx->enabled = false;
+
+  if (user_options->keyspace     == true) return 0;
+  if (user_options->left         == true) return 0;
+  if (user_options->opencl_info  == true) return 0;
+  if (user_options->show         == true) return 0;
+  if (user_options->usage        == true) return 0;
+  if (user_options->version      == true) return 0;
+
+  if (user_options->metrics_file == NULL) return 0;
+
+  metrics_ctx->enabled      = true;
+  metrics_ctx->filename     = hcstrdup (hashcat_ctx, user_options->metrics_file);
+  metrics_ctx->filename_tmp = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_TINY); VERIFY_PTR (metrics_ctx->filename_tmp);
+
+  // write to a temporary file first and rename it, so a scraper never reads half a file
+
+  snprintf (metrics_ctx->filename_tmp, HCBUFSIZ_TINY - 1, "%s.tmp", metrics_ctx->filename);
+
+  return 0;
+}
+
+void metrics_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  hcfree (metrics_ctx->filename);
+  hcfree (metrics_ctx->filename_tmp);
+
+  memset (metrics_ctx, 0, sizeof (metrics_ctx_t));
+}
+
+static void metrics_hist_add (metrics_hist_t *hist, const u64 usec)
+{
+  u32 bucket = 0;
+
+  while ((bucket < METRICS_BUCKETS - 1) && (usec > METRICS_BOUNDS[bucket])) bucket++;
+
+  __sync_fetch_and_add (&hist->bucket[bucket], 1);
+  __sync_fetch_and_add (&hist->cnt,            1);
+  __sync_fetch_and_add (&hist->sum_usec,       usec);
+}
+
+void metrics_kernel_exec (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const double exec_us)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  for (u32 kern_pos = 0; kern_pos < METRICS_KERN; kern_pos++)
+  {
+    if (METRICS_KERN_RUN[kern_pos] != kern_run) continue;
+
+    metrics_hist_add (&device_param->metrics.kernel_exec[kern_pos], (u64) exec_us);
+
+    break;
+  }
+}
+
+void metrics_transfer (hashcat_ctx_t *hashcat_ctx, cl_command_queue command_queue, const bool h2d, const size_t bytes, const double exec_msec)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+  opencl_ctx_t  *opencl_ctx  = hashcat_ctx->opencl_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  // the transfer wrappers only know the queue, each device has exactly one
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->command_queue != command_queue) continue;
+
+    metrics_dev_t *metrics = &device_param->metrics;
+
+    const u64 usec = (u64) (exec_msec * 1000);
+
+    if (h2d == true)
+    {
+      __sync_fetch_and_add (&metrics->h2d_cnt,   1);
+      __sync_fetch_and_add (&metrics->h2d_bytes, bytes);
+      __sync_fetch_and_add (&metrics->h2d_usec,  usec);
+    }
+    else
+    {
+      __sync_fetch_and_add (&metrics->d2h_cnt,   1);
+      __sync_fetch_and_add (&metrics->d2h_bytes, bytes);
+      __sync_fetch_and_add (&metrics->d2h_usec,  usec);
+    }
+
+    break;
+  }
+}
+
+void metrics_batch (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 pws_cnt, const double host_wait_msec, const u64 words_bytes)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  metrics_dev_t *metrics = &device_param->metrics;
+
+  __sync_fetch_and_add (&metrics->batches,        1);
+  __sync_fetch_and_add (&metrics->host_wait_usec, (u64) (host_wait_msec * 1000));
+  __sync_fetch_and_add (&metrics->words_bytes,    words_bytes);
+
+  metrics->batch_size = pws_cnt;
+}
+
+void metrics_cracked (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 cracked)
+{
+  metrics_ctx_t *metrics_ctx = hashcat_ctx->metrics_ctx;
+
+  if (metrics_ctx->enabled == false) return;
+
+  __sync_fetch_and_add (&device_param->metrics.cracked, cracked);
+}
+
+static void metrics_header (FILE *fp, const char *name, const char *type, const char *help)
+{
+  fprintf (fp, "# HELP %s %s\n", name, help);
+  fprintf (fp, "# TYPE %s %s\n", name, type);
+}
+
+static void metrics_write_dev_u64 (FILE *fp, const opencl_ctx_t *opencl_ctx, const char *name, const char *label, const size_t offset)
+{
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    const u64 val = *(const u64 *) ((const u8 *) &device_param->metrics + offset);
+
+    fprintf (fp, "%s{device=\"%u\"%s} %" PRIu64 "\n", name, device_id + 1, label, val);
+  }
+}
+
+static void metrics_write_dev_sec (FILE *fp, const opencl_ctx_t *opencl_ctx, const char *name, const char *label, const size_t offset)
+{
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    const u64 val = *(const u64 *) ((const u8 *) &device_param->metrics + offset);
+
+    fprintf (fp, "%s{device=\"%u\"%s} %.6f\n", name, device_id + 1, label, (double) val / 1000000);
+  }
+}
+
+static void metrics_write_kernel_exec (FILE *fp, const opencl_ctx_t *opencl_ctx)
+{
+  metrics_header (fp, "hashcat_kernel_exec_seconds", "histogram", "Kernel execution time from OpenCL profiling, per KERN_RUN_* step");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    for (u32 kern_pos = 0; kern_pos < METRICS_KERN; kern_pos++)
+    {
+      const metrics_hist_t *hist = &device_param->metrics.kernel_exec[kern_pos];
+
+      if (hist->cnt == 0) continue;
+
+      const u32 kern_run = METRICS_KERN_RUN[kern_pos];
+
+      u64 cumulative = 0;
+
+      for (u32 bucket = 0; bucket < METRICS_BUCKETS - 1; bucket++)
+      {
+        cumulative += hist->bucket[bucket];
+
+        fprintf (fp, "hashcat_kernel_exec_seconds_bucket{device=\"%u\",kernel=\"%u\",le=\"%g\"} %" PRIu64 "\n", device_id + 1, kern_run, (double) METRICS_BOUNDS[bucket] / 1000000, cumulative);
+      }
+
+      fprintf (fp, "hashcat_kernel_exec_seconds_bucket{device=\"%u\",kernel=\"%u\",le=\"+Inf\"} %" PRIu64 "\n", device_id + 1, kern_run, hist->cnt);
+      fprintf (fp, "hashcat_kernel_exec_seconds_sum{device=\"%u\",kernel=\"%u\"} %.6f\n",         device_id + 1, kern_run, (double) hist->sum_usec / 1000000);
+      fprintf (fp, "hashcat_kernel_exec_seconds_count{device=\"%u\",kernel=\"%u\"} %" PRIu64 "\n", device_id + 1, kern_run, hist->cnt);
+    }
+  }
+}
+
+static void metrics_write_hwmon (FILE *fp, hashcat_ctx_t *hashcat_ctx)
+{
+  const hwmon_ctx_t  *hwmon_ctx  = hashcat_ctx->hwmon_ctx;
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+  status_ctx_t       *status_ctx = hashcat_ctx->status_ctx;
+
+  if (hwmon_ctx->enabled == false) return;
+
+  int temperature[DEVICES_MAX];
+  int utilization[DEVICES_MAX];
+
+  hc_thread_mutex_lock (status_ctx->mux_hwmon);
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    temperature[device_id] = -1;
+    utilization[device_id] = -1;
+
+    if (device_param->skipped) continue;
+
+    temperature[device_id] = hm_get_temperature_with_device_id (hashcat_ctx, device_id);
+    utilization[device_id] = hm_get_utilization_with_device_id (hashcat_ctx, device_id);
+  }
+
+  hc_thread_mutex_unlock (status_ctx->mux_hwmon);
+
+  metrics_header (fp, "hashcat_device_temperature_celsius", "gauge", "Device temperature");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    if (temperature[device_id] < 0) continue;
+
+    fprintf (fp, "hashcat_device_temperature_celsius{device=\"%u\"} %d\n", device_id + 1, temperature[device_id]);
+  }
+
+  metrics_header (fp, "hashcat_device_utilization_percent", "gauge", "Device utilization");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    if (utilization[device_id] < 0) continue;
+
+    fprintf (fp, "hashcat_device_utilization_percent{device=\"%u\"} %d\n", device_id + 1, utilization[device_id]);
+  }
+}
+
+int metrics_write (hashcat_ctx_t *hashcat_ctx)
+{
+  const dedup_ctx_t  *dedup_ctx   = hashcat_ctx->dedup_ctx;
+  metrics_ctx_t      *metrics_ctx = hashcat_ctx->metrics_ctx;
+  const opencl_ctx_t *opencl_ctx  = hashcat_ctx->opencl_ctx;
+  const status_ctx_t *status_ctx  = hashcat_ctx->status_ctx;
+
+  if (metrics_ctx->enabled == false) return 0;
+
+  FILE *fp = fopen (metrics_ctx->filename_tmp, "wb");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", metrics_ctx->filename_tmp, strerror (errno));
+
+    return -1;
+  }
+
+  // per device counters
+
+  metrics_write_kernel_exec (fp, opencl_ctx);
+
+  metrics_header (fp, "hashcat_transfers_total", "counter", "Host/device buffer transfers");
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_transfers_total", ",direction=\"h2d\"", offsetof (metrics_dev_t, h2d_cnt));
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_transfers_total", ",direction=\"d2h\"", offsetof (metrics_dev_t, d2h_cnt));
+
+  metrics_header (fp, "hashcat_transfer_bytes_total", "counter", "Bytes moved by host/device buffer transfers");
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_transfer_bytes_total", ",direction=\"h2d\"", offsetof (metrics_dev_t, h2d_bytes));
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_transfer_bytes_total", ",direction=\"d2h\"", offsetof (metrics_dev_t, d2h_bytes));
+
+  metrics_header (fp, "hashcat_transfer_seconds_total", "counter", "Host time spent in host/device buffer transfers");
+  metrics_write_dev_sec (fp, opencl_ctx, "hashcat_transfer_seconds_total", ",direction=\"h2d\"", offsetof (metrics_dev_t, h2d_usec));
+  metrics_write_dev_sec (fp, opencl_ctx, "hashcat_transfer_seconds_total", ",direction=\"d2h\"", offsetof (metrics_dev_t, d2h_usec));
+
+  metrics_header (fp, "hashcat_batches_total", "counter", "Batches of candidates sent to the device");
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_batches_total", "", offsetof (metrics_dev_t, batches));
+
+  metrics_header (fp, "hashcat_host_wait_seconds_total", "counter", "Time the device waited for the host to prepare the next batch");
+  metrics_write_dev_sec (fp, opencl_ctx, "hashcat_host_wait_seconds_total", "", offsetof (metrics_dev_t, host_wait_usec));
+
+  metrics_header (fp, "hashcat_words_bytes_total", "counter", "Bytes of base words read from the wordlist or stdin");
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_words_bytes_total", "", offsetof (metrics_dev_t, words_bytes));
+
+  metrics_header (fp, "hashcat_cracked_total", "counter", "Hashes cracked");
+  metrics_write_dev_u64 (fp, opencl_ctx, "hashcat_cracked_total", "", offsetof (metrics_dev_t, cracked));
+
+  // per device gauges
+
+  metrics_header (fp, "hashcat_batch_size", "gauge", "Candidates in the last batch");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    fprintf (fp, "hashcat_batch_size{device=\"%u\"} %u\n", device_id + 1, device_param->metrics.batch_size);
+  }
+
+  metrics_header (fp, "hashcat_kernel_power", "gauge", "Candidates a full batch can hold");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    fprintf (fp, "hashcat_kernel_power{device=\"%u\"} %u\n", device_id + 1, device_param->kernel_power);
+  }
+
+  metrics_header (fp, "hashcat_speed_hashes_per_second", "gauge", "Current speed");
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    fprintf (fp, "hashcat_speed_hashes_per_second{device=\"%u\"} %.0f\n", device_id + 1, status_get_hashes_msec_dev (hashcat_ctx, device_id) * 1000);
+  }
+
+  metrics_write_hwmon (fp, hashcat_ctx);
+
+  // session
+
+  metrics_header (fp, "hashcat_progress", "gauge", "Keyspace progress in hashes");
+
+  fprintf (fp, "hashcat_progress{state=\"done\"} %" PRIu64 "\n",     status_get_progress_done     (hashcat_ctx));
+  fprintf (fp, "hashcat_progress{state=\"rejected\"} %" PRIu64 "\n", status_get_progress_rejected (hashcat_ctx));
+  fprintf (fp, "hashcat_progress{state=\"restored\"} %" PRIu64 "\n", status_get_progress_restored (hashcat_ctx));
+  fprintf (fp, "hashcat_progress{state=\"end\"} %" PRIu64 "\n",      status_get_progress_end      (hashcat_ctx));
+
+  metrics_header (fp, "hashcat_words_queued", "gauge", "Base words not yet handed out to a device");
+
+  fprintf (fp, "hashcat_words_queued %" PRIu64 "\n", (status_ctx->words_base > status_ctx->words_off) ? status_ctx->words_base - status_ctx->words_off : 0);
+
+  metrics_header (fp, "hashcat_digests", "gauge", "Digests in the hashlist");
+
+  fprintf (fp, "hashcat_digests{state=\"done\"} %d\n",  status_get_digests_done (hashcat_ctx));
+  fprintf (fp, "hashcat_digests{state=\"total\"} %d\n", status_get_digests_cnt  (hashcat_ctx));
+
+  metrics_header (fp, "hashcat_dedup_skipped_total", "counter", "Base words skipped by --dedup-candidates");
+
+  fprintf (fp, "hashcat_dedup_skipped_total %" PRIu64 "\n", dedup_ctx->skipped);
+
+  fclose (fp);
+
+  if (rename (metrics_ctx->filename_tmp, metrics_ctx->filename) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", metrics_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  return 0;
+}
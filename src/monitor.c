@@ -12,6 +12,8 @@
 #include "hashes.h"
 #include "thread.h"
 #include "restore.h"
+#include "metrics.h"
+#include "compact.h"
 #include "shared.h"
 #include "monitor.h"
 
@@ -44,8 +46,10 @@ int get_runtime_left (const hashcat_ctx_t *hashcat_ctx)
 
 static int monitor (hashcat_ctx_t *hashcat_ctx)
 {
+  compact_ctx_t  *compact_ctx   = hashcat_ctx->compact_ctx;
   hashes_t       *hashes        = hashcat_ctx->hashes;
   hwmon_ctx_t    *hwmon_ctx     = hashcat_ctx->hwmon_ctx;
+  metrics_ctx_t  *metrics_ctx   = hashcat_ctx->metrics_ctx;
   opencl_ctx_t   *opencl_ctx    = hashcat_ctx->opencl_ctx;
   restore_ctx_t  *restore_ctx   = hashcat_ctx->restore_ctx;
   status_ctx_t   *status_ctx    = hashcat_ctx->status_ctx;
@@ -56,6 +60,8 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
   bool status_check  = false;
   bool restore_check = false;
   bool hwmon_check   = false;
+  bool metrics_check = false;
+  bool compact_check = false;
 
   const int sleep_time        = 1;
   const int temp_threshold    = 1;  // degrees celcius
@@ -87,7 +93,17 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
     hwmon_check = true;
   }
 
-  if ((runtime_check == false) && (remove_check == false) && (status_check == false) && (restore_check == false) && (hwmon_check == false))
+  if (metrics_ctx->enabled == true)
+  {
+    metrics_check = true;
+  }
+
+  if (compact_ctx->enabled == true)
+  {
+    compact_check = true;
+  }
+
+  if ((runtime_check == false) && (remove_check == false) && (status_check == false) && (restore_check == false) && (hwmon_check == false) && (metrics_check == false) && (compact_check == false))
   {
     return 0;
   }
@@ -113,7 +129,16 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
 
   while (status_ctx->shutdown_inner == false)
   {
-    hc_sleep (sleep_time);
+    // sleep in slices, a finished job should not wait up to a second for the monitor to notice
+
+    for (int slice = 0; slice < sleep_time * 100; slice++)
+    {
+      if (status_ctx->shutdown_inner == true) break;
+
+      hc_sleep_msec (10);
+    }
+
+    if (status_ctx->shutdown_inner == true) break;
 
     if (status_ctx->devices_status == STATUS_INIT) continue;
 
@@ -300,15 +325,38 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
 
       if (status_left == 0)
       {
-        hc_thread_mutex_lock (status_ctx->mux_display);
+        if (user_options->status_json == true)
+        {
+          // the snapshot takes mux_display itself, only for copying the cracked counters
 
-        EVENT_DATA (EVENT_MONITOR_STATUS_REFRESH, NULL, 0);
+          EVENT_DATA (EVENT_MONITOR_STATUS_REFRESH, NULL, 0);
+        }
+        else
+        {
+          hc_thread_mutex_lock (status_ctx->mux_display);
 
-        hc_thread_mutex_unlock (status_ctx->mux_display);
+          EVENT_DATA (EVENT_MONITOR_STATUS_REFRESH, NULL, 0);
+
+          hc_thread_mutex_unlock (status_ctx->mux_display);
+        }
 
         status_left = user_options->status_timer;
       }
     }
+
+    if (metrics_check == true)
+    {
+      // a failed export should not stop the attack, the error is reported and the exporter is turned off
+
+      if (metrics_write (hashcat_ctx) == -1) metrics_check = false;
+    }
+
+    if (compact_check == true)
+    {
+      // same as above, without compaction the devices just keep working on the full hashlist
+
+      if (compact_update (hashcat_ctx) == -1) compact_check = false;
+    }
   }
 
   // final round of save_hash
@@ -323,6 +371,13 @@ static int monitor (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  // final round of metrics_write
+
+  if (metrics_check == true)
+  {
+    metrics_write (hashcat_ctx);
+  }
+
   // final round of cycle_restore
 
   if (restore_check == true)
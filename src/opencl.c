@@ -14,6 +14,7 @@
 #include "mpsp.h"
 #include "straight.h"
 #include "combinator.h"
+#include "compact.h"
 #include "convert.h"
 #include "stdout.h"
 #include "filehandling.h"
@@ -21,6 +22,10 @@
 #include "wordlist.h"
 #include "shared.h"
 #include "hashes.h"
+#include "status.h"
+#include "metrics.h"
+#include "trace.h"
+#include "host_backend.h"
 #include "cpu_md5.h"
 #include "event.h"
 #include "dynloader.h"
@@ -46,20 +51,20 @@ static void generate_source_kernel_filename (const u32 attack_exec, const u32 at
     snprintf (source_file, 255, "%s/OpenCL/m%05d.cl", shared_dir, (int) kern_type);
 }
 
-static void generate_cached_kernel_filename (const u32 attack_exec, const u32 attack_kern, const u32 kern_type, char *profile_dir, const char *device_name_chksum, char *cached_file)
+static void generate_cached_kernel_filename (const u32 attack_exec, const u32 attack_kern, const u32 kern_type, char *profile_dir, const char *device_name_chksum, const char *kernel_key, char *cached_file)
 {
   if (attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
   {
     if (attack_kern == ATTACK_KERN_STRAIGHT)
-      snprintf (cached_file, 255, "%s/kernels/m%05d_a0.%s.kernel", profile_dir, (int) kern_type, device_name_chksum);
+      snprintf (cached_file, 255, "%s/kernels/m%05d_a0.%s.%s.kernel", profile_dir, (int) kern_type, device_name_chksum, kernel_key);
     else if (attack_kern == ATTACK_KERN_COMBI)
-      snprintf (cached_file, 255, "%s/kernels/m%05d_a1.%s.kernel", profile_dir, (int) kern_type, device_name_chksum);
+      snprintf (cached_file, 255, "%s/kernels/m%05d_a1.%s.%s.kernel", profile_dir, (int) kern_type, device_name_chksum, kernel_key);
     else if (attack_kern == ATTACK_KERN_BF)
-      snprintf (cached_file, 255, "%s/kernels/m%05d_a3.%s.kernel", profile_dir, (int) kern_type, device_name_chksum);
+      snprintf (cached_file, 255, "%s/kernels/m%05d_a3.%s.%s.kernel", profile_dir, (int) kern_type, device_name_chksum, kernel_key);
   }
   else
   {
-    snprintf (cached_file, 255, "%s/kernels/m%05d.%s.kernel", profile_dir, (int) kern_type, device_name_chksum);
+    snprintf (cached_file, 255, "%s/kernels/m%05d.%s.%s.kernel", profile_dir, (int) kern_type, device_name_chksum, kernel_key);
   }
 }
 
@@ -75,15 +80,15 @@ static void generate_source_kernel_mp_filename (const u32 opti_type, const u32 o
   }
 }
 
-static void generate_cached_kernel_mp_filename (const u32 opti_type, const u32 opts_type, char *profile_dir, const char *device_name_chksum, char *cached_file)
+static void generate_cached_kernel_mp_filename (const u32 opti_type, const u32 opts_type, char *profile_dir, const char *device_name_chksum, const char *kernel_key, char *cached_file)
 {
   if ((opti_type & OPTI_TYPE_BRUTE_FORCE) && (opts_type & OPTS_TYPE_PT_GENERATE_BE))
   {
-    snprintf (cached_file, 255, "%s/kernels/markov_be.%s.kernel", profile_dir, device_name_chksum);
+    snprintf (cached_file, 255, "%s/kernels/markov_be.%s.%s.kernel", profile_dir, device_name_chksum, kernel_key);
   }
   else
   {
-    snprintf (cached_file, 255, "%s/kernels/markov_le.%s.kernel", profile_dir, device_name_chksum);
+    snprintf (cached_file, 255, "%s/kernels/markov_le.%s.%s.kernel", profile_dir, device_name_chksum, kernel_key);
   }
 }
 
@@ -92,9 +97,50 @@ static void generate_source_kernel_amp_filename (const u32 attack_kern, char *sh
   snprintf (source_file, 255, "%s/OpenCL/amp_a%d.cl", shared_dir, attack_kern);
 }
 
-static void generate_cached_kernel_amp_filename (const u32 attack_kern, char *profile_dir, const char *device_name_chksum, char *cached_file)
+static void generate_cached_kernel_amp_filename (const u32 attack_kern, char *profile_dir, const char *device_name_chksum, const char *kernel_key, char *cached_file)
 {
-  snprintf (cached_file, 255, "%s/kernels/amp_a%d.%s.kernel", profile_dir, attack_kern, device_name_chksum);
+  snprintf (cached_file, 255, "%s/kernels/amp_a%d.%s.%s.kernel", profile_dir, attack_kern, device_name_chksum, kernel_key);
+}
+
+static void generate_build_opts (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, char *build_opts, const size_t build_opts_size)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+
+  char include_opts[256] = { 0 };
+
+  #if defined (_WIN)
+  snprintf (include_opts, sizeof (include_opts) - 1, "-I \"%s\"", folder_config->cpath_real);
+  #else
+  snprintf (include_opts, sizeof (include_opts) - 1, "-I %s", folder_config->cpath_real);
+  #endif
+
+  // we don't have sm_* on vendors not NV but it doesn't matter
+
+  #if defined (DEBUG)
+  snprintf (build_opts, build_opts_size - 1, "%s -D VENDOR_ID=%u -D CUDA_ARCH=%d -D VECT_SIZE=%u -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D _unroll -cl-std=CL1.1", include_opts, device_param->device_vendor_id, (device_param->sm_major * 100) + device_param->sm_minor, device_param->vector_width, (u32) device_param->device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, hashconfig->kern_type);
+  #else
+  snprintf (build_opts, build_opts_size - 1, "%s -D VENDOR_ID=%u -D CUDA_ARCH=%d -D VECT_SIZE=%u -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D _unroll -cl-std=CL1.1 -w", include_opts, device_param->device_vendor_id, (device_param->sm_major * 100) + device_param->sm_minor, device_param->vector_width, (u32) device_param->device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, hashconfig->kern_type);
+  #endif
+}
+
+static void generate_kernel_group_build_opts (const opencl_ctx_t *opencl_ctx, const hc_device_param_t *device_param, const u32 group_pos, const char *build_opts, char *build_opts_update, const size_t build_opts_update_size)
+{
+  const kernel_group_t        *kernel_group        = &opencl_ctx->kernel_groups[group_pos];
+  const device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
+  if ((opencl_ctx->force_jit_compilation == 1500) && (kernel_group->specialized == true))
+  {
+    snprintf (build_opts_update, build_opts_update_size - 1, "%s -DDESCRYPT_SALT=%u", build_opts, kernel_group->descrypt_salt);
+  }
+  else if (opencl_ctx->force_jit_compilation == 8900)
+  {
+    snprintf (build_opts_update, build_opts_update_size - 1, "%s -DSCRYPT_N=%u -DSCRYPT_R=%u -DSCRYPT_P=%u -DSCRYPT_TMTO=%u -DSCRYPT_TMP_ELEM=%u", build_opts, kernel_group->scrypt_N, kernel_group->scrypt_r, kernel_group->scrypt_p, 1u << device_kernel_group->scrypt_tmto, device_kernel_group->scrypt_tmp_size / 16);
+  }
+  else
+  {
+    snprintf (build_opts_update, build_opts_update_size - 1, "%s", build_opts);
+  }
 }
 
 static int setup_opencl_platforms_filter (hashcat_ctx_t *hashcat_ctx, const char *opencl_platforms, u32 *out)
@@ -282,6 +328,85 @@ static int write_kernel_binary (hashcat_ctx_t *hashcat_ctx, char *kernel_file, c
   return 0;
 }
 
+static u64 kernel_cache_hash (const u8 *buf, const size_t len, u64 hash)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= buf[i];
+    hash *= 0x100000001b3;
+  }
+
+  return hash;
+}
+
+static int kernel_cache_hash_file (hashcat_ctx_t *hashcat_ctx, const char *include_dir, const char *kernel_file, const u32 depth, u64 *hash)
+{
+  size_t kernel_length = 0;
+  char  *kernel_source = NULL;
+
+  const int rc_read_kernel = read_kernel_binary (hashcat_ctx, kernel_file, 1, &kernel_length, &kernel_source);
+
+  if (rc_read_kernel == -1) return -1;
+
+  *hash = kernel_cache_hash ((const u8 *) kernel_source, kernel_length, *hash);
+
+  // follow the #include "..." lines, otherwise an edited inc_*.cl would keep the stale binary
+
+  if (depth < 4)
+  {
+    char *next = kernel_source;
+
+    while ((next = strstr (next, "#include \"")) != NULL)
+    {
+      char *name = next + 10;
+
+      char *name_end = strchr (name, '"');
+
+      if (name_end == NULL) break;
+
+      *name_end = 0;
+
+      char include_file[256] = { 0 };
+
+      snprintf (include_file, sizeof (include_file) - 1, "%s/%s", include_dir, name);
+
+      const int rc_include = kernel_cache_hash_file (hashcat_ctx, include_dir, include_file, depth + 1, hash);
+
+      if (rc_include == -1)
+      {
+        hcfree (kernel_source);
+
+        return -1;
+      }
+
+      next = name_end + 1;
+    }
+  }
+
+  hcfree (kernel_source);
+
+  return 0;
+}
+
+static int generate_kernel_cache_key (hashcat_ctx_t *hashcat_ctx, const char *source_file, const char *build_opts, char *kernel_key)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+
+  // the device and driver are already part of device_name_chksum
+
+  u64 hash = 0xcbf29ce484222325;
+
+  const int rc_hash = kernel_cache_hash_file (hashcat_ctx, folder_config->cpath_real, source_file, 0, &hash);
+
+  if (rc_hash == -1) return -1;
+
+  hash = kernel_cache_hash ((const u8 *) build_opts, strlen (build_opts), hash);
+
+  snprintf (kernel_key, 17, "%08x%08x", (u32) (hash >> 32), (u32) hash);
+
+  return 0;
+}
+
 int ocl_init (hashcat_ctx_t *hashcat_ctx)
 {
   opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
@@ -315,6 +440,8 @@ int ocl_init (hashcat_ctx_t *hashcat_ctx)
     event_log_error (hashcat_ctx, "* NVidia users require NVidia drivers 346.59 or later (recommended 367.27 or later)");
     event_log_error (hashcat_ctx, "");
     #endif
+    event_log_error (hashcat_ctx, "For MD5, SHA1, SHA256 and NTLM you can use --backend-host instead");
+    event_log_error (hashcat_ctx, "");
 
     return -1;
   }
@@ -466,6 +593,10 @@ int hc_clEnqueueWriteBuffer (hashcat_ctx_t *hashcat_ctx, cl_command_queue comman
 
   OCL_PTR *ocl = opencl_ctx->ocl;
 
+  hc_timer_t timer_transfer;
+
+  hc_timer_set (&timer_transfer);
+
   const cl_int CL_err = ocl->clEnqueueWriteBuffer (command_queue, buffer, blocking_write, offset, cb, ptr, num_events_in_wait_list, event_wait_list, event);
 
   if (CL_err != CL_SUCCESS)
@@ -475,6 +606,8 @@ int hc_clEnqueueWriteBuffer (hashcat_ctx_t *hashcat_ctx, cl_command_queue comman
     return -1;
   }
 
+  metrics_transfer (hashcat_ctx, command_queue, true, cb, hc_timer_get (timer_transfer));
+
   return 0;
 }
 
@@ -502,6 +635,10 @@ int hc_clEnqueueReadBuffer (hashcat_ctx_t *hashcat_ctx, cl_command_queue command
 
   OCL_PTR *ocl = opencl_ctx->ocl;
 
+  hc_timer_t timer_transfer;
+
+  hc_timer_set (&timer_transfer);
+
   const cl_int CL_err = ocl->clEnqueueReadBuffer (command_queue, buffer, blocking_read, offset, cb, ptr, num_events_in_wait_list, event_wait_list, event);
 
   if (CL_err != CL_SUCCESS)
@@ -511,6 +648,8 @@ int hc_clEnqueueReadBuffer (hashcat_ctx_t *hashcat_ctx, cl_command_queue command
     return -1;
   }
 
+  metrics_transfer (hashcat_ctx, command_queue, false, cb, hc_timer_get (timer_transfer));
+
   return 0;
 }
 
@@ -962,6 +1101,13 @@ int hc_clReleaseEvent (hashcat_ctx_t *hashcat_ctx, cl_event event)
 
 int gidd_to_pw_t (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 gidd, pw_t *pw)
 {
+  if (device_param->is_host == true)
+  {
+    *pw = device_param->pws_buf[gidd];
+
+    return 0;
+  }
+
   int CL_rc = hc_clEnqueueReadBuffer (hashcat_ctx, device_param->command_queue, device_param->d_pws_buf, CL_TRUE, gidd * sizeof (pw_t), sizeof (pw_t), pw, 0, NULL, NULL);
 
   if (CL_rc == -1) return -1;
@@ -1120,9 +1266,17 @@ int choose_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num, const u32 event_update, const u32 iteration)
 {
   hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  opencl_ctx_t   *opencl_ctx   = hashcat_ctx->opencl_ctx;
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
 
+  if (device_param->is_host == true)
+  {
+    return host_backend_run (hashcat_ctx, device_param, kern_run, num, event_update, iteration);
+  }
+
+  const u64 ts_enqueue = trace_now (hashcat_ctx);
+
   u32 num_elements = num;
 
   device_param->kernel_params_buf32[34] = num;
@@ -1131,15 +1285,21 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
   while (num_elements % kernel_threads) num_elements++;
 
+  // the salt decides which build to use, see kernel_groups_init ()
+
+  const u32 group_pos = opencl_ctx->salts_kernel_group[device_param->kernel_params_buf32[27]];
+
+  const device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
   cl_kernel kernel = NULL;
 
   switch (kern_run)
   {
-    case KERN_RUN_1:    kernel = device_param->kernel1;     break;
-    case KERN_RUN_12:   kernel = device_param->kernel12;    break;
-    case KERN_RUN_2:    kernel = device_param->kernel2;     break;
-    case KERN_RUN_23:   kernel = device_param->kernel23;    break;
-    case KERN_RUN_3:    kernel = device_param->kernel3;     break;
+    case KERN_RUN_1:    kernel = device_kernel_group->kernel1;     break;
+    case KERN_RUN_12:   kernel = device_kernel_group->kernel12;    break;
+    case KERN_RUN_2:    kernel = device_kernel_group->kernel2;     break;
+    case KERN_RUN_23:   kernel = device_kernel_group->kernel23;    break;
+    case KERN_RUN_3:    kernel = device_kernel_group->kernel3;     break;
   }
 
   int CL_rc;
@@ -1179,10 +1339,14 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
     while (num_elements % kernel_threads) num_elements++;
 
-    const size_t global_work_size[3] = { num_elements,   1, 1 };
-    const size_t local_work_size[3]  = { kernel_threads, 1, 1 };
+    // the second dimension spans kernel_salts salts, only the multi-salt kernels make use of it
+
+    const u32 kernel_salts = device_param->kernel_salts;
+
+    const size_t global_work_size[3] = { num_elements,   kernel_salts, 1 };
+    const size_t local_work_size[3]  = { kernel_threads, 1,            1 };
 
-    CL_rc = hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->command_queue, kernel, 1, NULL, global_work_size, local_work_size, 0, NULL, &event);
+    CL_rc = hc_clEnqueueNDRangeKernel (hashcat_ctx, device_param->command_queue, kernel, (kernel_salts > 1) ? 2 : 1, NULL, global_work_size, local_work_size, 0, NULL, &event);
 
     if (CL_rc == -1) return -1;
   }
@@ -1191,6 +1355,10 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
   if (CL_rc == -1) return -1;
 
+  trace_span (hashcat_ctx, device_param, TRACE_KERNEL_ENQUEUE, ts_enqueue, num);
+
+  const u64 ts_wait = trace_now (hashcat_ctx);
+
   if (device_param->nvidia_spin_damp > 0)
   {
     if (status_ctx->devices_status == STATUS_RUNNING)
@@ -1211,6 +1379,8 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
   if (CL_rc == -1) return -1;
 
+  trace_span (hashcat_ctx, device_param, TRACE_KERNEL_WAIT, ts_wait, num);
+
   cl_ulong time_start;
   cl_ulong time_end;
 
@@ -1219,6 +1389,10 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
   const double exec_us = (double) (time_end - time_start) / 1000;
 
+  metrics_kernel_exec (hashcat_ctx, device_param, kern_run, exec_us);
+
+  trace_device (hashcat_ctx, device_param, kern_run, exec_us);
+
   if (status_ctx->devices_status == STATUS_RUNNING)
   {
     if (iteration < EXPECTED_ITERATIONS)
@@ -1261,6 +1435,11 @@ int run_kernel (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, con
 
 int run_kernel_mp (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 kern_run, const u32 num)
 {
+  if (device_param->is_host == true)
+  {
+    return host_backend_run_mp (hashcat_ctx, device_param, kern_run, num);
+  }
+
   int CL_rc = CL_SUCCESS;
 
   u32 num_elements = num;
@@ -1468,6 +1647,10 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
   user_options_t       *user_options        = hashcat_ctx->user_options;
   user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
 
+  // the host backend reads pws_buf in place, only the BF base words still have to be generated
+
+  if ((device_param->is_host == true) && (user_options_extra->attack_kern != ATTACK_KERN_BF)) return 0;
+
   int CL_rc = CL_SUCCESS;
 
   if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
@@ -1550,6 +1733,16 @@ int run_copy (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const
   return 0;
 }
 
+static bool salts_shown (const hashes_t *hashes, const u32 salt_pos, const u32 salts_cnt)
+{
+  for (u32 salt_idx = salt_pos; salt_idx < salt_pos + salts_cnt; salt_idx++)
+  {
+    if (hashes->salts_shown[salt_idx] == 0) return false;
+  }
+
+  return true;
+}
+
 int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 pws_cnt)
 {
   combinator_ctx_t      *combinator_ctx     = hashcat_ctx->combinator_ctx;
@@ -1600,24 +1793,24 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
   device_param->outerloop_pos  = 0;
   device_param->outerloop_left = pws_cnt;
 
-  // loop start: most outer loop = salt iteration, then innerloops (if multi)
+  // pick up the hashlist without the cracked digests, if there's a newer one
 
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  if (user_options->speed_only == false)
   {
-    while (status_ctx->devices_status == STATUS_PAUSED) hc_sleep (1);
+    const int rc_compact = compact_device_sync (hashcat_ctx, device_param);
 
-    salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+    if (rc_compact == -1) return -1;
+  }
 
-    device_param->kernel_params_buf32[27] = salt_pos;
-    device_param->kernel_params_buf32[31] = salt_buf->digests_cnt;
-    device_param->kernel_params_buf32[32] = salt_buf->digests_offset;
+  // loop start: most outer loop = salt iteration, then innerloops (if multi)
 
-    FILE *combs_fp = device_param->combs_fp;
+  u32 salts_launch = 1;
 
-    if (user_options->attack_mode == ATTACK_MODE_COMBI)
-    {
-      rewind (combs_fp);
-    }
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos += salts_launch)
+  {
+    while (status_ctx->devices_status == STATUS_PAUSED) hc_sleep (1);
+
+    salt_t *salt_buf = &hashes->salts_buf[salt_pos];
 
     // iteration type
 
@@ -1631,6 +1824,79 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
     else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)     innerloop_cnt  = combinator_ctx->combs_cnt;
     else if (user_options_extra->attack_kern == ATTACK_KERN_BF)        innerloop_cnt  = mask_ctx->bfs_cnt;
 
+    // rules already applied on the host, see calc()
+
+    if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) && (device_param->host_rules == true))
+    {
+      innerloop_cnt = 1;
+    }
+
+    if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == true))
+    {
+      innerloop_cnt = combinator_ctx->combs_buf_cnt;
+    }
+
+    // nothing left to crack for this salt, account all the innerloops at once
+
+    salts_launch = 1;
+
+    if (hashes->salts_shown[salt_pos] == 1)
+    {
+      u64 perf_sum_salt = (u64) pws_cnt * (u64) innerloop_cnt;
+
+      if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) && (device_param->host_rules == true))
+      {
+        perf_sum_salt = (u64) device_param->host_rules_words * (u64) straight_ctx->kernel_rules_cnt;
+      }
+
+      if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == true))
+      {
+        status_progress_add_rejected (device_param, salt_pos, (u64) pws_cnt * (u64) combinator_ctx->combs_rejected);
+      }
+
+      status_progress_add_done (device_param, salt_pos, perf_sum_salt);
+
+      continue;
+    }
+
+    // a small batch leaves most of the device idle, so let one launch span as many salts as it takes to fill it
+
+    if (hashconfig->opti_type & OPTI_TYPE_MULTI_SALT)
+    {
+      salts_launch = MAX (device_param->kernel_power / MAX (pws_cnt, 1), 1);
+
+      salts_launch = MIN (salts_launch, hashes->salts_cnt - salt_pos);
+    }
+
+    device_param->kernel_salts = salts_launch;
+
+    device_param->kernel_params_buf32[27] = salt_pos;
+
+    if (device_param->compact_image == NULL)
+    {
+      device_param->kernel_params_buf32[31] = salt_buf->digests_cnt;
+      device_param->kernel_params_buf32[32] = salt_buf->digests_offset;
+    }
+    else
+    {
+      device_param->kernel_params_buf32[31] = device_param->compact_image->salts_buf[salt_pos].digests_cnt;
+      device_param->kernel_params_buf32[32] = device_param->compact_image->salts_buf[salt_pos].digests_offset;
+    }
+
+    FILE *combs_fp = device_param->combs_fp;
+
+    if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == false))
+    {
+      rewind (combs_fp);
+    }
+
+    // resident amplifiers are already filtered, account the rejected ones in one go
+
+    if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == true))
+    {
+      status_progress_add_rejected_salts (device_param, salt_pos, salts_launch, (u64) pws_cnt * (u64) combinator_ctx->combs_rejected);
+    }
+
     // innerloops
 
     for (u32 innerloop_pos = 0; innerloop_pos < innerloop_cnt; innerloop_pos += innerloop_step)
@@ -1661,16 +1927,31 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
         continue;
       }
 
-      if (hashes->salts_shown[salt_pos] == 1)
+      // with host-side rules the batch covers all rules for fewer (and deduped) candidates
+
+      u64 perf_sum_all = (u64) pws_cnt * (u64) innerloop_left;
+
+      if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) && (device_param->host_rules == true))
+      {
+        perf_sum_all = (u64) device_param->host_rules_words * (u64) straight_ctx->kernel_rules_cnt;
+      }
+
+      if (salts_shown (hashes, salt_pos, salts_launch) == true)
       {
-        status_ctx->words_progress_done[salt_pos] += (u64) pws_cnt * (u64) innerloop_left;
+        status_progress_add_done_salts (device_param, salt_pos, salts_launch, perf_sum_all);
 
         continue;
       }
 
       // initialize amplifiers
 
-      if (user_options->attack_mode == ATTACK_MODE_COMBI)
+      if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == true))
+      {
+        // the host copy is only needed to reconstruct cracked plains and for --stdout
+
+        memcpy (device_param->combs_buf, combinator_ctx->combs_buf + innerloop_pos, innerloop_left * sizeof (comb_t));
+      }
+      else if (user_options->attack_mode == ATTACK_MODE_COMBI)
       {
         char *line_buf = combinator_ctx->scratch_buf;
 
@@ -1696,7 +1977,7 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
             if (rule_len_out < 0)
             {
-              status_ctx->words_progress_rejected[salt_pos] += pws_cnt;
+              status_progress_add_rejected_salts (device_param, salt_pos, salts_launch, pws_cnt);
 
               continue;
             }
@@ -1784,37 +2065,58 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
         if (CL_rc == -1) return -1;
       }
 
-      // copy amplifiers
+      // copy amplifiers, the host backend reads them straight from the host buffers
 
-      if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+      if (device_param->is_host == false)
       {
-        int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_rules, device_param->d_rules_c, innerloop_pos * sizeof (kernel_rule_t), 0, innerloop_left * sizeof (kernel_rule_t), 0, NULL, NULL);
+        if ((user_options->attack_mode == ATTACK_MODE_STRAIGHT) && (device_param->host_rules == true))
+        {
+          kernel_rule_t kernel_rule_noop;
 
-        if (CL_rc == -1) return -1;
-      }
-      else if (user_options->attack_mode == ATTACK_MODE_COMBI)
-      {
-        int CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (comb_t), device_param->combs_buf, 0, NULL, NULL);
+          memset (&kernel_rule_noop, 0, sizeof (kernel_rule_t));
 
-        if (CL_rc == -1) return -1;
-      }
-      else if (user_options->attack_mode == ATTACK_MODE_BF)
-      {
-        int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bfs, device_param->d_bfs_c, 0, 0, innerloop_left * sizeof (bf_t), 0, NULL, NULL);
+          kernel_rule_noop.cmds[0] = RULE_OP_MANGLE_NOOP;
 
-        if (CL_rc == -1) return -1;
-      }
-      else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
-      {
-        int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, device_param->d_combs_c, 0, 0, innerloop_left * sizeof (comb_t), 0, NULL, NULL);
+          int CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_rules_c, CL_TRUE, 0, sizeof (kernel_rule_t), &kernel_rule_noop, 0, NULL, NULL);
 
-        if (CL_rc == -1) return -1;
-      }
-      else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
-      {
-        int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, device_param->d_combs_c, 0, 0, innerloop_left * sizeof (comb_t), 0, NULL, NULL);
+          if (CL_rc == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_STRAIGHT)
+        {
+          int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_rules, device_param->d_rules_c, innerloop_pos * sizeof (kernel_rule_t), 0, innerloop_left * sizeof (kernel_rule_t), 0, NULL, NULL);
 
-        if (CL_rc == -1) return -1;
+          if (CL_rc == -1) return -1;
+        }
+        else if ((user_options->attack_mode == ATTACK_MODE_COMBI) && (device_param->combs_resident == true))
+        {
+          int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, device_param->d_combs_c, innerloop_pos * sizeof (comb_t), 0, innerloop_left * sizeof (comb_t), 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_COMBI)
+        {
+          int CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs_c, CL_TRUE, 0, innerloop_left * sizeof (comb_t), device_param->combs_buf, 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_BF)
+        {
+          int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bfs, device_param->d_bfs_c, 0, 0, innerloop_left * sizeof (bf_t), 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID1)
+        {
+          int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, device_param->d_combs_c, 0, 0, innerloop_left * sizeof (comb_t), 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
+        else if (user_options->attack_mode == ATTACK_MODE_HYBRID2)
+        {
+          int CL_rc = hc_clEnqueueCopyBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, device_param->d_combs_c, 0, 0, innerloop_left * sizeof (comb_t), 0, NULL, NULL);
+
+          if (CL_rc == -1) return -1;
+        }
       }
 
       if (user_options->speed_only == true)
@@ -1832,20 +2134,18 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
       if (user_options->speed_only == false)
       {
+        const u64 ts_check = trace_now (hashcat_ctx);
+
         check_cracked (hashcat_ctx, device_param, salt_pos);
+
+        trace_span (hashcat_ctx, device_param, TRACE_CRACK_CHECK, ts_check, salt_pos);
       }
 
       /**
        * progress
        */
 
-      u64 perf_sum_all = (u64) pws_cnt * (u64) innerloop_left;
-
-      hc_thread_mutex_lock (status_ctx->mux_counter);
-
-      status_ctx->words_progress_done[salt_pos] += perf_sum_all;
-
-      hc_thread_mutex_unlock (status_ctx->mux_counter);
+      status_progress_add_done_salts (device_param, salt_pos, salts_launch, perf_sum_all);
 
       /**
        * speed
@@ -1859,7 +2159,7 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
 
       //hc_thread_mutex_lock (status_ctx->mux_display);
 
-      device_param->speed_cnt[speed_pos] = perf_sum_all;
+      device_param->speed_cnt[speed_pos] = perf_sum_all * salts_launch;
 
       device_param->speed_msec[speed_pos] = speed_msec;
 
@@ -1892,6 +2192,8 @@ int run_cracker (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, co
   //device_param->outerloop_pos  = 0;
   //device_param->outerloop_left = 0;
 
+  device_param->kernel_salts = 1;
+
   device_param->speed_pos = speed_pos;
 
   return 0;
@@ -1914,6 +2216,22 @@ int opencl_ctx_init (hashcat_ctx_t *hashcat_ctx)
 
   opencl_ctx->devices_param = devices_param;
 
+  /**
+   * Host backend: a single device, hashing on the host CPU
+   */
+
+  if (user_options->backend_host == true)
+  {
+    opencl_ctx->opencl_platforms_filter = (u32) -1;
+    opencl_ctx->devices_filter          = (u32) -1;
+    opencl_ctx->device_types_filter     = CL_DEVICE_TYPE_ALL;
+
+    opencl_ctx->enabled      = true;
+    opencl_ctx->host_backend = true;
+
+    return 0;
+  }
+
   /**
    * Load and map OpenCL library calls
    */
@@ -1984,6 +2302,8 @@ int opencl_ctx_init (hashcat_ctx_t *hashcat_ctx)
     event_log_error (hashcat_ctx, "* Intel users require Intel OpenCL Runtime 14.2 or later (recommended 15.1 or later)");
     event_log_error (hashcat_ctx, "* NVidia users require NVidia drivers 346.59 or later (recommended 361.x or later)");
     event_log_error (hashcat_ctx, "");
+    event_log_error (hashcat_ctx, "For MD5, SHA1, SHA256 and NTLM you can use --backend-host instead");
+    event_log_error (hashcat_ctx, "");
 
     return -1;
   }
@@ -2088,23 +2408,61 @@ int opencl_ctx_devices_init (hashcat_ctx_t *hashcat_ctx, const int comptime)
 
   if (opencl_ctx->enabled == false) return 0;
 
-  /**
-   * OpenCL devices: simply push all devices from all platforms into the same device array
-   */
+  if (opencl_ctx->host_backend == true)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[0];
 
-  cl_uint         platforms_cnt         = opencl_ctx->platforms_cnt;
-  cl_platform_id *platforms             = opencl_ctx->platforms;
-  cl_uint         platform_devices_cnt  = opencl_ctx->platform_devices_cnt;
-  cl_device_id   *platform_devices      = opencl_ctx->platform_devices;
+    device_param->device_id = 0;
 
-  bool need_adl     = false;
-  bool need_nvml    = false;
-  bool need_nvapi   = false;
-  bool need_xnvctrl = false;
+    const int rc_host_init = host_backend_device_init (hashcat_ctx, device_param);
 
-  u32 devices_cnt = 0;
+    if (rc_host_init == -1) return -1;
 
-  u32 devices_active = 0;
+    if ((user_options->benchmark == true || user_options->speed_only == true || user_options->quiet == false))
+    {
+      if (user_options->machine_readable == false)
+      {
+        event_log_info (hashcat_ctx, "* Device #%u: %s, %lu/%lu MB allocatable, %uMCU",
+                  device_param->device_id + 1,
+                  device_param->device_name,
+                  (unsigned int) (device_param->device_maxmem_alloc / 1024 / 1024),
+                  (unsigned int) (device_param->device_global_mem   / 1024 / 1024),
+                  (unsigned int)  device_param->device_processors);
+
+        event_log_info (hashcat_ctx, "");
+      }
+    }
+
+    opencl_ctx->target_msec    = TARGET_MSEC_PROFILE[user_options->workload_profile - 1];
+
+    opencl_ctx->devices_cnt    = 1;
+    opencl_ctx->devices_active = 1;
+
+    opencl_ctx->need_adl       = false;
+    opencl_ctx->need_nvml      = false;
+    opencl_ctx->need_nvapi     = false;
+    opencl_ctx->need_xnvctrl   = false;
+
+    return 0;
+  }
+
+  /**
+   * OpenCL devices: simply push all devices from all platforms into the same device array
+   */
+
+  cl_uint         platforms_cnt         = opencl_ctx->platforms_cnt;
+  cl_platform_id *platforms             = opencl_ctx->platforms;
+  cl_uint         platform_devices_cnt  = opencl_ctx->platform_devices_cnt;
+  cl_device_id   *platform_devices      = opencl_ctx->platform_devices;
+
+  bool need_adl     = false;
+  bool need_nvml    = false;
+  bool need_nvapi   = false;
+  bool need_xnvctrl = false;
+
+  u32 devices_cnt = 0;
+
+  u32 devices_active = 0;
 
   if (user_options->opencl_info == true)
   {
@@ -2922,252 +3280,1151 @@ void opencl_ctx_devices_kernel_loops (hashcat_ctx_t *hashcat_ctx)
   }
 }
 
-int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
+static int build_kernel_binary (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const char *source_file, const char *build_opts, char *cached_file)
 {
-  bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
-  folder_config_t      *folder_config       = hashcat_ctx->folder_config;
-  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
-  hashes_t             *hashes              = hashcat_ctx->hashes;
-  opencl_ctx_t         *opencl_ctx          = hashcat_ctx->opencl_ctx;
-  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
-  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
-  user_options_t       *user_options        = hashcat_ctx->user_options;
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
 
-  if (opencl_ctx->enabled == false) return 0;
+  OCL_PTR *ocl = opencl_ctx->ocl;
 
-  /**
-   * Some algorithm, like descrypt, can benefit from JIT compilation
-   */
+  // a private context, the session context of this device does not exist yet
 
-  opencl_ctx->force_jit_compilation = -1;
+  cl_context_properties properties[3];
 
-  if (hashconfig->hash_mode == 8900)
+  properties[0] = CL_CONTEXT_PLATFORM;
+  properties[1] = (cl_context_properties) device_param->platform;
+  properties[2] = 0;
+
+  cl_context context;
+
+  int CL_rc = hc_clCreateContext (hashcat_ctx, properties, 1, &device_param->device, NULL, NULL, &context);
+
+  if (CL_rc == -1) return -1;
+
+  size_t kernel_length = 0;
+  char  *kernel_source = NULL;
+
+  const int rc_read_kernel = read_kernel_binary (hashcat_ctx, source_file, 1, &kernel_length, &kernel_source);
+
+  if (rc_read_kernel == -1)
   {
-    opencl_ctx->force_jit_compilation = 8900;
+    hc_clReleaseContext (hashcat_ctx, context);
+
+    return -1;
   }
-  else if (hashconfig->hash_mode == 9300)
+
+  cl_program program;
+
+  CL_rc = hc_clCreateProgramWithSource (hashcat_ctx, context, 1, (const char **) &kernel_source, NULL, &program);
+
+  hcfree (kernel_source);
+
+  if (CL_rc == -1)
   {
-    opencl_ctx->force_jit_compilation = 8900;
+    hc_clReleaseContext (hashcat_ctx, context);
+
+    return -1;
   }
-  else if (hashconfig->hash_mode == 1500 && user_options->attack_mode == ATTACK_MODE_BF && hashes->salts_cnt == 1)
+
+  // no error here, opencl_session_begin () builds it again and prints the build log
+
+  const cl_int CL_err = ocl->clBuildProgram (program, 1, &device_param->device, build_opts, NULL, NULL);
+
+  if (CL_err == CL_SUCCESS)
   {
-    opencl_ctx->force_jit_compilation = 1500;
+    size_t binary_size;
+
+    CL_rc = hc_clGetProgramInfo (hashcat_ctx, program, CL_PROGRAM_BINARY_SIZES, sizeof (size_t), &binary_size, NULL);
+
+    if (CL_rc == 0)
+    {
+      char *binary = (char *) hcmalloc (hashcat_ctx, binary_size);
+
+      if (binary != NULL)
+      {
+        CL_rc = hc_clGetProgramInfo (hashcat_ctx, program, CL_PROGRAM_BINARIES, sizeof (binary), &binary, NULL);
+
+        if (CL_rc == 0) write_kernel_binary (hashcat_ctx, cached_file, binary, binary_size);
+
+        hcfree (binary);
+      }
+    }
   }
 
-  u32 hardware_power_all = 0;
+  hc_clReleaseProgram (hashcat_ctx, program);
+  hc_clReleaseContext (hashcat_ctx, context);
 
-  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  return 0;
+}
+
+static void *thread_kernel_prebuild (void *p)
+{
+  kernel_prebuild_t *kernel_prebuild = (kernel_prebuild_t *) p;
+
+  for (u32 file_pos = 0; file_pos < kernel_prebuild->files_cnt; file_pos++)
   {
-    int CL_rc = CL_SUCCESS;
+    struct stat cst;
 
-    /**
-     * host buffer
-     */
+    if ((stat (kernel_prebuild->cached_file[file_pos], &cst) == 0) && (cst.st_size > 0)) continue;
 
-    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+    build_kernel_binary (kernel_prebuild->hashcat_ctx, kernel_prebuild->device_param, kernel_prebuild->source_file[file_pos], kernel_prebuild->build_opts, kernel_prebuild->cached_file[file_pos]);
+  }
 
-    if (device_param->skipped) continue;
+  return NULL;
+}
 
-    // vector_width
+static int device_vector_width (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u32 attack_mode)
+{
+  hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  user_options_t *user_options = hashcat_ctx->user_options;
 
-    cl_uint vector_width;
+  // VECT_SIZE is part of the build options, the prebuild has to know it before opencl_session_begin () loops over the devices
 
-    if (user_options->opencl_vector_width_chgd == false)
-    {
-      // tuning db
+  cl_uint vector_width;
 
-      tuning_db_entry_t *tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->device_type, user_options->attack_mode, hashconfig->hash_mode);
+  if (user_options->opencl_vector_width_chgd == false)
+  {
+    // tuning db
 
-      if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
-      {
-        if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
-        {
-          CL_rc = hc_clGetDeviceInfo (hashcat_ctx, device_param->device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL);
+    tuning_db_entry_t *tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->device_type, attack_mode, hashconfig->hash_mode);
 
-          if (CL_rc == -1) return -1;
-        }
-        else
-        {
-          CL_rc = hc_clGetDeviceInfo (hashcat_ctx, device_param->device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL);
+    if (tuningdb_entry == NULL || tuningdb_entry->vector_width == -1)
+    {
+      if (hashconfig->opti_type & OPTI_TYPE_USES_BITS_64)
+      {
+        const int CL_rc = hc_clGetDeviceInfo (hashcat_ctx, device_param->device, CL_DEVICE_NATIVE_VECTOR_WIDTH_LONG, sizeof (vector_width), &vector_width, NULL);
 
-          if (CL_rc == -1) return -1;
-        }
+        if (CL_rc == -1) return -1;
       }
       else
       {
-        vector_width = (cl_uint) tuningdb_entry->vector_width;
+        const int CL_rc = hc_clGetDeviceInfo (hashcat_ctx, device_param->device, CL_DEVICE_NATIVE_VECTOR_WIDTH_INT,  sizeof (vector_width), &vector_width, NULL);
+
+        if (CL_rc == -1) return -1;
       }
     }
     else
     {
-      vector_width = user_options->opencl_vector_width;
+      vector_width = (cl_uint) tuningdb_entry->vector_width;
     }
+  }
+  else
+  {
+    vector_width = user_options->opencl_vector_width;
+  }
 
-    if (vector_width > 16) vector_width = 16;
+  if (vector_width > 16) vector_width = 16;
 
-    device_param->vector_width = vector_width;
+  device_param->vector_width = vector_width;
 
-    /**
-     * kernel accel and loops tuning db adjustment
-     */
+  return 0;
+}
 
-    device_param->kernel_accel_min = 1;
-    device_param->kernel_accel_max = 1024;
+static int opencl_kernel_prebuild (hashcat_ctx_t *hashcat_ctx, const u32 attack_kern, const u32 attack_mode, const bool build_main)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+  opencl_ctx_t    *opencl_ctx    = hashcat_ctx->opencl_ctx;
 
-    device_param->kernel_loops_min = 1;
-    device_param->kernel_loops_max = 1024;
+  if (opencl_ctx->enabled == false) return 0;
 
-    tuning_db_entry_t *tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->device_type, user_options->attack_mode, hashconfig->hash_mode);
+  // builds whatever is missing in the kernel cache, one thread per device
+  // afterwards opencl_session_begin () only has to load the binaries
 
-    if (tuningdb_entry != NULL)
-    {
-      u32 _kernel_accel = tuningdb_entry->kernel_accel;
-      u32 _kernel_loops = tuningdb_entry->kernel_loops;
+  kernel_prebuild_t *kernel_prebuilds = (kernel_prebuild_t *) hccalloc (hashcat_ctx, opencl_ctx->devices_cnt, sizeof (kernel_prebuild_t)); VERIFY_PTR (kernel_prebuilds);
 
-      if (_kernel_accel)
-      {
-        device_param->kernel_accel_min = _kernel_accel;
-        device_param->kernel_accel_max = _kernel_accel;
-      }
+  hc_thread_t *c_threads = (hc_thread_t *) hccalloc (hashcat_ctx, opencl_ctx->devices_cnt, sizeof (hc_thread_t)); VERIFY_PTR (c_threads);
 
-      if (_kernel_loops)
-      {
-        if (user_options->workload_profile == 1)
-        {
-          _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
-        }
-        else if (user_options->workload_profile == 2)
-        {
-          _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
-        }
+  u32 c_threads_cnt = 0;
 
-        device_param->kernel_loops_min = _kernel_loops;
-        device_param->kernel_loops_max = _kernel_loops;
-      }
-    }
+  int rc = 0;
 
-    // commandline parameters overwrite tuningdb entries
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
 
-    if (user_options->kernel_accel_chgd == true)
+    if (device_param->skipped) continue;
+
+    kernel_prebuild_t *kernel_prebuild = &kernel_prebuilds[device_id];
+
+    kernel_prebuild->hashcat_ctx  = hashcat_ctx;
+    kernel_prebuild->device_param = device_param;
+
+    if (device_vector_width (hashcat_ctx, device_param, attack_mode) == -1)
     {
-      device_param->kernel_accel_min = user_options->kernel_accel;
-      device_param->kernel_accel_max = user_options->kernel_accel;
+      rc = -1;
+
+      break;
     }
 
-    if (user_options->kernel_loops_chgd == true)
+    generate_build_opts (hashcat_ctx, device_param, kernel_prebuild->build_opts, sizeof (kernel_prebuild->build_opts));
+
+    if (build_main == true)
     {
-      device_param->kernel_loops_min = user_options->kernel_loops;
-      device_param->kernel_loops_max = user_options->kernel_loops;
+      generate_source_kernel_filename (hashconfig->attack_exec, attack_kern, hashconfig->kern_type, folder_config->shared_dir, kernel_prebuild->source_file[kernel_prebuild->files_cnt]);
+
+      kernel_prebuild->files_cnt++;
     }
 
+    if (attack_kern != ATTACK_KERN_STRAIGHT)
+    {
+      generate_source_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->shared_dir, kernel_prebuild->source_file[kernel_prebuild->files_cnt]);
 
-    /**
-     * device properties
-     */
+      kernel_prebuild->files_cnt++;
+    }
 
-    const char *device_name_chksum  = device_param->device_name_chksum;
-    const u32   device_processors   = device_param->device_processors;
+    if (hashconfig->attack_exec == ATTACK_EXEC_OUTSIDE_KERNEL)
+    {
+      generate_source_kernel_amp_filename (attack_kern, folder_config->shared_dir, kernel_prebuild->source_file[kernel_prebuild->files_cnt]);
 
-    /**
-     * create context for each device
-     */
+      kernel_prebuild->files_cnt++;
+    }
 
-    cl_context_properties properties[3];
+    u32 files_cnt = 0;
 
-    properties[0] = CL_CONTEXT_PLATFORM;
-    properties[1] = (cl_context_properties) device_param->platform;
-    properties[2] = 0;
+    for (u32 file_pos = 0; file_pos < kernel_prebuild->files_cnt; file_pos++)
+    {
+      const char *source_file = kernel_prebuild->source_file[file_pos];
 
-    CL_rc = hc_clCreateContext (hashcat_ctx, properties, 1, &device_param->device, NULL, NULL, &device_param->context);
+      char kernel_key[17] = { 0 };
 
-    if (CL_rc == -1) return -1;
+      if (generate_kernel_cache_key (hashcat_ctx, source_file, kernel_prebuild->build_opts, kernel_key) == -1)
+      {
+        rc = -1;
 
-    /**
-     * create command-queue
-     */
+        break;
+      }
 
-    // not supported with NV
-    // device_param->command_queue = hc_clCreateCommandQueueWithProperties (hashcat_ctx, device_param->device, NULL);
+      char cached_file[256] = { 0 };
 
-    CL_rc = hc_clCreateCommandQueue (hashcat_ctx, device_param->context, device_param->device, CL_QUEUE_PROFILING_ENABLE, &device_param->command_queue);
+      if ((build_main == true) && (file_pos == 0))
+      {
+        generate_cached_kernel_filename (hashconfig->attack_exec, attack_kern, hashconfig->kern_type, folder_config->profile_dir, device_param->device_name_chksum, kernel_key, cached_file);
+      }
+      else if (strstr (source_file, "/markov_") != NULL)
+      {
+        generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->profile_dir, device_param->device_name_chksum, kernel_key, cached_file);
+      }
+      else
+      {
+        generate_cached_kernel_amp_filename (attack_kern, folder_config->profile_dir, device_param->device_name_chksum, kernel_key, cached_file);
+      }
 
-    if (CL_rc == -1) return -1;
+      // identical devices end up with the same cache file, building it once is enough
 
-    /**
-     * kernel threads: some algorithms need a fixed kernel-threads count
-     *                 because of shared memory usage or bitslice
-     *                 there needs to be some upper limit, otherwise there's too much overhead
-     */
+      bool dupe = false;
 
-    u32 kernel_threads = hashconfig_enforce_kernel_threads (hashcat_ctx, device_param);
+      for (u32 device_id_prev = 0; device_id_prev < device_id; device_id_prev++)
+      {
+        const kernel_prebuild_t *kernel_prebuild_prev = &kernel_prebuilds[device_id_prev];
 
-    device_param->kernel_threads = kernel_threads;
+        for (u32 file_pos_prev = 0; file_pos_prev < kernel_prebuild_prev->files_cnt; file_pos_prev++)
+        {
+          if (strcmp (kernel_prebuild_prev->cached_file[file_pos_prev], cached_file) == 0) dupe = true;
+        }
+      }
 
-    device_param->hardware_power = device_processors * kernel_threads;
+      if (dupe == true) continue;
 
-    /**
-     * create input buffers on device : calculate size of fixed memory buffers
-     */
+      memmove (kernel_prebuild->source_file[files_cnt], source_file, 256);
 
-    size_t size_root_css   = SP_PW_MAX *           sizeof (cs_t);
-    size_t size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+      memmove (kernel_prebuild->cached_file[files_cnt], cached_file, 256);
 
-    device_param->size_root_css   = size_root_css;
-    device_param->size_markov_css = size_markov_css;
+      files_cnt++;
+    }
 
-    size_t size_results = sizeof (u32);
+    kernel_prebuild->files_cnt = files_cnt;
 
-    device_param->size_results = size_results;
+    if (rc == -1) break;
 
-    size_t size_rules   = straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
-    size_t size_rules_c = KERNEL_RULES                   * sizeof (kernel_rule_t);
+    if (kernel_prebuild->files_cnt == 0) continue;
 
-    size_t size_plains  = hashes->digests_cnt * sizeof (plain_t);
-    size_t size_salts   = hashes->salts_cnt   * sizeof (salt_t);
-    size_t size_esalts  = hashes->salts_cnt   * hashconfig->esalt_size;
-    size_t size_shown   = hashes->digests_cnt * sizeof (u32);
-    size_t size_digests = hashes->digests_cnt * hashconfig->dgst_size;
+    hc_thread_create (c_threads[c_threads_cnt], thread_kernel_prebuild, kernel_prebuild);
 
-    device_param->size_plains   = size_plains;
-    device_param->size_digests  = size_digests;
-    device_param->size_shown    = size_shown;
-    device_param->size_salts    = size_salts;
+    c_threads_cnt++;
+  }
 
-    size_t size_combs = KERNEL_COMBS * sizeof (comb_t);
-    size_t size_bfs   = KERNEL_BFS   * sizeof (bf_t);
-    size_t size_tm    = 32           * sizeof (bs_word_t);
+  hc_thread_wait (c_threads_cnt, c_threads);
 
-    // scryptV stuff
+  hcfree (c_threads);
+  hcfree (kernel_prebuilds);
 
-    u32 scrypt_tmp_size   = 0;
-    u32 scrypt_tmto_final = 0;
+  return rc;
+}
 
-    size_t size_scrypt = 4;
+int opencl_kernel_warmup (hashcat_ctx_t *hashcat_ctx)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  hashconfig_t    *hashconfig    = hashcat_ctx->hashconfig;
+  opencl_ctx_t    *opencl_ctx    = hashcat_ctx->opencl_ctx;
+  user_options_t  *user_options  = hashcat_ctx->user_options;
 
-    if ((hashconfig->hash_mode == 8900) || (hashconfig->hash_mode == 9300))
-    {
-      // we need to check that all hashes have the same scrypt settings
+  if (opencl_ctx->enabled == false) return 0;
 
-      const u32 scrypt_N = hashes->salts_buf[0].scrypt_N;
-      const u32 scrypt_r = hashes->salts_buf[0].scrypt_r;
-      const u32 scrypt_p = hashes->salts_buf[0].scrypt_p;
+  char *hash_modes = hcstrdup (hashcat_ctx, user_options->kernel_warmup);
 
-      for (u32 i = 1; i < hashes->salts_cnt; i++)
-      {
-        if ((hashes->salts_buf[i].scrypt_N != scrypt_N)
-         || (hashes->salts_buf[i].scrypt_r != scrypt_r)
-         || (hashes->salts_buf[i].scrypt_p != scrypt_p))
-        {
-          event_log_error (hashcat_ctx, "Mixed scrypt settings not supported");
+  char *saveptr = NULL;
 
-          return -1;
-        }
-      }
+  char *next = strtok_r (hash_modes, ",", &saveptr);
 
-      scrypt_tmp_size = (128 * scrypt_r * scrypt_p);
+  if (next == NULL)
+  {
+    hcfree (hash_modes);
 
-      hashconfig->tmp_size = scrypt_tmp_size;
+    return 0;
+  }
+
+  int rc = 0;
+
+  do
+  {
+    user_options->hash_mode = atoi (next);
+
+    const int rc_hashconfig = hashconfig_init (hashcat_ctx);
+
+    if (rc_hashconfig == -1)
+    {
+      rc = -1;
+
+      break;
+    }
+
+    event_log_info (hashcat_ctx, "Building kernels for hash-mode %u", user_options->hash_mode);
+
+    // scrypt kernels are always compiled with the salt parameters, nothing to cache
+
+    const bool build_main = (hashconfig->hash_mode != 8900) && (hashconfig->hash_mode != 9300);
+
+    // the tuning db is searched by attack mode, use the plain one for each kernel type
+
+    const u32 attack_kerns[3] = { ATTACK_KERN_STRAIGHT, ATTACK_KERN_COMBI, ATTACK_KERN_BF };
+    const u32 attack_modes[3] = { ATTACK_MODE_STRAIGHT, ATTACK_MODE_COMBI, ATTACK_MODE_BF };
+
+    for (u32 attack_kern_pos = 0; attack_kern_pos < 3; attack_kern_pos++)
+    {
+      if (chdir (folder_config->cpath_real) == -1)
+      {
+        event_log_error (hashcat_ctx, "%s: %s", folder_config->cpath_real, strerror (errno));
+
+        rc = -1;
+
+        break;
+      }
+
+      const int rc_prebuild = opencl_kernel_prebuild (hashcat_ctx, attack_kerns[attack_kern_pos], attack_modes[attack_kern_pos], build_main);
+
+      if (chdir (folder_config->cwd) == -1)
+      {
+        event_log_error (hashcat_ctx, "%s: %s", folder_config->cwd, strerror (errno));
+
+        rc = -1;
+
+        break;
+      }
+
+      if (rc_prebuild == -1)
+      {
+        rc = -1;
+
+        break;
+      }
+    }
+
+    hashconfig_destroy (hashcat_ctx);
+
+    if (rc == -1) break;
+
+  } while ((next = strtok_r ((char *) NULL, ",", &saveptr)) != NULL);
+
+  hcfree (hash_modes);
+
+  return rc;
+}
+
+static int kernel_groups_init (hashcat_ctx_t *hashcat_ctx)
+{
+  hashes_t     *hashes     = hashcat_ctx->hashes;
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  opencl_ctx->kernel_groups      = (kernel_group_t *) hccalloc (hashcat_ctx, KERNEL_GROUPS_MAX, sizeof (kernel_group_t)); VERIFY_PTR (opencl_ctx->kernel_groups);
+  opencl_ctx->kernel_groups_cnt  = 0;
+  opencl_ctx->salts_kernel_group = (u32 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u32)); VERIFY_PTR (opencl_ctx->salts_kernel_group);
+
+  if (opencl_ctx->force_jit_compilation == 8900)
+  {
+    // scrypt has no generic kernel, every N/r/p combination needs its own build
+
+    for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+    {
+      const salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+      u32 group_pos;
+
+      for (group_pos = 0; group_pos < opencl_ctx->kernel_groups_cnt; group_pos++)
+      {
+        const kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[group_pos];
+
+        if (kernel_group->scrypt_N != salt_buf->scrypt_N) continue;
+        if (kernel_group->scrypt_r != salt_buf->scrypt_r) continue;
+        if (kernel_group->scrypt_p != salt_buf->scrypt_p) continue;
+
+        break;
+      }
+
+      if (group_pos == opencl_ctx->kernel_groups_cnt)
+      {
+        if (opencl_ctx->kernel_groups_cnt == KERNEL_GROUPS_MAX)
+        {
+          event_log_error (hashcat_ctx, "Too many different scrypt settings, up to %u are supported", KERNEL_GROUPS_MAX);
+
+          return -1;
+        }
+
+        kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[group_pos];
+
+        kernel_group->specialized = true;
+        kernel_group->scrypt_N    = salt_buf->scrypt_N;
+        kernel_group->scrypt_r    = salt_buf->scrypt_r;
+        kernel_group->scrypt_p    = salt_buf->scrypt_p;
+
+        opencl_ctx->kernel_groups_cnt++;
+      }
+
+      opencl_ctx->kernel_groups[group_pos].salts_cnt++;
+      opencl_ctx->kernel_groups[group_pos].digests_cnt += salt_buf->digests_cnt;
+
+      opencl_ctx->salts_kernel_group[salt_pos] = group_pos;
+    }
+  }
+  else if (opencl_ctx->force_jit_compilation == 1500)
+  {
+    // one build per salt would take forever on a large list
+    // the salts with the most digests get their own, the others share the generic kernel
+
+    const u32 specialized_cnt = (hashes->salts_cnt <= KERNEL_GROUPS_MAX) ? hashes->salts_cnt : KERNEL_GROUPS_MAX - 1;
+
+    for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+    {
+      opencl_ctx->salts_kernel_group[salt_pos] = specialized_cnt;
+    }
+
+    for (u32 group_pos = 0; group_pos < specialized_cnt; group_pos++)
+    {
+      u32 best_pos = 0;
+      u32 best_cnt = 0;
+
+      for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+      {
+        if (opencl_ctx->salts_kernel_group[salt_pos] != specialized_cnt) continue;
+
+        if (hashes->salts_buf[salt_pos].digests_cnt <= best_cnt) continue;
+
+        best_pos = salt_pos;
+        best_cnt = hashes->salts_buf[salt_pos].digests_cnt;
+      }
+
+      kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[group_pos];
+
+      kernel_group->salts_cnt     = 1;
+      kernel_group->digests_cnt   = best_cnt;
+      kernel_group->specialized   = true;
+      kernel_group->descrypt_salt = hashes->salts_buf[best_pos].salt_buf[0];
+
+      opencl_ctx->salts_kernel_group[best_pos] = group_pos;
+    }
+
+    opencl_ctx->kernel_groups_cnt = specialized_cnt;
+
+    if (specialized_cnt < hashes->salts_cnt)
+    {
+      kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[specialized_cnt];
+
+      for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+      {
+        if (opencl_ctx->salts_kernel_group[salt_pos] != specialized_cnt) continue;
+
+        kernel_group->salts_cnt++;
+        kernel_group->digests_cnt += hashes->salts_buf[salt_pos].digests_cnt;
+      }
+
+      opencl_ctx->kernel_groups_cnt++;
+    }
+  }
+  else
+  {
+    kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[0];
+
+    kernel_group->salts_cnt   = hashes->salts_cnt;
+    kernel_group->digests_cnt = hashes->digests_cnt;
+
+    opencl_ctx->kernel_groups_cnt = 1;
+  }
+
+  return 0;
+}
+
+static int opencl_session_bzero (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+
+  const size_t size_tm = 32 * sizeof (bs_word_t);
+
+  int CL_rc;
+
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_pws_buf,     device_param->size_pws);      if (CL_rc == -1) return -1;
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_pws_amp_buf, device_param->size_pws);      if (CL_rc == -1) return -1;
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_tmps,        device_param->size_tmps);     if (CL_rc == -1) return -1;
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_hooks,       device_param->size_hooks);    if (CL_rc == -1) return -1;
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_plain_bufs,  device_param->size_plains);   if (CL_rc == -1) return -1;
+  CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_result,      device_param->size_results);  if (CL_rc == -1) return -1;
+
+  /**
+   * special buffers
+   */
+
+  if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+  {
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_rules_c, device_param->size_rules_c); if (CL_rc == -1) return -1;
+  }
+  else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+  {
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_combs_c,        device_param->size_combs);       if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_root_css_buf,   device_param->size_root_css);    if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_markov_css_buf, device_param->size_markov_css);  if (CL_rc == -1) return -1;
+
+    if (device_param->combs_resident == true)
+    {
+      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_combs, device_param->size_combs_all); if (CL_rc == -1) return -1;
+
+      CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_combs, CL_TRUE, 0, combinator_ctx->combs_buf_cnt * sizeof (comb_t), combinator_ctx->combs_buf, 0, NULL, NULL);
+
+      if (CL_rc == -1) return -1;
+    }
+    else
+    {
+      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_combs, device_param->size_combs); if (CL_rc == -1) return -1;
+    }
+  }
+  else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
+  {
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_bfs,            device_param->size_bfs);         if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_bfs_c,          device_param->size_bfs);         if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_tm_c,           size_tm);                        if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_root_css_buf,   device_param->size_root_css);    if (CL_rc == -1) return -1;
+    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_markov_css_buf, device_param->size_markov_css);  if (CL_rc == -1) return -1;
+  }
+
+  return 0;
+}
+
+static void opencl_session_key (hashcat_ctx_t *hashcat_ctx, opencl_session_key_t *session_key)
+{
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  memset (session_key, 0, sizeof (opencl_session_key_t));
+
+  session_key->hash_mode                = hashconfig->hash_mode;
+  session_key->attack_mode              = user_options->attack_mode;
+  session_key->kern_type                = hashconfig->kern_type;
+  session_key->opti_type                = hashconfig->opti_type;
+  session_key->opts_type                = hashconfig->opts_type;
+  session_key->kernel_accel             = user_options->kernel_accel;
+  session_key->kernel_loops             = user_options->kernel_loops;
+  session_key->workload_profile         = user_options->workload_profile;
+  session_key->opencl_vector_width      = user_options->opencl_vector_width;
+  session_key->kernel_accel_chgd        = user_options->kernel_accel_chgd;
+  session_key->kernel_loops_chgd        = user_options->kernel_loops_chgd;
+  session_key->opencl_vector_width_chgd = user_options->opencl_vector_width_chgd;
+}
+
+// the device memory a kept session needs with the current hashlist and rules, the same sum opencl_session_begin () checks
+
+static u64 opencl_session_size_total (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param)
+{
+  const bitmap_ctx_t   *bitmap_ctx   = hashcat_ctx->bitmap_ctx;
+  const hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
+  const hashes_t       *hashes       = hashcat_ctx->hashes;
+  const straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+
+  const u64 size_total
+    = bitmap_ctx->bitmap_size * 8
+    + device_param->size_bfs
+    + device_param->size_combs
+    + hashes->digests_cnt * hashconfig->dgst_size
+    + hashes->salts_cnt   * hashconfig->esalt_size
+    + device_param->size_hooks
+    + device_param->size_markov_css
+    + hashes->digests_cnt * sizeof (plain_t)
+    + device_param->size_pws
+    + device_param->size_pws // not a bug
+    + device_param->size_results
+    + device_param->size_root_css
+    + straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t)
+    + device_param->size_rules_c
+    + hashes->salts_cnt   * sizeof (salt_t)
+    + hashes->digests_cnt * sizeof (u32)
+    + 32 * sizeof (bs_word_t)
+    + device_param->size_tmps;
+
+  return size_total;
+}
+
+static bool opencl_session_warm (hashcat_ctx_t *hashcat_ctx)
+{
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  opencl_session_key_t session_key;
+
+  opencl_session_key (hashcat_ctx, &session_key);
+
+  if (memcmp (&session_key, &opencl_ctx->session_key, sizeof (opencl_session_key_t)) != 0) return false;
+
+  // the buffers which follow the hashlist are created again, they have to fit next to the ones we keep
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    if (opencl_session_size_total (hashcat_ctx, device_param) > device_param->device_global_mem) return false;
+  }
+
+  return true;
+}
+
+static int opencl_session_rebind (hashcat_ctx_t *hashcat_ctx)
+{
+  bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  hashes_t             *hashes              = hashcat_ctx->hashes;
+  opencl_ctx_t         *opencl_ctx          = hashcat_ctx->opencl_ctx;
+  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  u32 hardware_power_all = 0;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    int CL_rc = CL_SUCCESS;
+
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    /**
+     * context, programs, kernels and the buffers sized by kernel_accel stay, the ones sized by the hashlist are replaced
+     */
+
+    const size_t size_plains  = hashes->digests_cnt * sizeof (plain_t);
+    const size_t size_salts   = hashes->salts_cnt   * sizeof (salt_t);
+    const size_t size_esalts  = hashes->salts_cnt   * hashconfig->esalt_size;
+    const size_t size_shown   = hashes->digests_cnt * sizeof (u32);
+    const size_t size_digests = hashes->digests_cnt * hashconfig->dgst_size;
+    const size_t size_rules   = straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
+
+    // resident amplifiers, see opencl_session_begin ()
+
+    size_t size_combs_all = 0;
+
+    if (combinator_ctx->combs_buf != NULL)
+    {
+      size_combs_all = MAX (combinator_ctx->combs_buf_cnt, 1) * sizeof (comb_t);
+
+      if (size_combs_all > device_param->device_maxmem_alloc) size_combs_all = 0;
+
+      if ((opencl_session_size_total (hashcat_ctx, device_param) + size_combs_all) > device_param->device_global_mem) size_combs_all = 0;
+    }
+
+    if (device_param->d_bitmap_s1_a)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s1_a);
+    if (device_param->d_bitmap_s1_b)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s1_b);
+    if (device_param->d_bitmap_s1_c)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s1_c);
+    if (device_param->d_bitmap_s1_d)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s1_d);
+    if (device_param->d_bitmap_s2_a)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s2_a);
+    if (device_param->d_bitmap_s2_b)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s2_b);
+    if (device_param->d_bitmap_s2_c)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s2_c);
+    if (device_param->d_bitmap_s2_d)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_bitmap_s2_d);
+    if (device_param->d_plain_bufs)     hc_clReleaseMemObject (hashcat_ctx, device_param->d_plain_bufs);
+    if (device_param->d_digests_buf)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_digests_buf);
+    if (device_param->d_digests_shown)  hc_clReleaseMemObject (hashcat_ctx, device_param->d_digests_shown);
+    if (device_param->d_salt_bufs)      hc_clReleaseMemObject (hashcat_ctx, device_param->d_salt_bufs);
+    if (device_param->d_esalt_bufs)     hc_clReleaseMemObject (hashcat_ctx, device_param->d_esalt_bufs);
+    if (device_param->d_rules)          hc_clReleaseMemObject (hashcat_ctx, device_param->d_rules);
+    if (device_param->d_combs)          hc_clReleaseMemObject (hashcat_ctx, device_param->d_combs);
+
+    device_param->d_esalt_bufs  = NULL;
+    device_param->d_rules       = NULL;
+    device_param->d_combs       = NULL;
+
+    // some algorithm collide too fast, make that impossible
+
+    if (user_options->benchmark == true)
+    {
+      ((u32 *) hashes->digests_buf)[0] = -1u;
+      ((u32 *) hashes->digests_buf)[1] = -1u;
+      ((u32 *) hashes->digests_buf)[2] = -1u;
+      ((u32 *) hashes->digests_buf)[3] = -1u;
+    }
+
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s1_a);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s1_b);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s1_c);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s1_d);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s2_a);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s2_b);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s2_c);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   bitmap_ctx->bitmap_size, NULL, &device_param->d_bitmap_s2_d);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_WRITE,  size_plains,             NULL, &device_param->d_plain_bufs);     if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   size_digests,            NULL, &device_param->d_digests_buf);    if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_WRITE,  size_shown,              NULL, &device_param->d_digests_shown);  if (CL_rc == -1) return -1;
+    CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY,   size_salts,              NULL, &device_param->d_salt_bufs);      if (CL_rc == -1) return -1;
+
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_a,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_a,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_b,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_b,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_c,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_c,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s1_d,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s1_d,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_a,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_a,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_b,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_b,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_c,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_c,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_bitmap_s2_d,    CL_TRUE, 0, bitmap_ctx->bitmap_size, bitmap_ctx->bitmap_s2_d,  0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_buf,    CL_TRUE, 0, size_digests,            hashes->digests_buf,      0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_digests_shown,  CL_TRUE, 0, size_shown,              hashes->digests_shown,    0, NULL, NULL); if (CL_rc == -1) return -1;
+    CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_salt_bufs,      CL_TRUE, 0, size_salts,              hashes->salts_buf,        0, NULL, NULL); if (CL_rc == -1) return -1;
+
+    if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+    {
+      CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_rules, NULL, &device_param->d_rules); if (CL_rc == -1) return -1;
+
+      CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_rules, CL_TRUE, 0, size_rules, straight_ctx->kernel_rules_buf, 0, NULL, NULL); if (CL_rc == -1) return -1;
+    }
+    else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
+    {
+      const size_t size_combs_d = (size_combs_all > 0) ? size_combs_all : device_param->size_combs;
+
+      CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_combs_d, NULL, &device_param->d_combs); if (CL_rc == -1) return -1;
+    }
+
+    if (size_esalts)
+    {
+      CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_esalts, NULL, &device_param->d_esalt_bufs);
+
+      if (CL_rc == -1) return -1;
+
+      CL_rc = hc_clEnqueueWriteBuffer (hashcat_ctx, device_param->command_queue, device_param->d_esalt_bufs, CL_TRUE, 0, size_esalts, hashes->esalts_buf, 0, NULL, NULL);
+
+      if (CL_rc == -1) return -1;
+    }
+
+    device_param->size_plains    = size_plains;
+    device_param->size_digests   = size_digests;
+    device_param->size_shown     = size_shown;
+    device_param->size_salts     = size_salts;
+    device_param->size_rules     = size_rules;
+    device_param->size_combs_all = size_combs_all;
+
+    device_param->combs_resident = (size_combs_all > 0);
+
+    // the previous job's amplifier may have lowered it
+
+    device_param->kernel_loops_max = device_param->kernel_loops_max_orig;
+
+    /**
+     * kernel args, the buffers above are new
+     */
+
+    device_param->kernel_params_buf32[24] = bitmap_ctx->bitmap_mask;
+    device_param->kernel_params_buf32[25] = bitmap_ctx->bitmap_shift1;
+    device_param->kernel_params_buf32[26] = bitmap_ctx->bitmap_shift2;
+    device_param->kernel_params_buf32[27] = 0; // salt_pos
+    device_param->kernel_params_buf32[28] = 0; // loop_pos
+    device_param->kernel_params_buf32[29] = 0; // loop_cnt
+    device_param->kernel_params_buf32[30] = 0; // kernel_rules_cnt
+    device_param->kernel_params_buf32[31] = 0; // digests_cnt
+    device_param->kernel_params_buf32[32] = 0; // digests_offset
+    device_param->kernel_params_buf32[33] = 0; // combs_mode
+    device_param->kernel_params_buf32[34] = 0; // gid_max
+
+    for (u32 group_pos = 0; group_pos < opencl_ctx->kernel_groups_cnt; group_pos++)
+    {
+      const device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
+      for (u32 i = 0; i <= 23; i++)
+      {
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel1, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel2, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel3, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel12, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel23, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+      }
+
+      for (u32 i = 24; i <= 34; i++)
+      {
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel1, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel2, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel3, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel12, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_kernel_group->kernel23, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+      }
+    }
+
+    if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
+    {
+      for (u32 i = 0; i < 3; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel_mp, i, sizeof (cl_mem), (void *) device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
+    }
+
+    // zero some data buffers
+
+    CL_rc = opencl_session_bzero (hashcat_ctx, device_param);
+
+    if (CL_rc == -1) return -1;
+
+    hardware_power_all += device_param->hardware_power;
+  }
+
+  if (hardware_power_all == 0) return -1;
+
+  opencl_ctx->hardware_power_all = hardware_power_all;
+
+  return 0;
+}
+
+int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
+{
+  bitmap_ctx_t         *bitmap_ctx          = hashcat_ctx->bitmap_ctx;
+  combinator_ctx_t     *combinator_ctx      = hashcat_ctx->combinator_ctx;
+  folder_config_t      *folder_config       = hashcat_ctx->folder_config;
+  hashconfig_t         *hashconfig          = hashcat_ctx->hashconfig;
+  hashes_t             *hashes              = hashcat_ctx->hashes;
+  opencl_ctx_t         *opencl_ctx          = hashcat_ctx->opencl_ctx;
+  straight_ctx_t       *straight_ctx        = hashcat_ctx->straight_ctx;
+  user_options_extra_t *user_options_extra  = hashcat_ctx->user_options_extra;
+  user_options_t       *user_options        = hashcat_ctx->user_options;
+
+  if (opencl_ctx->enabled == false) return 0;
+
+  /**
+   * Some algorithm, like descrypt, can benefit from JIT compilation
+   */
+
+  opencl_ctx->force_jit_compilation = -1;
+
+  if (hashconfig->hash_mode == 8900)
+  {
+    opencl_ctx->force_jit_compilation = 8900;
+  }
+  else if (hashconfig->hash_mode == 9300)
+  {
+    opencl_ctx->force_jit_compilation = 8900;
+  }
+  else if (hashconfig->hash_mode == 1500 && user_options->attack_mode == ATTACK_MODE_BF)
+  {
+    opencl_ctx->force_jit_compilation = 1500;
+  }
+
+  /**
+   * The session kept by the previous outer loop is picked up again if it was set up for the same kernels, otherwise released
+   */
+
+  bool session_warm = false;
+
+  if (opencl_ctx->session_kept == true)
+  {
+    session_warm = opencl_session_warm (hashcat_ctx);
+
+    if (session_warm == true)
+    {
+      // the kernel groups follow the salts, they are set up again below
+
+      hcfree (opencl_ctx->kernel_groups);
+      hcfree (opencl_ctx->salts_kernel_group);
+
+      opencl_ctx->kernel_groups      = NULL;
+      opencl_ctx->kernel_groups_cnt  = 0;
+      opencl_ctx->salts_kernel_group = NULL;
+    }
+    else
+    {
+      opencl_session_destroy (hashcat_ctx);
+    }
+
+    opencl_ctx->session_kept = false;
+  }
+
+  /**
+   * The JIT kernels have per-hash parameters baked in, so hashes that differ in them get a build of their own
+   */
+
+  const int rc_kernel_groups = kernel_groups_init (hashcat_ctx);
+
+  if (rc_kernel_groups == -1) return -1;
+
+  /**
+   * In combinator mode the amplifier dictionary is the same for the whole session.
+   * If it fits into a single device allocation, we filter it once on the host and keep it device-resident
+   */
+
+  if (user_options->attack_mode == ATTACK_MODE_COMBI)
+  {
+    const u64 size_combs_all = (u64) combinator_ctx->combs_cnt * sizeof (comb_t);
+
+    bool combs_fit = false;
+
+    for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+    {
+      hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+      if (device_param->skipped) continue;
+
+      if (size_combs_all <= device_param->device_maxmem_alloc) combs_fit = true;
+    }
+
+    if (combs_fit == true)
+    {
+      const int rc = combinator_ctx_load_combs (hashcat_ctx);
+
+      if (rc == -1) return -1;
+    }
+  }
+
+  /**
+   * The host backend has no kernels to build and no device buffers to fill
+   */
+
+  if (opencl_ctx->host_backend == true)
+  {
+    u32 hardware_power_all = 0;
+
+    for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+    {
+      hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+      if (device_param->skipped) continue;
+
+      const int rc_host = host_backend_session_begin (hashcat_ctx, device_param);
+
+      if (rc_host == -1) return -1;
+
+      hardware_power_all += device_param->hardware_power;
+    }
+
+    if (hardware_power_all == 0) return -1;
+
+    opencl_ctx->hardware_power_all = hardware_power_all;
+
+    return 0;
+  }
+
+  if (session_warm == true) return opencl_session_rebind (hashcat_ctx);
+
+  /**
+   * Build missing kernels for all devices in parallel, the device loop below then loads them from the cache
+   */
+
+  if (chdir (folder_config->cpath_real) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", folder_config->cpath_real, strerror (errno));
+
+    return -1;
+  }
+
+  // descrypt salts which did not get a specialized group share the generic kernel, that one can be prebuilt as usual
+
+  bool build_main = (opencl_ctx->force_jit_compilation == -1);
+
+  if (opencl_ctx->force_jit_compilation == 1500)
+  {
+    build_main = (opencl_ctx->kernel_groups[opencl_ctx->kernel_groups_cnt - 1].specialized == false);
+  }
+
+  const int rc_prebuild = opencl_kernel_prebuild (hashcat_ctx, user_options_extra->attack_kern, user_options->attack_mode, build_main);
+
+  if (chdir (folder_config->cwd) == -1)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", folder_config->cwd, strerror (errno));
+
+    return -1;
+  }
+
+  if (rc_prebuild == -1) return -1;
+
+  u32 hardware_power_all = 0;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    int CL_rc = CL_SUCCESS;
+
+    /**
+     * host buffer
+     */
+
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    // vector_width
+
+    CL_rc = device_vector_width (hashcat_ctx, device_param, user_options->attack_mode);
+
+    if (CL_rc == -1) return -1;
+
+    /**
+     * kernel accel and loops tuning db adjustment
+     */
+
+    device_param->kernel_accel_min = 1;
+    device_param->kernel_accel_max = 1024;
+
+    device_param->kernel_loops_min = 1;
+    device_param->kernel_loops_max = 1024;
+
+    tuning_db_entry_t *tuningdb_entry = tuning_db_search (hashcat_ctx, device_param->device_name, device_param->device_type, user_options->attack_mode, hashconfig->hash_mode);
+
+    if (tuningdb_entry != NULL)
+    {
+      u32 _kernel_accel = tuningdb_entry->kernel_accel;
+      u32 _kernel_loops = tuningdb_entry->kernel_loops;
+
+      if (_kernel_accel)
+      {
+        device_param->kernel_accel_min = _kernel_accel;
+        device_param->kernel_accel_max = _kernel_accel;
+      }
+
+      if (_kernel_loops)
+      {
+        if (user_options->workload_profile == 1)
+        {
+          _kernel_loops = (_kernel_loops > 8) ? _kernel_loops / 8 : 1;
+        }
+        else if (user_options->workload_profile == 2)
+        {
+          _kernel_loops = (_kernel_loops > 4) ? _kernel_loops / 4 : 1;
+        }
+
+        device_param->kernel_loops_min = _kernel_loops;
+        device_param->kernel_loops_max = _kernel_loops;
+      }
+    }
+
+    // commandline parameters overwrite tuningdb entries
+
+    if (user_options->kernel_accel_chgd == true)
+    {
+      device_param->kernel_accel_min = user_options->kernel_accel;
+      device_param->kernel_accel_max = user_options->kernel_accel;
+    }
+
+    if (user_options->kernel_loops_chgd == true)
+    {
+      device_param->kernel_loops_min = user_options->kernel_loops;
+      device_param->kernel_loops_max = user_options->kernel_loops;
+    }
+
+
+    /**
+     * device properties
+     */
+
+    const char *device_name_chksum  = device_param->device_name_chksum;
+    const u32   device_processors   = device_param->device_processors;
+
+    /**
+     * create context for each device
+     */
+
+    cl_context_properties properties[3];
+
+    properties[0] = CL_CONTEXT_PLATFORM;
+    properties[1] = (cl_context_properties) device_param->platform;
+    properties[2] = 0;
+
+    CL_rc = hc_clCreateContext (hashcat_ctx, properties, 1, &device_param->device, NULL, NULL, &device_param->context);
+
+    if (CL_rc == -1) return -1;
+
+    /**
+     * create command-queue
+     */
+
+    // not supported with NV
+    // device_param->command_queue = hc_clCreateCommandQueueWithProperties (hashcat_ctx, device_param->device, NULL);
+
+    CL_rc = hc_clCreateCommandQueue (hashcat_ctx, device_param->context, device_param->device, CL_QUEUE_PROFILING_ENABLE, &device_param->command_queue);
+
+    if (CL_rc == -1) return -1;
+
+    /**
+     * kernel threads: some algorithms need a fixed kernel-threads count
+     *                 because of shared memory usage or bitslice
+     *                 there needs to be some upper limit, otherwise there's too much overhead
+     */
+
+    u32 kernel_threads = hashconfig_enforce_kernel_threads (hashcat_ctx, device_param);
+
+    device_param->kernel_threads = kernel_threads;
+
+    device_param->kernel_salts = 1;
+
+    device_param->hardware_power = device_processors * kernel_threads;
+
+    /**
+     * create input buffers on device : calculate size of fixed memory buffers
+     */
+
+    size_t size_root_css   = SP_PW_MAX *           sizeof (cs_t);
+    size_t size_markov_css = SP_PW_MAX * CHARSIZ * sizeof (cs_t);
+
+    device_param->size_root_css   = size_root_css;
+    device_param->size_markov_css = size_markov_css;
+
+    size_t size_results = sizeof (u32);
+
+    device_param->size_results = size_results;
+
+    size_t size_rules   = straight_ctx->kernel_rules_cnt * sizeof (kernel_rule_t);
+    size_t size_rules_c = KERNEL_RULES                   * sizeof (kernel_rule_t);
+
+    size_t size_plains  = hashes->digests_cnt * sizeof (plain_t);
+    size_t size_salts   = hashes->salts_cnt   * sizeof (salt_t);
+    size_t size_esalts  = hashes->salts_cnt   * hashconfig->esalt_size;
+    size_t size_shown   = hashes->digests_cnt * sizeof (u32);
+    size_t size_digests = hashes->digests_cnt * hashconfig->dgst_size;
+
+    device_param->size_plains   = size_plains;
+    device_param->size_digests  = size_digests;
+    device_param->size_shown    = size_shown;
+    device_param->size_salts    = size_salts;
+
+    size_t size_combs = KERNEL_COMBS * sizeof (comb_t);
+    size_t size_bfs   = KERNEL_BFS   * sizeof (bf_t);
+    size_t size_tm    = 32           * sizeof (bs_word_t);
+
+    // resident amplifiers, see above
+
+    size_t size_combs_all = 0;
+
+    if (combinator_ctx->combs_buf != NULL)
+    {
+      size_combs_all = MAX (combinator_ctx->combs_buf_cnt, 1) * sizeof (comb_t);
+
+      if (size_combs_all > device_param->device_maxmem_alloc) size_combs_all = 0;
+    }
+
+    // one build per kernel group, see kernel_groups_init ()
+
+    device_param->kernel_groups = (device_kernel_group_t *) hccalloc (hashcat_ctx, opencl_ctx->kernel_groups_cnt, sizeof (device_kernel_group_t)); VERIFY_PTR (device_param->kernel_groups);
+
+    // scryptV stuff
 
+    size_t size_scrypt = 4;
+
+    if ((hashconfig->hash_mode == 8900) || (hashconfig->hash_mode == 9300))
+    {
       u32 tmto_start = 0;
       u32 tmto_stop  = 10;
 
@@ -3207,47 +4464,71 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
       device_param->kernel_accel_min = 1;
       device_param->kernel_accel_max = 8;
 
-      u32 tmto;
+      // each group gets the lowest tmto it fits with, the buffers are sized for the largest group
 
-      for (tmto = tmto_start; tmto < tmto_stop; tmto++)
+      u32 scrypt_tmp_size_max = 0;
+
+      for (u32 group_pos = 0; group_pos < opencl_ctx->kernel_groups_cnt; group_pos++)
       {
-        size_scrypt = (128 * scrypt_r) * scrypt_N;
+        const kernel_group_t *kernel_group = &opencl_ctx->kernel_groups[group_pos];
+
+        device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
+        const u32 scrypt_N = kernel_group->scrypt_N;
+        const u32 scrypt_r = kernel_group->scrypt_r;
+        const u32 scrypt_p = kernel_group->scrypt_p;
+
+        size_t size_scrypt_group = 0;
 
-        size_scrypt /= 1u << tmto;
+        u32 tmto;
+
+        for (tmto = tmto_start; tmto < tmto_stop; tmto++)
+        {
+          size_scrypt_group = (128 * scrypt_r) * scrypt_N;
+
+          size_scrypt_group /= 1u << tmto;
+
+          size_scrypt_group *= device_param->device_processors * device_param->kernel_threads * device_param->kernel_accel_max;
+
+          if ((size_scrypt_group / 4) > device_param->device_maxmem_alloc)
+          {
+            event_log_warning (hashcat_ctx, "Not enough single-block device memory allocatable to use --scrypt-tmto %d, increasing...", tmto);
+
+            continue;
+          }
 
-        size_scrypt *= device_param->device_processors * device_param->kernel_threads * device_param->kernel_accel_max;
+          if (size_scrypt_group > device_param->device_global_mem)
+          {
+            event_log_warning (hashcat_ctx, "Not enough total device memory allocatable to use --scrypt-tmto %d, increasing...", tmto);
 
-        if ((size_scrypt / 4) > device_param->device_maxmem_alloc)
-        {
-          event_log_warning (hashcat_ctx, "Not enough single-block device memory allocatable to use --scrypt-tmto %d, increasing...", tmto);
+            continue;
+          }
 
-          continue;
+          break;
         }
 
-        if (size_scrypt > device_param->device_global_mem)
+        if (tmto == tmto_stop)
         {
-          event_log_warning (hashcat_ctx, "Not enough total device memory allocatable to use --scrypt-tmto %d, increasing...", tmto);
+          event_log_error (hashcat_ctx, "Can't allocate enough device memory");
 
-          continue;
+          return -1;
         }
 
-        for (u32 salts_pos = 0; salts_pos < hashes->salts_cnt; salts_pos++)
-        {
-          scrypt_tmto_final = tmto;
-        }
+        device_kernel_group->scrypt_tmto     = tmto;
+        device_kernel_group->scrypt_tmp_size = 128 * scrypt_r * scrypt_p;
 
-        break;
-      }
+        size_scrypt = MAX (size_scrypt, size_scrypt_group);
 
-      if (tmto == tmto_stop)
-      {
-        event_log_error (hashcat_ctx, "Can't allocate enough device memory");
+        scrypt_tmp_size_max = MAX (scrypt_tmp_size_max, device_kernel_group->scrypt_tmp_size);
 
-        return -1;
+        #if defined (DEBUG)
+        if (user_options->quiet == false) event_log_warning (hashcat_ctx, "SCRYPT N=%u r=%u p=%u: tmto optimizer value set to: %u, mem: %" PRIu64, scrypt_N, scrypt_r, scrypt_p, tmto, size_scrypt_group);
+        #endif
       }
 
+      hashconfig->tmp_size = scrypt_tmp_size_max;
+
       #if defined (DEBUG)
-      if (user_options->quiet == false) event_log_warning (hashcat_ctx, "SCRYPT tmto optimizer value set to: %u, mem: %" PRIu64, scrypt_tmto_final, size_scrypt);
       if (user_options->quiet == false) event_log_warning (hashcat_ctx, "");
       #endif
     }
@@ -3311,6 +4592,7 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
         + bitmap_ctx->bitmap_size
         + size_bfs
         + size_combs
+        + size_combs_all
         + size_digests
         + size_esalts
         + size_hooks
@@ -3335,6 +4617,15 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
 
       if (memory_limit_hit == 1)
       {
+        // rather stream the amplifiers than lower the amplifier
+
+        if (size_combs_all)
+        {
+          size_combs_all = 0;
+
+          continue;
+        }
+
         kernel_accel_max--;
 
         continue;
@@ -3353,6 +4644,8 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
     device_param->kernel_accel_min = kernel_accel_min;
     device_param->kernel_accel_max = kernel_accel_max;
 
+    device_param->kernel_loops_max_orig = device_param->kernel_loops_max;
+
     /*
     if (kernel_accel_max < kernel_accel)
     {
@@ -3362,13 +4655,16 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
     }
     */
 
-    device_param->size_bfs     = size_bfs;
-    device_param->size_combs   = size_combs;
-    device_param->size_rules   = size_rules;
-    device_param->size_rules_c = size_rules_c;
-    device_param->size_pws     = size_pws;
-    device_param->size_tmps    = size_tmps;
-    device_param->size_hooks   = size_hooks;
+    device_param->size_bfs       = size_bfs;
+    device_param->size_combs     = size_combs;
+    device_param->size_combs_all = size_combs_all;
+
+    device_param->combs_resident = (size_combs_all > 0);
+    device_param->size_rules     = size_rules;
+    device_param->size_rules_c   = size_rules_c;
+    device_param->size_pws       = size_pws;
+    device_param->size_tmps      = size_tmps;
+    device_param->size_hooks     = size_hooks;
 
     /**
      * default building options
@@ -3381,14 +4677,6 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
       return -1;
     }
 
-    char build_opts[1024] = { 0 };
-
-    #if defined (_WIN)
-    snprintf (build_opts, sizeof (build_opts) - 1, "-I \"%s\"", folder_config->cpath_real);
-    #else
-    snprintf (build_opts, sizeof (build_opts) - 1, "-I %s", folder_config->cpath_real);
-    #endif
-
     // include check
     // this test needs to be done manually because of osx opencl runtime
     // if there's a problem with permission, its not reporting back and erroring out silently
@@ -3439,17 +4727,9 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
       fclose (fd);
     }
 
-    // we don't have sm_* on vendors not NV but it doesn't matter
-
-    char build_opts_new[1024] = { 0 };
-
-    #if defined (DEBUG)
-    snprintf (build_opts_new, sizeof (build_opts_new) - 1, "%s -D VENDOR_ID=%u -D CUDA_ARCH=%d -D VECT_SIZE=%u -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D _unroll -cl-std=CL1.1", build_opts, device_param->device_vendor_id, (device_param->sm_major * 100) + device_param->sm_minor, device_param->vector_width, (u32) device_param->device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, hashconfig->kern_type);
-    #else
-    snprintf (build_opts_new, sizeof (build_opts_new) - 1, "%s -D VENDOR_ID=%u -D CUDA_ARCH=%d -D VECT_SIZE=%u -D DEVICE_TYPE=%u -D DGST_R0=%u -D DGST_R1=%u -D DGST_R2=%u -D DGST_R3=%u -D DGST_ELEM=%u -D KERN_TYPE=%u -D _unroll -cl-std=CL1.1 -w", build_opts, device_param->device_vendor_id, (device_param->sm_major * 100) + device_param->sm_minor, device_param->vector_width, (u32) device_param->device_type, hashconfig->dgst_pos0, hashconfig->dgst_pos1, hashconfig->dgst_pos2, hashconfig->dgst_pos3, hashconfig->dgst_size / 4, hashconfig->kern_type);
-    #endif
+    char build_opts[1024] = { 0 };
 
-    strncpy (build_opts, build_opts_new, sizeof (build_opts));
+    generate_build_opts (hashcat_ctx, device_param, build_opts, sizeof (build_opts));
 
     #if defined (DEBUG)
     event_log_warning (hashcat_ctx, "* Device #%u: build_opts '%s'", device_id + 1, build_opts);
@@ -3481,9 +4761,15 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
        * kernel cached filename
        */
 
+      char kernel_key[17] = { 0 };
+
+      const int rc_kernel_key = generate_kernel_cache_key (hashcat_ctx, source_file, build_opts, kernel_key);
+
+      if (rc_kernel_key == -1) return -1;
+
       char cached_file[256] = { 0 };
 
-      generate_cached_kernel_filename (hashconfig->attack_exec, user_options_extra->attack_kern, hashconfig->kern_type, folder_config->profile_dir, device_name_chksum, cached_file);
+      generate_cached_kernel_filename (hashconfig->attack_exec, user_options_extra->attack_kern, hashconfig->kern_type, folder_config->profile_dir, device_name_chksum, kernel_key, cached_file);
 
       int cached = 1;
 
@@ -3601,62 +4887,118 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
 
         if (rc_read_kernel == -1) return -1;
 
-        CL_rc = hc_clCreateProgramWithSource (hashcat_ctx, device_param->context, 1, (const char **) kernel_sources, NULL, &device_param->program);
+        // one program per kernel group, device_param->program ends up with the first one
+        // the group parameters are part of the build options and so of the cache key, a group without them shares the generic kernel
 
-        if (CL_rc == -1) return -1;
+        for (u32 group_pos = opencl_ctx->kernel_groups_cnt; group_pos-- > 0;)
+        {
+          char build_opts_update[1024] = { 0 };
 
-        char build_opts_update[1024] = { 0 };
+          generate_kernel_group_build_opts (opencl_ctx, device_param, group_pos, build_opts, build_opts_update, sizeof (build_opts_update));
 
-        if (opencl_ctx->force_jit_compilation == 1500)
-        {
-          snprintf (build_opts_update, sizeof (build_opts_update) - 1, "%s -DDESCRYPT_SALT=%u", build_opts, hashes->salts_buf[0].salt_buf[0]);
-        }
-        else if (opencl_ctx->force_jit_compilation == 8900)
-        {
-          snprintf (build_opts_update, sizeof (build_opts_update) - 1, "%s -DSCRYPT_N=%u -DSCRYPT_R=%u -DSCRYPT_P=%u -DSCRYPT_TMTO=%u -DSCRYPT_TMP_ELEM=%u", build_opts, hashes->salts_buf[0].scrypt_N, hashes->salts_buf[0].scrypt_r, hashes->salts_buf[0].scrypt_p, 1 << scrypt_tmto_final, scrypt_tmp_size / 16);
-        }
-        else
-        {
-          snprintf (build_opts_update, sizeof (build_opts_update) - 1, "%s", build_opts);
-        }
+          char group_key[17] = { 0 };
 
-        CL_rc = hc_clBuildProgram (hashcat_ctx, device_param->program, 1, &device_param->device, build_opts_update, NULL, NULL);
+          const int rc_group_key = generate_kernel_cache_key (hashcat_ctx, source_file, build_opts_update, group_key);
 
-        //if (CL_rc == -1) return -1;
+          if (rc_group_key == -1) return -1;
 
-        size_t build_log_size = 0;
+          char group_cached_file[256] = { 0 };
 
-        hc_clGetProgramBuildInfo (hashcat_ctx, device_param->program, device_param->device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+          generate_cached_kernel_filename (hashconfig->attack_exec, user_options_extra->attack_kern, hashconfig->kern_type, folder_config->profile_dir, device_name_chksum, group_key, group_cached_file);
 
-        //if (CL_rc == -1) return -1;
+          struct stat gst;
 
-        #if defined (DEBUG)
-        if ((build_log_size != 0) || (CL_rc == -1))
-        #else
-        if (CL_rc == -1)
-        #endif
-        {
-          char *build_log = (char *) hcmalloc (hashcat_ctx, build_log_size + 1); VERIFY_PTR (build_log);
+          if ((stat (group_cached_file, &gst) == 0) && (gst.st_size > 0))
+          {
+            size_t group_length = 0;
 
-          int CL_rc_build = hc_clGetProgramBuildInfo (hashcat_ctx, device_param->program, device_param->device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
+            char *group_binary = NULL;
 
-          if (CL_rc_build == -1) return -1;
+            const int rc_read_group = read_kernel_binary (hashcat_ctx, group_cached_file, 1, &group_length, &group_binary);
 
-          puts (build_log);
+            if (rc_read_group == -1) return -1;
 
-          hcfree (build_log);
-        }
+            CL_rc = hc_clCreateProgramWithBinary (hashcat_ctx, device_param->context, 1, &device_param->device, &group_length, (const unsigned char **) &group_binary, NULL, &device_param->program);
 
-        if (CL_rc == -1)
-        {
-          device_param->skipped = true;
+            hcfree (group_binary);
 
-          event_log_error (hashcat_ctx, "Device #%u: Kernel %s build failure. Proceeding without this device.", device_id + 1, source_file);
+            if (CL_rc == -1) return -1;
 
-          continue;
+            device_param->kernel_groups[group_pos].program = device_param->program;
+
+            CL_rc = hc_clBuildProgram (hashcat_ctx, device_param->program, 1, &device_param->device, build_opts_update, NULL, NULL);
+
+            if (CL_rc == -1) return -1;
+
+            continue;
+          }
+
+          CL_rc = hc_clCreateProgramWithSource (hashcat_ctx, device_param->context, 1, (const char **) kernel_sources, NULL, &device_param->program);
+
+          if (CL_rc == -1) return -1;
+
+          device_param->kernel_groups[group_pos].program = device_param->program;
+
+          CL_rc = hc_clBuildProgram (hashcat_ctx, device_param->program, 1, &device_param->device, build_opts_update, NULL, NULL);
+
+          //if (CL_rc == -1) return -1;
+
+          size_t build_log_size = 0;
+
+          hc_clGetProgramBuildInfo (hashcat_ctx, device_param->program, device_param->device, CL_PROGRAM_BUILD_LOG, 0, NULL, &build_log_size);
+
+          //if (CL_rc == -1) return -1;
+
+          #if defined (DEBUG)
+          if ((build_log_size != 0) || (CL_rc == -1))
+          #else
+          if (CL_rc == -1)
+          #endif
+          {
+            char *build_log = (char *) hcmalloc (hashcat_ctx, build_log_size + 1); VERIFY_PTR (build_log);
+
+            int CL_rc_build = hc_clGetProgramBuildInfo (hashcat_ctx, device_param->program, device_param->device, CL_PROGRAM_BUILD_LOG, build_log_size, build_log, NULL);
+
+            if (CL_rc_build == -1) return -1;
+
+            puts (build_log);
+
+            hcfree (build_log);
+          }
+
+          if (CL_rc == -1)
+          {
+            device_param->skipped = true;
+
+            event_log_error (hashcat_ctx, "Device #%u: Kernel %s build failure. Proceeding without this device.", device_id + 1, source_file);
+
+            break;
+          }
+
+          size_t binary_size;
+
+          CL_rc = hc_clGetProgramInfo (hashcat_ctx, device_param->program, CL_PROGRAM_BINARY_SIZES, sizeof (size_t), &binary_size, NULL);
+
+          if (CL_rc == -1) return -1;
+
+          char *binary = (char *) hcmalloc (hashcat_ctx, binary_size); VERIFY_PTR (binary);
+
+          CL_rc = hc_clGetProgramInfo (hashcat_ctx, device_param->program, CL_PROGRAM_BINARIES, sizeof (binary), &binary, NULL);
+
+          if (CL_rc == -1) return -1;
+
+          const int rc_write = write_kernel_binary (hashcat_ctx, group_cached_file, binary, binary_size);
+
+          if (rc_write == -1) return -1;
+
+          hcfree (binary);
         }
+
+        if (device_param->skipped == true) continue;
       }
 
+      device_param->kernel_groups[0].program = device_param->program;
+
       hcfree (kernel_lengths);
       hcfree (kernel_sources[0]);
       hcfree (kernel_sources);
@@ -3689,9 +5031,15 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
        * kernel mp cached filename
        */
 
+      char kernel_key[17] = { 0 };
+
+      const int rc_kernel_key = generate_kernel_cache_key (hashcat_ctx, source_file, build_opts, kernel_key);
+
+      if (rc_kernel_key == -1) return -1;
+
       char cached_file[256] = { 0 };
 
-      generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->profile_dir, device_name_chksum, cached_file);
+      generate_cached_kernel_mp_filename (hashconfig->opti_type, hashconfig->opts_type, folder_config->profile_dir, device_name_chksum, kernel_key, cached_file);
 
       int cached = 1;
 
@@ -3831,9 +5179,15 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
        * kernel amp cached filename
        */
 
+      char kernel_key[17] = { 0 };
+
+      const int rc_kernel_key = generate_kernel_cache_key (hashcat_ctx, source_file, build_opts, kernel_key);
+
+      if (rc_kernel_key == -1) return -1;
+
       char cached_file[256] = { 0 };
 
-      generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->profile_dir, device_name_chksum, cached_file);
+      generate_cached_kernel_amp_filename (user_options_extra->attack_kern, folder_config->profile_dir, device_name_chksum, kernel_key, cached_file);
 
       int cached = 1;
 
@@ -4012,7 +5366,9 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
     }
     else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
     {
-      CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->d_combs);          if (CL_rc == -1) return -1;
+      const size_t size_combs_d = (device_param->combs_resident == true) ? size_combs_all : size_combs;
+
+      CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_combs_d,    NULL, &device_param->d_combs);          if (CL_rc == -1) return -1;
       CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_combs,      NULL, &device_param->d_combs_c);        if (CL_rc == -1) return -1;
       CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_root_css,   NULL, &device_param->d_root_css_buf);   if (CL_rc == -1) return -1;
       CL_rc = hc_clCreateBuffer (hashcat_ctx, device_param->context, CL_MEM_READ_ONLY, size_markov_css, NULL, &device_param->d_markov_css_buf); if (CL_rc == -1) return -1;
@@ -4189,134 +5545,150 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     char kernel_name[64] = { 0 };
 
-    if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
+    // the kernels of every group, the loop runs backwards so the first group is the active one afterwards
+
+    for (u32 group_pos = opencl_ctx->kernel_groups_cnt; group_pos-- > 0;)
     {
-      if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
+      device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
+      device_param->program = device_kernel_group->program;
+
+      if (hashconfig->attack_exec == ATTACK_EXEC_INSIDE_KERNEL)
       {
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 4);
+        if (hashconfig->opti_type & OPTI_TYPE_SINGLE_HASH)
+        {
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 4);
 
-        CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel1);
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel1);
 
-        if (CL_rc == -1) return -1;
+          if (CL_rc == -1) return -1;
 
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 8);
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 8);
 
-        CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel2);
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel2);
 
-        if (CL_rc == -1) return -1;
+          if (CL_rc == -1) return -1;
 
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 16);
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_s%02d", hashconfig->kern_type, 16);
 
-        CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel3);
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel3);
 
-        if (CL_rc == -1) return -1;
+          if (CL_rc == -1) return -1;
+        }
+        else
+        {
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 4);
+
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel1);
+
+          if (CL_rc == -1) return -1;
+
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 8);
+
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel2);
+
+          if (CL_rc == -1) return -1;
+
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 16);
+
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel3);
+
+          if (CL_rc == -1) return -1;
+        }
+
+        if (user_options->attack_mode == ATTACK_MODE_BF)
+        {
+          if (hashconfig->opts_type & OPTS_TYPE_PT_BITSLICE)
+          {
+            snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_tm", hashconfig->kern_type);
+
+            CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel_tm);
+
+            if (CL_rc == -1) return -1;
+
+            CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel_tm, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
+
+            if (CL_rc == -1) return -1;
+          }
+        }
       }
       else
       {
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 4);
+        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_init", hashconfig->kern_type);
 
         CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel1);
 
         if (CL_rc == -1) return -1;
 
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 8);
+        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_loop", hashconfig->kern_type);
 
         CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel2);
 
         if (CL_rc == -1) return -1;
 
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_m%02d", hashconfig->kern_type, 16);
+        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_comp", hashconfig->kern_type);
 
         CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel3);
 
         if (CL_rc == -1) return -1;
-      }
 
-      if (user_options->attack_mode == ATTACK_MODE_BF)
-      {
-        if (hashconfig->opts_type & OPTS_TYPE_PT_BITSLICE)
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
         {
-          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_tm", hashconfig->kern_type);
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_hook12", hashconfig->kern_type);
 
-          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel_tm);
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel12);
 
           if (CL_rc == -1) return -1;
 
-          CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel_tm, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
+          CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel12, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
 
           if (CL_rc == -1) return -1;
         }
-      }
-    }
-    else
-    {
-      snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_init", hashconfig->kern_type);
-
-      CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel1);
-
-      if (CL_rc == -1) return -1;
 
-      snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_loop", hashconfig->kern_type);
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
+        {
+          snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_hook23", hashconfig->kern_type);
 
-      CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel2);
+          CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel23);
 
-      if (CL_rc == -1) return -1;
+          if (CL_rc == -1) return -1;
 
-      snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_comp", hashconfig->kern_type);
+          CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel23, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
 
-      CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel3);
+          if (CL_rc == -1) return -1;
+        }
+      }
 
-      if (CL_rc == -1) return -1;
+      CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel1, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
+      CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel2, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
+      CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel3, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
 
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK12)
+      for (u32 i = 0; i <= 23; i++)
       {
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_hook12", hashconfig->kern_type);
-
-        CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel12);
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel1, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel2, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel3, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
 
-        if (CL_rc == -1) return -1;
-
-        CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel12, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
-
-        if (CL_rc == -1) return -1;
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel12, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel23, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
       }
 
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK23)
+      for (u32 i = 24; i <= 34; i++)
       {
-        snprintf (kernel_name, sizeof (kernel_name) - 1, "m%05d_hook23", hashconfig->kern_type);
-
-        CL_rc = hc_clCreateKernel (hashcat_ctx, device_param->program, kernel_name, &device_param->kernel23);
-
-        if (CL_rc == -1) return -1;
-
-        CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel23, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp);
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel1, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel2, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
+        CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel3, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
 
-        if (CL_rc == -1) return -1;
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel12, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+        if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel23, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
       }
-    }
-
-    CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel1, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
-    CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel2, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
-    CL_rc = hc_clGetKernelWorkGroupInfo (hashcat_ctx, device_param->kernel3, device_param->device, CL_KERNEL_WORK_GROUP_SIZE, sizeof (size_t), &kernel_wgs_tmp, NULL); kernel_threads = MIN (kernel_threads, kernel_wgs_tmp); if (CL_rc == -1) return -1;
-
-    for (u32 i = 0; i <= 23; i++)
-    {
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel1, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel2, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel3, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
-
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel12, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel23, i, sizeof (cl_mem), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
-    }
-
-    for (u32 i = 24; i <= 34; i++)
-    {
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel1, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel2, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
-      CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel3, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1;
 
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK12) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel12, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
-      if (hashconfig->opts_type & OPTS_TYPE_HOOK23) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel23, i, sizeof (cl_uint), device_param->kernel_params[i]); if (CL_rc == -1) return -1; }
+      device_kernel_group->kernel1   = device_param->kernel1;
+      device_kernel_group->kernel12  = device_param->kernel12;
+      device_kernel_group->kernel2   = device_param->kernel2;
+      device_kernel_group->kernel23  = device_param->kernel23;
+      device_kernel_group->kernel3   = device_param->kernel3;
+      device_kernel_group->kernel_tm = device_param->kernel_tm;
     }
 
     // GPU memset
@@ -4413,36 +5785,9 @@ int opencl_session_begin (hashcat_ctx_t *hashcat_ctx)
 
     // zero some data buffers
 
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_pws_buf,     size_pws);      if (CL_rc == -1) return -1;
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_pws_amp_buf, size_pws);      if (CL_rc == -1) return -1;
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_tmps,        size_tmps);     if (CL_rc == -1) return -1;
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_hooks,       size_hooks);    if (CL_rc == -1) return -1;
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_plain_bufs,  size_plains);   if (CL_rc == -1) return -1;
-    CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_result,      size_results);  if (CL_rc == -1) return -1;
-
-    /**
-     * special buffers
-     */
+    CL_rc = opencl_session_bzero (hashcat_ctx, device_param);
 
-    if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
-    {
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_rules_c, size_rules_c);
-    }
-    else if (user_options_extra->attack_kern == ATTACK_KERN_COMBI)
-    {
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_combs,          size_combs);       if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_combs_c,        size_combs);       if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_root_css_buf,   size_root_css);    if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_markov_css_buf, size_markov_css);  if (CL_rc == -1) return -1;
-    }
-    else if (user_options_extra->attack_kern == ATTACK_KERN_BF)
-    {
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_bfs,            size_bfs);         if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_bfs_c,          size_bfs);         if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_tm_c,           size_tm);          if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_root_css_buf,   size_root_css);    if (CL_rc == -1) return -1;
-      CL_rc = run_kernel_bzero (hashcat_ctx, device_param, device_param->d_markov_css_buf, size_markov_css);  if (CL_rc == -1) return -1;
-    }
+    if (CL_rc == -1) return -1;
 
     if ((user_options->attack_mode == ATTACK_MODE_HYBRID1) || (user_options->attack_mode == ATTACK_MODE_HYBRID2))
     {
@@ -4515,6 +5860,14 @@ void opencl_session_destroy (hashcat_ctx_t *hashcat_ctx)
     hcfree (device_param->combs_buf);
     hcfree (device_param->hooks_buf);
 
+    hcfree (device_param->words_claimed_buf);
+
+    device_param->words_claimed_buf   = NULL;
+    device_param->words_claimed_cnt   = 0;
+    device_param->words_claimed_avail = 0;
+
+    host_backend_session_destroy (device_param);
+
     if (device_param->d_pws_buf)        hc_clReleaseMemObject (hashcat_ctx, device_param->d_pws_buf);
     if (device_param->d_pws_amp_buf)    hc_clReleaseMemObject (hashcat_ctx, device_param->d_pws_amp_buf);
     if (device_param->d_rules)          hc_clReleaseMemObject (hashcat_ctx, device_param->d_rules);
@@ -4547,6 +5900,27 @@ void opencl_session_destroy (hashcat_ctx_t *hashcat_ctx)
     if (device_param->d_markov_css_buf) hc_clReleaseMemObject (hashcat_ctx, device_param->d_markov_css_buf);
     if (device_param->d_tm_c)           hc_clReleaseMemObject (hashcat_ctx, device_param->d_tm_c);
 
+    // the first kernel group is released below, it's the one in kernel1 .. and program
+
+    if (device_param->kernel_groups)
+    {
+      for (u32 group_pos = 1; group_pos < opencl_ctx->kernel_groups_cnt; group_pos++)
+      {
+        device_kernel_group_t *device_kernel_group = &device_param->kernel_groups[group_pos];
+
+        if (device_kernel_group->kernel1)   hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel1);
+        if (device_kernel_group->kernel12)  hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel12);
+        if (device_kernel_group->kernel2)   hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel2);
+        if (device_kernel_group->kernel23)  hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel23);
+        if (device_kernel_group->kernel3)   hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel3);
+        if (device_kernel_group->kernel_tm) hc_clReleaseKernel (hashcat_ctx, device_kernel_group->kernel_tm);
+
+        if (device_kernel_group->program)   hc_clReleaseProgram (hashcat_ctx, device_kernel_group->program);
+      }
+
+      hcfree (device_param->kernel_groups);
+    }
+
     if (device_param->kernel1)          hc_clReleaseKernel (hashcat_ctx, device_param->kernel1);
     if (device_param->kernel12)         hc_clReleaseKernel (hashcat_ctx, device_param->kernel12);
     if (device_param->kernel2)          hc_clReleaseKernel (hashcat_ctx, device_param->kernel2);
@@ -4569,6 +5943,7 @@ void opencl_session_destroy (hashcat_ctx_t *hashcat_ctx)
 
     device_param->pws_buf           = NULL;
     device_param->combs_buf         = NULL;
+    device_param->combs_resident    = false;
     device_param->hooks_buf         = NULL;
 
     device_param->d_pws_buf         = NULL;
@@ -4618,7 +5993,39 @@ void opencl_session_destroy (hashcat_ctx_t *hashcat_ctx)
     device_param->program_amp       = NULL;
     device_param->command_queue     = NULL;
     device_param->context           = NULL;
+    device_param->kernel_groups     = NULL;
+  }
+
+  hcfree (opencl_ctx->kernel_groups);
+  hcfree (opencl_ctx->salts_kernel_group);
+
+  opencl_ctx->kernel_groups      = NULL;
+  opencl_ctx->kernel_groups_cnt  = 0;
+  opencl_ctx->salts_kernel_group = NULL;
+
+  opencl_ctx->session_kept = false;
+}
+
+void opencl_session_keep (hashcat_ctx_t *hashcat_ctx)
+{
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  if (opencl_ctx->enabled == false) return;
+
+  // the JIT kernels are built for the salts of this hashlist and the host backend has nothing to build
+
+  if ((opencl_ctx->host_backend == true) || (opencl_ctx->force_jit_compilation != -1))
+  {
+    opencl_session_destroy (hashcat_ctx);
+
+    return;
   }
+
+  // the next outer loop, usually a job from hashcat_session_run_job (), decides in opencl_session_begin () whether it can use it
+
+  opencl_session_key (hashcat_ctx, &opencl_ctx->session_key);
+
+  opencl_ctx->session_kept = true;
 }
 
 void opencl_session_reset (hashcat_ctx_t *hashcat_ctx)
@@ -4655,6 +6062,8 @@ void opencl_session_reset (hashcat_ctx_t *hashcat_ctx)
 
     device_param->words_off  = 0;
     device_param->words_done = 0;
+
+    device_param->words_claimed_cnt = 0;
   }
 
   opencl_ctx->kernel_power_all   = 0;
@@ -4679,6 +6088,8 @@ int opencl_session_update_combinator (hashcat_ctx_t *hashcat_ctx)
 
     device_param->kernel_params_buf32[33] = combinator_ctx->combs_mode;
 
+    if (device_param->is_host == true) continue;
+
     int CL_rc;
 
     CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel1, 33, sizeof (cl_uint), device_param->kernel_params[33]); if (CL_rc == -1) return -1;
@@ -4719,6 +6130,8 @@ int opencl_session_update_mp (hashcat_ctx_t *hashcat_ctx)
     device_param->kernel_params_mp_buf64[3] = 0;
     device_param->kernel_params_mp_buf32[4] = mask_ctx->css_cnt;
 
+    if (device_param->is_host == true) continue;
+
     int CL_rc = CL_SUCCESS;
 
     for (u32 i = 3; i < 4; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel_mp, i, sizeof (cl_ulong), (void *) device_param->kernel_params_mp[i]); if (CL_rc == -1) return -1; }
@@ -4751,6 +6164,8 @@ int opencl_session_update_mp_rl (hashcat_ctx_t *hashcat_ctx, const u32 css_cnt_l
     device_param->kernel_params_mp_r_buf64[3] = 0;
     device_param->kernel_params_mp_r_buf32[4] = css_cnt_r;
 
+    if (device_param->is_host == true) continue;
+
     int CL_rc = CL_SUCCESS;
 
     for (u32 i = 3; i < 4; i++) { CL_rc = hc_clSetKernelArg (hashcat_ctx, device_param->kernel_mp_l, i, sizeof (cl_ulong), (void *) device_param->kernel_params_mp_l[i]); if (CL_rc == -1) return -1; }
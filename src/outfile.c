@@ -47,9 +47,14 @@ int build_plain (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, pl
 
     plain_len = (int) pw.pw_len;
 
-    const u32 off = device_param->innerloop_pos + il_pos;
+    // with host-side rules the candidate on the device is the final plain already
 
-    plain_len = (int) apply_rules (straight_ctx->kernel_rules_buf[off].cmds, &plain_buf[0], &plain_buf[4], (u32) plain_len);
+    if (device_param->host_rules == false)
+    {
+      const u32 off = device_param->innerloop_pos + il_pos;
+
+      plain_len = (int) apply_rules (straight_ctx->kernel_rules_buf[off].cmds, &plain_buf[0], &plain_buf[4], (u32) plain_len);
+    }
 
     if (plain_len > (int) hashconfig->pw_max) plain_len = (int) hashconfig->pw_max;
   }
@@ -207,7 +212,12 @@ int build_crackpos (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param,
 
   u64 crackpos = device_param->words_off;
 
-  if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
+  if ((user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT) && (device_param->host_rules == true))
+  {
+    crackpos *= straight_ctx->kernel_rules_cnt;
+    crackpos += device_param->host_rules_pos_buf[gidvid];
+  }
+  else if (user_options_extra->attack_kern == ATTACK_KERN_STRAIGHT)
   {
     crackpos += gidvid;
     crackpos *= straight_ctx->kernel_rules_cnt;
@@ -248,18 +258,33 @@ int build_debugdata (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param
 
   pw_t pw;
 
-  const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
+  u32 off = device_param->innerloop_pos + il_pos;
 
-  if (rc == -1) return -1;
+  if (device_param->host_rules == true)
+  {
+    // the device only knows the final candidate, map it back to word and rule
 
-  int plain_len = (int) pw.pw_len;
+    const u32 pos = device_param->host_rules_pos_buf[gidvid];
 
-  const u32 off = device_param->innerloop_pos + il_pos;
+    pw = device_param->host_rules_base_buf[pos / straight_ctx->kernel_rules_cnt];
+
+    off = pos % straight_ctx->kernel_rules_cnt;
+  }
+  else
+  {
+    const int rc = gidd_to_pw_t (hashcat_ctx, device_param, gidvid, &pw);
+
+    if (rc == -1) return -1;
+  }
+
+  int plain_len = (int) pw.pw_len;
 
   // save rule
   if ((debug_mode == 1) || (debug_mode == 3) || (debug_mode == 4))
   {
-    *debug_rule_len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &straight_ctx->kernel_rules_buf[off]);
+    kernel_rule_t *debug_rules_buf = (straight_ctx->kernel_rules_buf_orig) ? straight_ctx->kernel_rules_buf_orig : straight_ctx->kernel_rules_buf;
+
+    *debug_rule_len = kernel_rule_to_cpu_rule ((char *) debug_rule_buf, &debug_rules_buf[off]);
   }
 
   // save plain
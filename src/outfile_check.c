@@ -16,12 +16,233 @@
 #include "shared.h"
 #include "thread.h"
 
+static u32 outfile_check_hash (const u32 *digest, const salt_t *salt, const hashconfig_t *hashconfig)
+{
+  // same words as sort_by_digest_p0p1 () and the part of sort_by_salt () which tells salts apart
+
+  u32 hash = 0x811c9dc5;
+
+  hash = (hash ^ digest[hashconfig->dgst_pos0]) * 0x01000193;
+  hash = (hash ^ digest[hashconfig->dgst_pos1]) * 0x01000193;
+  hash = (hash ^ digest[hashconfig->dgst_pos2]) * 0x01000193;
+  hash = (hash ^ digest[hashconfig->dgst_pos3]) * 0x01000193;
+
+  if (salt != NULL)
+  {
+    hash = (hash ^ salt->salt_len) * 0x01000193;
+
+    for (u32 i = 0; i < 16; i++)
+    {
+      hash = (hash ^ salt->salt_buf[i]) * 0x01000193;
+    }
+  }
+
+  return hash ^ (hash >> 16);
+}
+
+static int outfile_check_index_init (hashcat_ctx_t *hashcat_ctx, outfile_check_index_t *index)
+{
+  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  hashes_t     *hashes     = hashcat_ctx->hashes;
+
+  // load factor stays below 2/3, linear probing is fine with that
+
+  u32 index_size = 1024;
+
+  while (index_size < (hashes->digests_cnt + (hashes->digests_cnt / 2))) index_size <<= 1;
+
+  index->slots     = (u32 *) hccalloc (hashcat_ctx, index_size,          sizeof (u32)); VERIFY_PTR (index->slots);
+  index->salts_pos = (u32 *) hccalloc (hashcat_ctx, hashes->digests_cnt, sizeof (u32)); VERIFY_PTR (index->salts_pos);
+  index->mask      = index_size - 1;
+
+  const u32 dgst_size = hashconfig->dgst_size;
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+    for (u32 digest_pos = 0; digest_pos < salt_buf->digests_cnt; digest_pos++)
+    {
+      const u32 idx = salt_buf->digests_offset + digest_pos;
+
+      const u32 *digest = (const u32 *) ((const char *) hashes->digests_buf + (idx * dgst_size));
+
+      u32 slot = outfile_check_hash (digest, (hashconfig->is_salted) ? salt_buf : NULL, hashconfig) & index->mask;
+
+      while (index->slots[slot] != 0) slot = (slot + 1) & index->mask;
+
+      index->slots[slot] = idx + 1;
+
+      index->salts_pos[idx] = salt_pos;
+    }
+  }
+
+  return 0;
+}
+
+static void outfile_check_index_destroy (outfile_check_index_t *index)
+{
+  hcfree (index->slots);
+  hcfree (index->salts_pos);
+
+  memset (index, 0, sizeof (outfile_check_index_t));
+}
+
+static void outfile_check_mark_cracked (hashcat_ctx_t *hashcat_ctx, const u32 salt_pos, const u32 idx)
+{
+  hashes_t *hashes = hashcat_ctx->hashes;
+
+  salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+  hashes->digests_shown[idx] = 1;
+
+  hashes->digests_done++;
+
+  salt_buf->digests_done++;
+
+  if (salt_buf->digests_done == salt_buf->digests_cnt)
+  {
+    hashes->salts_shown[salt_pos] = 1;
+
+    hashes->salts_done++;
+
+    if (hashes->salts_done == hashes->salts_cnt) mycracked (hashcat_ctx);
+  }
+}
+
+static u32 outfile_check_index_find (hashcat_ctx_t *hashcat_ctx, const outfile_check_index_t *index, const hash_t *hash_buf)
+{
+  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  hashes_t     *hashes     = hashcat_ctx->hashes;
+
+  const u32 dgst_size = hashconfig->dgst_size;
+
+  // equal digests with different salts share a slot chain, so compare both
+
+  u32 slot = outfile_check_hash (hash_buf->digest, (hashconfig->is_salted) ? hash_buf->salt : NULL, hashconfig) & index->mask;
+
+  while (index->slots[slot] != 0)
+  {
+    const u32 idx = index->slots[slot] - 1;
+
+    slot = (slot + 1) & index->mask;
+
+    if (hashes->digests_shown[idx] == 1) continue;
+
+    const u32 salt_pos = index->salts_pos[idx];
+
+    if (hashes->salts_shown[salt_pos] == 1) continue;
+
+    const void *digest = (const char *) hashes->digests_buf + (idx * dgst_size);
+
+    if (sort_by_digest_p0p1 (digest, hash_buf->digest, hashconfig) != 0) continue;
+
+    if (hashconfig->is_salted)
+    {
+      if (sort_by_salt (&hashes->salts_buf[salt_pos], hash_buf->salt) != 0) continue;
+    }
+
+    outfile_check_mark_cracked (hashcat_ctx, salt_pos, idx);
+
+    return 1;
+  }
+
+  return 0;
+}
+
+static u32 outfile_check_salts_find (hashcat_ctx_t *hashcat_ctx, const char *line_buf, const u32 i)
+{
+  hashconfig_t *hashconfig = hashcat_ctx->hashconfig;
+  hashes_t     *hashes     = hashcat_ctx->hashes;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  const u32 hash_mode = hashconfig->hash_mode;
+
+  // 2500 and 6800 are matched by their salt, these lists are short
+
+  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  {
+    if (hashes->salts_shown[salt_pos] == 1) continue;
+
+    salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+
+    for (u32 digest_pos = 0; digest_pos < salt_buf->digests_cnt; digest_pos++)
+    {
+      u32 idx = salt_buf->digests_offset + digest_pos;
+
+      if (hashes->digests_shown[idx] == 1) continue;
+
+      u32 cracked = 0;
+
+      if (hash_mode == 6800)
+      {
+        if (i == salt_buf->salt_len)
+        {
+          cracked = (memcmp (line_buf, salt_buf->salt_buf, salt_buf->salt_len) == 0);
+        }
+      }
+      else if (hash_mode == 2500)
+      {
+        // BSSID : MAC1 : MAC2 (:plain)
+        if (i == (salt_buf->salt_len + 1 + 12 + 1 + 12))
+        {
+          cracked = (memcmp (line_buf, salt_buf->salt_buf, salt_buf->salt_len) == 0);
+
+          if (!cracked) continue;
+
+          // now compare MAC1 and MAC2 too, since we have this additional info
+          const char *mac1_pos = line_buf + salt_buf->salt_len + 1;
+          const char *mac2_pos = mac1_pos + 12 + 1;
+
+          wpa_t *wpas = (wpa_t *) hashes->esalts_buf;
+          wpa_t *wpa  = &wpas[salt_pos];
+
+          // compare hex string(s) vs binary MAC address(es)
+
+          for (u32 i = 0, j = 0; i < 6; i++, j += 2)
+          {
+            if (wpa->orig_mac1[i] != hex_to_u8 ((const u8 *) &mac1_pos[j]))
+            {
+              cracked = 0;
+
+              break;
+            }
+          }
+
+          // early skip ;)
+          if (!cracked) continue;
+
+          for (u32 i = 0, j = 0; i < 6; i++, j += 2)
+          {
+            if (wpa->orig_mac2[i] != hex_to_u8 ((const u8 *) &mac2_pos[j]))
+            {
+              cracked = 0;
+
+              break;
+            }
+          }
+        }
+      }
+
+      if (cracked == 1)
+      {
+        outfile_check_mark_cracked (hashcat_ctx, salt_pos, idx);
+
+        return 1;
+      }
+    }
+
+    if (status_ctx->devices_status == STATUS_CRACKED) break;
+  }
+
+  return 0;
+}
+
 static int outfile_remove (hashcat_ctx_t *hashcat_ctx)
 {
   // some hash-dependent constants
 
   hashconfig_t   *hashconfig   = hashcat_ctx->hashconfig;
-  hashes_t       *hashes       = hashcat_ctx->hashes;
   outcheck_ctx_t *outcheck_ctx = hashcat_ctx->outcheck_ctx;
   status_ctx_t   *status_ctx   = hashcat_ctx->status_ctx;
   user_options_t *user_options = hashcat_ctx->user_options;
@@ -40,264 +261,252 @@ static int outfile_remove (hashcat_ctx_t *hashcat_ctx)
 
   hash_buf.digest = hcmalloc (hashcat_ctx, dgst_size); VERIFY_PTR (hash_buf.digest);
 
-  if (is_salted)  hash_buf.salt =  (salt_t *) hcmalloc (hashcat_ctx, sizeof (salt_t));  VERIFY_PTR (hash_buf.salt);
-  if (esalt_size) hash_buf.esalt = (void   *) hcmalloc (hashcat_ctx, esalt_size);       VERIFY_PTR (hash_buf.esalt);
-
-  u32 digest_buf[64] = { 0 };
+  if (is_salted)
+  {
+    hash_buf.salt = (salt_t *) hcmalloc (hashcat_ctx, sizeof (salt_t)); VERIFY_PTR (hash_buf.salt);
+  }
 
-  outfile_data_t *out_info = NULL;
+  if (esalt_size)
+  {
+    hash_buf.esalt = (void *) hcmalloc (hashcat_ctx, esalt_size); VERIFY_PTR (hash_buf.esalt);
+  }
 
-  char **out_files = NULL;
+  char *line_buf = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE); VERIFY_PTR (line_buf);
 
-  time_t folder_mtime = 0;
+  // a line costs a hash lookup instead of a pass over all salts and digests
 
-  int out_cnt = 0;
+  outfile_check_index_t index;
 
-  u32 check_left = outfile_check_timer; // or 1 if we want to check it at startup
+  memset (&index, 0, sizeof (outfile_check_index_t));
 
-  while (status_ctx->shutdown_inner == false)
+  if ((hash_mode != 2500) && (hash_mode != 6800))
   {
-    hc_sleep (1);
+    const int rc_index = outfile_check_index_init (hashcat_ctx, &index);
 
-    if (status_ctx->devices_status != STATUS_RUNNING) continue;
+    if (rc_index == -1) return -1;
+  }
+
+  // other nodes writing to the directory wake us up, the timer is the fallback
 
-    check_left--;
+  #if defined (__linux__)
+  int inotify_fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
 
-    if (check_left == 0)
+  if (inotify_fd != -1)
+  {
+    if (inotify_add_watch (inotify_fd, root_directory, IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE) == -1)
     {
-      struct stat outfile_check_stat;
+      close (inotify_fd);
 
-      if (stat (root_directory, &outfile_check_stat) == 0)
-      {
-        u32 is_dir = S_ISDIR (outfile_check_stat.st_mode);
+      inotify_fd = -1;
+    }
+  }
+  #endif
 
-        if (is_dir == 1)
-        {
-          if (outfile_check_stat.st_mtime > folder_mtime)
-          {
-            char **out_files_new = scan_directory (hashcat_ctx, root_directory);
+  outfile_data_t *out_info = NULL;
 
-            int out_cnt_new = count_dictionaries (out_files_new);
+  char **out_files = NULL;
 
-            outfile_data_t *out_info_new = NULL;
+  time_t folder_mtime = 0;
 
-            if (out_cnt_new > 0)
-            {
-              out_info_new = (outfile_data_t *) hccalloc (hashcat_ctx, out_cnt_new, sizeof (outfile_data_t)); VERIFY_PTR (out_info_new);
-
-              for (int i = 0; i < out_cnt_new; i++)
-              {
-                out_info_new[i].file_name = out_files_new[i];
-
-                // check if there are files that we have seen/checked before (and not changed)
-
-                for (int j = 0; j < out_cnt; j++)
-                {
-                  if (strcmp (out_info[j].file_name, out_info_new[i].file_name) == 0)
-                  {
-                    struct stat outfile_stat;
-
-                    if (stat (out_info_new[i].file_name, &outfile_stat) == 0)
-                    {
-                      if (outfile_stat.st_ctime == out_info[j].ctime)
-                      {
-                        out_info_new[i].ctime = out_info[j].ctime;
-                        out_info_new[i].seek  = out_info[j].seek;
-                      }
-                    }
-                  }
-                }
-              }
-            }
+  int out_cnt = 0;
 
-            hcfree (out_info);
-            hcfree (out_files);
+  bool check_pending = false;
+  bool scan_pending  = false;
 
-            out_files = out_files_new;
-            out_cnt   = out_cnt_new;
-            out_info  = out_info_new;
+  time_t check_next = time (NULL) + outfile_check_timer; // or now if we want to check it at startup
 
-            folder_mtime = outfile_check_stat.st_mtime;
-          }
+  // short waits, the end of a job should not wait up to a second for this thread, the check itself still follows check_next
 
-          for (int j = 0; j < out_cnt; j++)
-          {
-            FILE *fp = fopen (out_info[j].file_name, "rb");
+  while (status_ctx->shutdown_inner == false)
+  {
+    #if defined (__linux__)
+    if (inotify_fd != -1)
+    {
+      struct pollfd inotify_pfd;
 
-            if (fp != NULL)
-            {
-              //hc_thread_mutex_lock (status_ctx->mux_display);
+      inotify_pfd.fd      = inotify_fd;
+      inotify_pfd.events  = POLLIN;
+      inotify_pfd.revents = 0;
 
-              hc_stat outfile_stat;
+      if (poll (&inotify_pfd, 1, 10) > 0)
+      {
+        char event_buf[4096] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
 
-              #if defined (_POSIX)
-              fstat (fileno (fp), &outfile_stat);
-              #endif
+        ssize_t event_len;
 
-              #if defined (_WIN)
-              _fstat64 (fileno (fp), &outfile_stat);
-              #endif
+        while ((event_len = read (inotify_fd, event_buf, sizeof (event_buf))) > 0)
+        {
+          for (char *ptr = event_buf; ptr < event_buf + event_len; )
+          {
+            const struct inotify_event *event = (const struct inotify_event *) ptr;
 
-              if (outfile_stat.st_ctime > out_info[j].ctime)
-              {
-                out_info[j].ctime = outfile_stat.st_ctime;
-                out_info[j].seek  = 0;
-              }
+            if (event->mask & (IN_CREATE | IN_MOVED_TO | IN_DELETE)) scan_pending = true;
 
-              fseek (fp, out_info[j].seek, SEEK_SET);
+            ptr += sizeof (struct inotify_event) + event->len;
+          }
+        }
 
-              char *line_buf = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE); VERIFY_PTR (line_buf);
+        check_pending = true;
+      }
+    }
+    else
+    {
+      hc_sleep_msec (10);
+    }
+    #else
+    hc_sleep_msec (10);
+    #endif
 
-              while (!feof (fp))
-              {
-                char *ptr = fgets (line_buf, HCBUFSIZ_LARGE - 1, fp);
+    if (status_ctx->devices_status != STATUS_RUNNING) continue;
 
-                if (ptr == NULL) break;
+    const time_t now = time (NULL);
 
-                int line_len = strlen (line_buf);
+    if ((check_pending == false) && (now < check_next)) continue;
 
-                if (line_len <= 0) continue;
+    check_pending = false;
 
-                int iter = MAX_CUT_TRIES;
+    check_next = now + outfile_check_timer;
 
-                for (u32 i = line_len - 1; i && iter; i--, line_len--)
-                {
-                  if (line_buf[i] != separator) continue;
+    struct stat outfile_check_stat;
 
-                  int parser_status = PARSER_OK;
+    if (stat (root_directory, &outfile_check_stat) != 0) continue;
 
-                  if ((hash_mode != 2500) && (hash_mode != 6800))
-                  {
-                    parser_status = hashconfig->parse_func (line_buf, line_len - 1, &hash_buf, hashconfig);
-                  }
+    if (S_ISDIR (outfile_check_stat.st_mode) == 0) continue;
 
-                  u32 found = 0;
+    // st_mtime has a resolution of a second, a file created right after the last scan would not be seen
 
-                  if (parser_status == PARSER_OK)
-                  {
-                    for (u32 salt_pos = 0; (found == 0) && (salt_pos < hashes->salts_cnt); salt_pos++)
-                    {
-                      if (hashes->salts_shown[salt_pos] == 1) continue;
+    if ((outfile_check_stat.st_mtime != folder_mtime) || (scan_pending == true))
+    {
+      char **out_files_new = scan_directory (hashcat_ctx, root_directory);
 
-                      salt_t *salt_buf = &hashes->salts_buf[salt_pos];
+      int out_cnt_new = count_dictionaries (out_files_new);
 
-                      for (u32 digest_pos = 0; (found == 0) && (digest_pos < salt_buf->digests_cnt); digest_pos++)
-                      {
-                        u32 idx = salt_buf->digests_offset + digest_pos;
+      outfile_data_t *out_info_new = NULL;
 
-                        if (hashes->digests_shown[idx] == 1) continue;
+      if (out_cnt_new > 0)
+      {
+        out_info_new = (outfile_data_t *) hccalloc (hashcat_ctx, out_cnt_new, sizeof (outfile_data_t)); VERIFY_PTR (out_info_new);
 
-                        u32 cracked = 0;
+        for (int i = 0; i < out_cnt_new; i++)
+        {
+          out_info_new[i].file_name = out_files_new[i];
 
-                        if (hash_mode == 6800)
-                        {
-                          if (i == salt_buf->salt_len)
-                          {
-                            cracked = (memcmp (line_buf, salt_buf->salt_buf, salt_buf->salt_len) == 0);
-                          }
-                        }
-                        else if (hash_mode == 2500)
-                        {
-                          // BSSID : MAC1 : MAC2 (:plain)
-                          if (i == (salt_buf->salt_len + 1 + 12 + 1 + 12))
-                          {
-                            cracked = (memcmp (line_buf, salt_buf->salt_buf, salt_buf->salt_len) == 0);
+          // keep the tail offset of files that we have seen before
 
-                            if (!cracked) continue;
+          for (int j = 0; j < out_cnt; j++)
+          {
+            if (strcmp (out_info[j].file_name, out_info_new[i].file_name) == 0)
+            {
+              out_info_new[i].ctime = out_info[j].ctime;
+              out_info_new[i].seek  = out_info[j].seek;
+            }
+          }
+        }
+      }
 
-                            // now compare MAC1 and MAC2 too, since we have this additional info
-                            char *mac1_pos = line_buf + salt_buf->salt_len + 1;
-                            char *mac2_pos = mac1_pos + 12 + 1;
+      hcfree (out_info);
+      hcfree (out_files);
 
-                            wpa_t *wpas = (wpa_t *) hashes->esalts_buf;
-                            wpa_t *wpa  = &wpas[salt_pos];
+      out_files = out_files_new;
+      out_cnt   = out_cnt_new;
+      out_info  = out_info_new;
+
+      folder_mtime = outfile_check_stat.st_mtime;
+
+      scan_pending = false;
+    }
 
-                            // compare hex string(s) vs binary MAC address(es)
+    for (int j = 0; j < out_cnt; j++)
+    {
+      // nothing appended, no need to open it
 
-                            for (u32 i = 0, j = 0; i < 6; i++, j += 2)
-                            {
-                              if (wpa->orig_mac1[i] != hex_to_u8 ((const u8 *) &mac1_pos[j]))
-                              {
-                                cracked = 0;
+      struct stat outfile_stat;
 
-                                break;
-                              }
-                            }
+      if (stat (out_info[j].file_name, &outfile_stat) != 0) continue;
 
-                            // early skip ;)
-                            if (!cracked) continue;
+      if ((outfile_stat.st_size == out_info[j].seek) && (outfile_stat.st_ctime == out_info[j].ctime)) continue;
 
-                            for (u32 i = 0, j = 0; i < 6; i++, j += 2)
-                            {
-                              if (wpa->orig_mac2[i] != hex_to_u8 ((const u8 *) &mac2_pos[j]))
-                              {
-                                cracked = 0;
+      FILE *fp = fopen (out_info[j].file_name, "rb");
 
-                                break;
-                              }
-                            }
-                          }
-                        }
-                        else
-                        {
-                          char *digests_buf_ptr = (char *) hashes->digests_buf;
+      if (fp == NULL) continue;
 
-                          memcpy (digest_buf, digests_buf_ptr + (hashes->salts_buf[salt_pos].digests_offset * dgst_size) + (digest_pos * dgst_size), dgst_size);
+      // a file that got shorter was truncated or replaced, start over
 
-                          cracked = (sort_by_digest_p0p1 (digest_buf, hash_buf.digest, hashconfig) == 0);
-                        }
+      if (outfile_stat.st_size < out_info[j].seek) out_info[j].seek = 0;
 
-                        if (cracked == 1)
-                        {
-                          found = 1;
+      out_info[j].ctime = outfile_stat.st_ctime;
 
-                          hashes->digests_shown[idx] = 1;
+      fseek (fp, out_info[j].seek, SEEK_SET);
 
-                          hashes->digests_done++;
+      while (!feof (fp))
+      {
+        const long line_start = ftell (fp);
 
-                          salt_buf->digests_done++;
+        char *ptr = fgets (line_buf, HCBUFSIZ_LARGE - 1, fp);
 
-                          if (salt_buf->digests_done == salt_buf->digests_cnt)
-                          {
-                            hashes->salts_shown[salt_pos] = 1;
+        if (ptr == NULL) break;
 
-                            hashes->salts_done++;
+        int line_len = strlen (line_buf);
 
-                            if (hashes->salts_done == hashes->salts_cnt) mycracked (hashcat_ctx);
-                          }
-                        }
-                      }
+        if (line_len <= 0) continue;
 
-                      if (status_ctx->devices_status == STATUS_CRACKED) break;
-                    }
-                  }
+        // the writer on the other node may be in the middle of this line, pick it up next time
 
-                  if (found) break;
+        if ((line_buf[line_len - 1] != '\n') && (feof (fp)))
+        {
+          fseek (fp, line_start, SEEK_SET);
 
-                  if (status_ctx->devices_status == STATUS_CRACKED) break;
+          break;
+        }
 
-                  iter--;
-                }
+        int iter = MAX_CUT_TRIES;
 
-                if (status_ctx->devices_status == STATUS_CRACKED) break;
-              }
+        for (u32 i = line_len - 1; i && iter; i--, line_len--)
+        {
+          if (line_buf[i] != separator) continue;
 
-              hcfree (line_buf);
+          u32 found = 0;
 
-              out_info[j].seek = ftell (fp);
+          if ((hash_mode != 2500) && (hash_mode != 6800))
+          {
+            if (is_salted) memset (hash_buf.salt, 0, sizeof (salt_t));
 
-              //hc_thread_mutex_unlock (status_ctx->mux_display);
+            const int parser_status = hashconfig->parse_func (line_buf, line_len - 1, &hash_buf, hashconfig);
 
-              fclose (fp);
+            if (parser_status == PARSER_OK)
+            {
+              found = outfile_check_index_find (hashcat_ctx, &index, &hash_buf);
             }
           }
+          else
+          {
+            found = outfile_check_salts_find (hashcat_ctx, line_buf, i);
+          }
+
+          if (found) break;
+
+          if (status_ctx->devices_status == STATUS_CRACKED) break;
+
+          iter--;
         }
+
+        if (status_ctx->devices_status == STATUS_CRACKED) break;
       }
 
-      check_left = outfile_check_timer;
+      out_info[j].seek = ftell (fp);
+
+      fclose (fp);
     }
   }
 
+  #if defined (__linux__)
+  if (inotify_fd != -1) close (inotify_fd);
+  #endif
+
+  outfile_check_index_destroy (&index);
+
+  hcfree (line_buf);
+
   hcfree (hash_buf.esalt);
 
   hcfree (hash_buf.salt);
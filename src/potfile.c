@@ -602,13 +602,22 @@ int potfile_handle_left (hashcat_ctx_t *hashcat_ctx)
 
       if (digests_shown[hashes_idx] == 1) continue;
 
+      hash_t *hash = &hashes_buf[hashes_idx];
+
       char out_buf[HCBUFSIZ_LARGE]; // scratch buffer
 
-      out_buf[0] = 0;
+      // the hash line is kept verbatim for OPTS_TYPE_HASH_COPY, no need to format it again
 
-      ascii_digest (hashcat_ctx, out_buf, salt_idx, digest_idx);
+      const char *hash_buf = out_buf;
 
-      hash_t *hash = &hashes_buf[hashes_idx];
+      if ((hash->hash_info != NULL) && (hash->hash_info->orighash != NULL))
+      {
+        hash_buf = hash->hash_info->orighash;
+      }
+      else
+      {
+        ascii_digest (hashcat_ctx, out_buf, salt_idx, digest_idx);
+      }
 
       // user
       unsigned char *username = NULL;
@@ -631,7 +640,7 @@ int potfile_handle_left (hashcat_ctx_t *hashcat_ctx)
 
       char tmp_buf[HCBUFSIZ_LARGE]; // scratch buffer
 
-      const int tmp_len = outfile_write (hashcat_ctx, out_buf, NULL, 0, 0, username, user_len, tmp_buf);
+      const int tmp_len = outfile_write (hashcat_ctx, hash_buf, NULL, 0, 0, username, user_len, tmp_buf);
 
       EVENT_DATA (EVENT_POTFILE_HASH_LEFT, tmp_buf, tmp_len);
     }
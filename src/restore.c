@@ -7,6 +7,7 @@
 #include "types.h"
 #include "memory.h"
 #include "event.h"
+#include "thread.h"
 #include "user_options.h"
 #include "restore.h"
 
@@ -42,6 +43,14 @@ static int check_running_process (hashcat_ctx_t *hashcat_ctx)
 
   fclose (fp);
 
+  // a restore file with our own pid was left behind by a previous job of this session
+
+  #if defined (_POSIX)
+  if (rd->pid == (u32) getpid ()) rd->pid = 0;
+  #elif defined (_WIN)
+  if (rd->pid == (u32) GetCurrentProcessId ()) rd->pid = 0;
+  #endif
+
   if (rd->pid)
   {
     char *pidbin = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE); VERIFY_PTR (pidbin);
@@ -269,6 +278,298 @@ static int write_restore (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+static int sort_by_words_off (const void *p1, const void *p2)
+{
+  const restore_range_t *r1 = (const restore_range_t *) p1;
+  const restore_range_t *r2 = (const restore_range_t *) p2;
+
+  if (r1->words_off > r2->words_off) return  1;
+  if (r1->words_off < r2->words_off) return -1;
+
+  return 0;
+}
+
+static int read_journal (hashcat_ctx_t *hashcat_ctx)
+{
+  restore_ctx_t *restore_ctx = hashcat_ctx->restore_ctx;
+
+  char *journal_file = restore_ctx->journal_file;
+
+  // the journal is optional, without one we resume from words_cur only
+
+  FILE *fp = fopen (journal_file, "rb");
+
+  if (fp == NULL) return 0;
+
+  u32 journal_hdr[2] = { 0 };
+
+  if ((fread (journal_hdr, sizeof (journal_hdr), 1, fp) != 1) || (journal_hdr[0] != RESTORE_JOURNAL_MAGIC) || (journal_hdr[1] != RESTORE_JOURNAL_VERSION))
+  {
+    event_log_warning (hashcat_ctx, "%s: Unknown format, ignored", journal_file);
+
+    fclose (fp);
+
+    return 0;
+  }
+
+  u32 journal_avail = 0;
+
+  restore_range_t range;
+
+  // a record cut short by a crash is simply dropped
+
+  while (fread (&range, sizeof (restore_range_t), 1, fp) == 1)
+  {
+    if (restore_ctx->journal_cnt == journal_avail)
+    {
+      restore_ctx->journal_buf = (restore_range_t *) hcrealloc (hashcat_ctx, restore_ctx->journal_buf, journal_avail * sizeof (restore_range_t), RESTORE_JOURNAL_ALLOC * sizeof (restore_range_t)); VERIFY_PTR (restore_ctx->journal_buf);
+
+      journal_avail += RESTORE_JOURNAL_ALLOC;
+    }
+
+    restore_ctx->journal_buf[restore_ctx->journal_cnt] = range;
+
+    restore_ctx->journal_cnt++;
+  }
+
+  fclose (fp);
+
+  return 0;
+}
+
+int restore_journal_begin (hashcat_ctx_t *hashcat_ctx)
+{
+  const mask_ctx_t     *mask_ctx     = hashcat_ctx->mask_ctx;
+  const straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+  restore_ctx_t        *restore_ctx  = hashcat_ctx->restore_ctx;
+  status_ctx_t         *status_ctx   = hashcat_ctx->status_ctx;
+
+  if (restore_ctx->enabled == false) return 0;
+
+  const u32 dicts_pos = straight_ctx->dicts_pos;
+  const u32 masks_pos = mask_ctx->masks_pos;
+
+  hcfree (status_ctx->words_skip_buf);
+
+  status_ctx->words_skip_buf = NULL;
+  status_ctx->words_skip_cnt = 0;
+  status_ctx->words_skip_sum = 0;
+
+  // only the position we resume at can have work finished above words_cur
+
+  if (restore_ctx->journal_cnt)
+  {
+    restore_range_t *skip_buf = (restore_range_t *) hccalloc (hashcat_ctx, restore_ctx->journal_cnt, sizeof (restore_range_t)); VERIFY_PTR (skip_buf);
+
+    u32 skip_cnt = 0;
+
+    for (u32 journal_pos = 0; journal_pos < restore_ctx->journal_cnt; journal_pos++)
+    {
+      const restore_range_t *range = &restore_ctx->journal_buf[journal_pos];
+
+      if (range->dicts_pos != dicts_pos) continue;
+      if (range->masks_pos != masks_pos) continue;
+
+      const u64 words_off = MAX (range->words_off, status_ctx->words_off);
+      const u64 words_fin = MIN (range->words_fin, status_ctx->words_base);
+
+      if (words_off >= words_fin) continue;
+
+      skip_buf[skip_cnt] = *range;
+
+      skip_buf[skip_cnt].words_off = words_off;
+      skip_buf[skip_cnt].words_fin = words_fin;
+
+      skip_cnt++;
+    }
+
+    hcfree (restore_ctx->journal_buf);
+
+    restore_ctx->journal_buf = NULL;
+    restore_ctx->journal_cnt = 0;
+
+    // merge overlapping and adjacent ranges, get_work () relies on a gap between any two of them
+
+    qsort (skip_buf, skip_cnt, sizeof (restore_range_t), sort_by_words_off);
+
+    u32 merged_cnt = 0;
+
+    for (u32 skip_pos = 0; skip_pos < skip_cnt; skip_pos++)
+    {
+      if ((merged_cnt > 0) && (skip_buf[skip_pos].words_off <= skip_buf[merged_cnt - 1].words_fin))
+      {
+        skip_buf[merged_cnt - 1].words_fin = MAX (skip_buf[merged_cnt - 1].words_fin, skip_buf[skip_pos].words_fin);
+
+        continue;
+      }
+
+      skip_buf[merged_cnt] = skip_buf[skip_pos];
+
+      merged_cnt++;
+    }
+
+    // a range starting right at the restore point simply moves it
+
+    u32 merged_pos = 0;
+
+    if ((merged_cnt > 0) && (skip_buf[0].words_off == status_ctx->words_off))
+    {
+      status_ctx->words_off = skip_buf[0].words_fin;
+      status_ctx->words_cur = skip_buf[0].words_fin;
+
+      merged_pos = 1;
+    }
+
+    for (u32 skip_pos = merged_pos; skip_pos < merged_cnt; skip_pos++)
+    {
+      skip_buf[skip_pos - merged_pos] = skip_buf[skip_pos];
+
+      status_ctx->words_skip_sum += skip_buf[skip_pos].words_fin - skip_buf[skip_pos].words_off;
+    }
+
+    if (merged_cnt > merged_pos)
+    {
+      status_ctx->words_skip_buf = skip_buf;
+      status_ctx->words_skip_cnt = merged_cnt - merged_pos;
+    }
+    else
+    {
+      hcfree (skip_buf);
+    }
+  }
+
+  // start the journal over for this position, carrying the ranges which are still ahead of us
+
+  if (restore_ctx->journal_fp) fclose (restore_ctx->journal_fp);
+
+  restore_ctx->journal_fp = NULL;
+
+  FILE *fp = fopen (restore_ctx->journal_file, "wb");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", restore_ctx->journal_file, strerror (errno));
+
+    return -1;
+  }
+
+  const u32 journal_hdr[2] = { RESTORE_JOURNAL_MAGIC, RESTORE_JOURNAL_VERSION };
+
+  fwrite (journal_hdr, sizeof (journal_hdr), 1, fp);
+
+  if (status_ctx->words_skip_cnt)
+  {
+    fwrite (status_ctx->words_skip_buf, sizeof (restore_range_t), status_ctx->words_skip_cnt, fp);
+  }
+
+  fflush (fp);
+
+  restore_ctx->journal_fp = fp;
+
+  return 0;
+}
+
+u64 restore_journal_skip (const hashcat_ctx_t *hashcat_ctx, u64 words_off, const u64 words_base, u64 *words_gap, u64 *words_skip)
+{
+  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  // returns the first word at or after words_off which is not done yet,
+  // words_gap is the distance to the next finished range and words_skip the finished words behind it
+
+  *words_gap  = 0xffffffffffffffff;
+  *words_skip = 0;
+
+  for (u32 skip_pos = 0; skip_pos < status_ctx->words_skip_cnt; skip_pos++)
+  {
+    const restore_range_t *range = &status_ctx->words_skip_buf[skip_pos];
+
+    if (range->words_fin <= words_off) continue;
+
+    if (range->words_off <= words_off)
+    {
+      words_off = range->words_fin;
+
+      continue;
+    }
+
+    if (range->words_off >= words_base) break;
+
+    if (*words_gap == 0xffffffffffffffff) *words_gap = range->words_off - words_off;
+
+    *words_skip += MIN (range->words_fin, words_base) - range->words_off;
+  }
+
+  return words_off;
+}
+
+void restore_journal_claim (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param, const u64 words_off, const u64 words_cnt)
+{
+  const mask_ctx_t     *mask_ctx     = hashcat_ctx->mask_ctx;
+  const restore_ctx_t  *restore_ctx  = hashcat_ctx->restore_ctx;
+  const straight_ctx_t *straight_ctx = hashcat_ctx->straight_ctx;
+
+  if (restore_ctx->enabled == false) return;
+
+  if (words_cnt == 0) return;
+
+  // the claims of a device are mostly back to back, only other devices claiming in between leave gaps
+
+  if (device_param->words_claimed_cnt > 0)
+  {
+    restore_range_t *range = &device_param->words_claimed_buf[device_param->words_claimed_cnt - 1];
+
+    if (range->words_fin == words_off)
+    {
+      range->words_fin += words_cnt;
+
+      return;
+    }
+  }
+
+  if (device_param->words_claimed_cnt == device_param->words_claimed_avail)
+  {
+    restore_range_t *words_claimed_buf = (restore_range_t *) hcrealloc (hashcat_ctx, device_param->words_claimed_buf, device_param->words_claimed_avail * sizeof (restore_range_t), RESTORE_JOURNAL_ALLOC * sizeof (restore_range_t));
+
+    // not journaling a range is fine, it's just done again on --restore
+
+    if (words_claimed_buf == NULL) return;
+
+    device_param->words_claimed_buf    = words_claimed_buf;
+    device_param->words_claimed_avail += RESTORE_JOURNAL_ALLOC;
+  }
+
+  restore_range_t *range = &device_param->words_claimed_buf[device_param->words_claimed_cnt];
+
+  range->dicts_pos = straight_ctx->dicts_pos;
+  range->masks_pos = mask_ctx->masks_pos;
+  range->words_off = words_off;
+  range->words_fin = words_off + words_cnt;
+
+  device_param->words_claimed_cnt++;
+}
+
+void restore_journal_commit (hashcat_ctx_t *hashcat_ctx, hc_device_param_t *device_param)
+{
+  restore_ctx_t *restore_ctx = hashcat_ctx->restore_ctx;
+
+  if (restore_ctx->enabled == false) return;
+
+  if (device_param->words_claimed_cnt == 0) return;
+
+  // appended only, the restore file itself is still rewritten by cycle_restore () alone
+
+  hc_thread_mutex_lock (restore_ctx->mux_journal);
+
+  if (restore_ctx->journal_fp)
+  {
+    fwrite (device_param->words_claimed_buf, sizeof (restore_range_t), device_param->words_claimed_cnt, restore_ctx->journal_fp);
+  }
+
+  hc_thread_mutex_unlock (restore_ctx->mux_journal);
+
+  device_param->words_claimed_cnt = 0;
+}
+
 int cycle_restore (hashcat_ctx_t *hashcat_ctx)
 {
   restore_ctx_t *restore_ctx = hashcat_ctx->restore_ctx;
@@ -297,6 +598,17 @@ int cycle_restore (hashcat_ctx_t *hashcat_ctx)
     event_log_warning (hashcat_ctx, "Rename file '%s' to '%s': %s", new_restore_file, eff_restore_file, strerror (errno));
   }
 
+  hc_thread_mutex_lock (restore_ctx->mux_journal);
+
+  if (restore_ctx->journal_fp)
+  {
+    fflush (restore_ctx->journal_fp);
+
+    fsync (fileno (restore_ctx->journal_fp));
+  }
+
+  hc_thread_mutex_unlock (restore_ctx->mux_journal);
+
   return 0;
 }
 
@@ -318,6 +630,27 @@ void unlink_restore (hashcat_ctx_t *hashcat_ctx)
     unlink (restore_ctx->eff_restore_file);
     unlink (restore_ctx->new_restore_file);
   }
+
+  // the journal is worthless without the restore file
+
+  FILE *fp = fopen (restore_ctx->eff_restore_file, "rb");
+
+  if (fp)
+  {
+    fclose (fp);
+
+    return;
+  }
+
+  hc_thread_mutex_lock (restore_ctx->mux_journal);
+
+  if (restore_ctx->journal_fp) fclose (restore_ctx->journal_fp);
+
+  restore_ctx->journal_fp = NULL;
+
+  hc_thread_mutex_unlock (restore_ctx->mux_journal);
+
+  unlink (restore_ctx->journal_file);
 }
 
 int restore_ctx_init (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
@@ -351,17 +684,28 @@ int restore_ctx_init (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
   restore_ctx->argc = argc;
   restore_ctx->argv = argv;
 
+  char *journal_file = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_TINY); VERIFY_PTR (journal_file);
+
+  snprintf (journal_file, HCBUFSIZ_TINY - 1, "%s/%s.restore.journal", folder_config->session_dir, user_options->session);
+
   restore_ctx->eff_restore_file = eff_restore_file;
   restore_ctx->new_restore_file = new_restore_file;
+  restore_ctx->journal_file     = journal_file;
 
   const int rc_init_restore = init_restore (hashcat_ctx);
 
   if (rc_init_restore == -1) return -1;
 
+  hc_thread_mutex_init (restore_ctx->mux_journal);
+
   restore_ctx->enabled = true;
 
   if (user_options->restore == true)
   {
+    const int rc_read_journal = read_journal (hashcat_ctx);
+
+    if (rc_read_journal == -1) return -1;
+
     const int rc_read_restore = read_restore (hashcat_ctx);
 
     if (rc_read_restore == -1) return -1;
@@ -397,8 +741,14 @@ void restore_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
 
   if (restore_ctx->enabled == false) return;
 
+  if (restore_ctx->journal_fp) fclose (restore_ctx->journal_fp);
+
   hcfree (restore_ctx->eff_restore_file);
   hcfree (restore_ctx->new_restore_file);
+  hcfree (restore_ctx->journal_file);
+  hcfree (restore_ctx->journal_buf);
+
+  hc_thread_mutex_delete (restore_ctx->mux_journal);
 
   hcfree (restore_ctx->rd);
 
@@ -714,7 +714,199 @@ bool kernel_rules_has_noop (const kernel_rule_t *kernel_rules_buf, const u32 ker
   return false;
 }
 
-int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt)
+static bool kernel_rule_op_is_case_absolute (const u8 name)
+{
+  // these overwrite the case of every letter, so whatever case operation came before is lost
+
+  switch (name)
+  {
+    case RULE_OP_MANGLE_LREST:          return true;
+    case RULE_OP_MANGLE_UREST:          return true;
+    case RULE_OP_MANGLE_LREST_UFIRST:   return true;
+    case RULE_OP_MANGLE_UREST_LFIRST:   return true;
+    case RULE_OP_MANGLE_TITLE:          return true;
+  }
+
+  return false;
+}
+
+static bool kernel_rule_op_is_involution (const u8 name)
+{
+  // applied twice with the same parameters these restore the original word
+
+  switch (name)
+  {
+    case RULE_OP_MANGLE_TREST:          return true;
+    case RULE_OP_MANGLE_TOGGLE_AT:      return true;
+    case RULE_OP_MANGLE_REVERSE:        return true;
+    case RULE_OP_MANGLE_SWITCH_FIRST:   return true;
+    case RULE_OP_MANGLE_SWITCH_LAST:    return true;
+    case RULE_OP_MANGLE_SWITCH_AT:      return true;
+  }
+
+  return false;
+}
+
+static void kernel_rule_fold (kernel_rule_t *rule)
+{
+  u32 out_buf[RULES_MAX] = { 0 };
+  u32 out_cnt = 0;
+
+  for (u32 in_pos = 0; in_pos < RULES_MAX; in_pos++)
+  {
+    const u32 cmd = rule->cmds[in_pos];
+
+    if (cmd == 0) break;
+
+    const u8 name = (u8) (cmd & 0xff);
+
+    if (name == RULE_OP_MANGLE_NOOP) continue;
+
+    if (out_cnt)
+    {
+      const u32 prev = out_buf[out_cnt - 1];
+
+      const u8 prev_name = (u8) (prev & 0xff);
+
+      // xx = :
+
+      if ((cmd == prev) && (kernel_rule_op_is_involution (name) == true))
+      {
+        out_cnt--;
+
+        continue;
+      }
+
+      // {} = }{ = :
+
+      if (((prev_name == RULE_OP_MANGLE_ROTATE_LEFT)  && (name == RULE_OP_MANGLE_ROTATE_RIGHT))
+       || ((prev_name == RULE_OP_MANGLE_ROTATE_RIGHT) && (name == RULE_OP_MANGLE_ROTATE_LEFT)))
+      {
+        out_cnt--;
+
+        continue;
+      }
+
+      if (kernel_rule_op_is_case_absolute (prev_name) == true)
+      {
+        // lu = u, cE = E, ll = l, ...
+
+        if (kernel_rule_op_is_case_absolute (name) == true)
+        {
+          out_buf[out_cnt - 1] = cmd;
+
+          continue;
+        }
+
+        // lt = u, ut = l, ct = C, Ct = c
+
+        if (name == RULE_OP_MANGLE_TREST)
+        {
+          u32 repl = 0;
+
+          switch (prev_name)
+          {
+            case RULE_OP_MANGLE_LREST:        repl = RULE_OP_MANGLE_UREST;        break;
+            case RULE_OP_MANGLE_UREST:        repl = RULE_OP_MANGLE_LREST;        break;
+            case RULE_OP_MANGLE_LREST_UFIRST: repl = RULE_OP_MANGLE_UREST_LFIRST; break;
+            case RULE_OP_MANGLE_UREST_LFIRST: repl = RULE_OP_MANGLE_LREST_UFIRST; break;
+          }
+
+          if (repl)
+          {
+            out_buf[out_cnt - 1] = repl;
+
+            continue;
+          }
+        }
+      }
+    }
+
+    out_buf[out_cnt++] = cmd;
+  }
+
+  if (out_cnt == 0) out_buf[out_cnt++] = RULE_OP_MANGLE_NOOP;
+
+  memcpy (rule->cmds, out_buf, sizeof (out_buf));
+}
+
+static u32 kernel_rule_hash (const kernel_rule_t *rule)
+{
+  u32 hash = 0x811c9dc5;
+
+  for (u32 i = 0; i < RULES_MAX; i++)
+  {
+    if (rule->cmds[i] == 0) break;
+
+    hash ^= rule->cmds[i];
+    hash *= 0x01000193;
+    hash ^= hash >> 15;
+  }
+
+  return hash;
+}
+
+static int kernel_rules_fold (hashcat_ctx_t *hashcat_ctx, kernel_rule_t *kernel_rules_buf, kernel_rule_t *kernel_rules_buf_orig, u32 *kernel_rules_cnt)
+{
+  // canonicalize every rule, then drop all rules which are equal to an earlier one
+  // the first occurrence wins so the rule order as seen by the user is kept
+
+  const u32 rules_cnt = *kernel_rules_cnt;
+
+  u32 table_size = 1;
+
+  while (table_size < (rules_cnt * 2)) table_size <<= 1;
+
+  u32 *table_buf = (u32 *) hccalloc (hashcat_ctx, table_size, sizeof (u32)); VERIFY_PTR (table_buf);
+
+  const u32 table_mask = table_size - 1;
+
+  u32 rules_new = 0;
+
+  for (u32 rules_pos = 0; rules_pos < rules_cnt; rules_pos++)
+  {
+    kernel_rule_t *rule = &kernel_rules_buf[rules_pos];
+
+    kernel_rule_fold (rule);
+
+    u32 slot = kernel_rule_hash (rule) & table_mask;
+
+    bool is_dupe = false;
+
+    while (table_buf[slot])
+    {
+      if (memcmp (&kernel_rules_buf[table_buf[slot] - 1], rule, sizeof (kernel_rule_t)) == 0)
+      {
+        is_dupe = true;
+
+        break;
+      }
+
+      slot = (slot + 1) & table_mask;
+    }
+
+    if (is_dupe == true) continue;
+
+    if (rules_new != rules_pos)
+    {
+      kernel_rules_buf[rules_new] = kernel_rules_buf[rules_pos];
+
+      if (kernel_rules_buf_orig) kernel_rules_buf_orig[rules_new] = kernel_rules_buf_orig[rules_pos];
+    }
+
+    rules_new++;
+
+    table_buf[slot] = rules_new;
+  }
+
+  hcfree (table_buf);
+
+  *kernel_rules_cnt = rules_new;
+
+  return 0;
+}
+
+int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32 *out_cnt, kernel_rule_t **out_buf_orig, u32 *out_folded)
 {
   const user_options_t *user_options = hashcat_ctx->user_options;
 
@@ -868,8 +1060,31 @@ int kernel_rules_load (hashcat_ctx_t *hashcat_ctx, kernel_rule_t **out_buf, u32
   hcfree (all_kernel_rules_cnt);
   hcfree (all_kernel_rules_buf);
 
-  *out_cnt = kernel_rules_cnt;
-  *out_buf = kernel_rules_buf;
+  /**
+   * fold rules
+   */
+
+  // --debug-mode has to report the rule the way the user wrote it, not the folded one
+
+  kernel_rule_t *kernel_rules_buf_orig = NULL;
+
+  if ((user_options->debug_mode == 1) || (user_options->debug_mode == 3) || (user_options->debug_mode == 4))
+  {
+    kernel_rules_buf_orig = (kernel_rule_t *) hcmalloc (hashcat_ctx, kernel_rules_cnt * sizeof (kernel_rule_t)); VERIFY_PTR (kernel_rules_buf_orig);
+
+    memcpy (kernel_rules_buf_orig, kernel_rules_buf, kernel_rules_cnt * sizeof (kernel_rule_t));
+  }
+
+  const u32 kernel_rules_cnt_orig = kernel_rules_cnt;
+
+  const int rc_fold = kernel_rules_fold (hashcat_ctx, kernel_rules_buf, kernel_rules_buf_orig, &kernel_rules_cnt);
+
+  if (rc_fold == -1) return -1;
+
+  *out_cnt      = kernel_rules_cnt;
+  *out_buf      = kernel_rules_buf;
+  *out_buf_orig = kernel_rules_buf_orig;
+  *out_folded   = kernel_rules_cnt_orig - kernel_rules_cnt;
 
   return 0;
 }
@@ -943,14 +943,15 @@ double status_get_progress_finished_percent (const hashcat_ctx_t *hashcat_ctx)
 
 u64 status_get_progress_done (const hashcat_ctx_t *hashcat_ctx)
 {
-  const hashes_t     *hashes     = hashcat_ctx->hashes;
-  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
 
   u64 progress_done = 0;
 
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
   {
-    progress_done += status_ctx->words_progress_done[salt_pos];
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    progress_done += device_param->progress_done;
   }
 
   return progress_done;
@@ -959,13 +960,16 @@ u64 status_get_progress_done (const hashcat_ctx_t *hashcat_ctx)
 u64 status_get_progress_rejected (const hashcat_ctx_t *hashcat_ctx)
 {
   const hashes_t     *hashes     = hashcat_ctx->hashes;
-  const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
 
   u64 progress_rejected = 0;
 
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
   {
-    progress_rejected += status_ctx->words_progress_rejected[salt_pos];
+    const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    progress_rejected += device_param->progress_rejected;
+    progress_rejected += device_param->progress_rejected_all * hashes->salts_cnt;
   }
 
   return progress_rejected;
@@ -986,17 +990,21 @@ double status_get_progress_rejected_percent (const hashcat_ctx_t *hashcat_ctx)
   return percent_rejected;
 }
 
+u64 status_get_progress_dedup (const hashcat_ctx_t *hashcat_ctx)
+{
+  const dedup_ctx_t *dedup_ctx = hashcat_ctx->dedup_ctx;
+
+  if (dedup_ctx->enabled == false) return 0;
+
+  return dedup_ctx->skipped;
+}
+
 u64 status_get_progress_restored (const hashcat_ctx_t *hashcat_ctx)
 {
   const hashes_t     *hashes     = hashcat_ctx->hashes;
   const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
-  u64 progress_restored = 0;
-
-  for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
-  {
-    progress_restored += status_ctx->words_progress_restored[salt_pos];
-  }
+  const u64 progress_restored = status_ctx->words_progress_restored * hashes->salts_cnt;
 
   return progress_restored;
 }
@@ -1015,19 +1023,36 @@ u64 status_get_progress_cur (const hashcat_ctx_t *hashcat_ctx)
 u64 status_get_progress_ignore (const hashcat_ctx_t *hashcat_ctx)
 {
   const hashes_t     *hashes     = hashcat_ctx->hashes;
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
   const status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
   // Important for ETA only
+  // this is the only place which needs the per salt view, so only aggregate it if there's a cracked salt at all
 
   u64 progress_ignore = 0;
 
+  if (hashes->salts_done == 0) return progress_ignore;
+
+  u64 rejected_all = 0;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    rejected_all += opencl_ctx->devices_param[device_id].progress_rejected_all;
+  }
+
   for (u32 salt_pos = 0; salt_pos < hashes->salts_cnt; salt_pos++)
   {
     if (hashes->salts_shown[salt_pos] == 1)
     {
-      const u64 all = status_ctx->words_progress_done[salt_pos]
-                    + status_ctx->words_progress_rejected[salt_pos]
-                    + status_ctx->words_progress_restored[salt_pos];
+      u64 all = rejected_all + status_ctx->words_progress_restored;
+
+      for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+      {
+        const hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+        all += device_param->progress_done_buf[salt_pos];
+        all += device_param->progress_rejected_buf[salt_pos];
+      }
 
       const u64 left = status_ctx->words_cnt - all;
 
@@ -1220,6 +1245,39 @@ double status_get_exec_msec_dev (const hashcat_ctx_t *hashcat_ctx, const int dev
   return exec_dev_msec;
 }
 
+u32 status_get_kernel_accel_dev (const hashcat_ctx_t *hashcat_ctx, const int device_id)
+{
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+  if (device_param->skipped == true) return 0;
+
+  return device_param->kernel_accel;
+}
+
+u32 status_get_kernel_loops_dev (const hashcat_ctx_t *hashcat_ctx, const int device_id)
+{
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+  if (device_param->skipped == true) return 0;
+
+  return device_param->kernel_loops;
+}
+
+u32 status_get_retune_cnt_dev (const hashcat_ctx_t *hashcat_ctx, const int device_id)
+{
+  const opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+
+  hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+  if (device_param->skipped == true) return 0;
+
+  return device_param->retune_cnt;
+}
+
 char *status_get_speed_sec_all (const hashcat_ctx_t *hashcat_ctx)
 {
   const double hashes_msec_all = status_get_hashes_msec_all (hashcat_ctx);
@@ -1491,37 +1549,104 @@ char *status_get_hwmon_dev (const hashcat_ctx_t *hashcat_ctx, const int device_i
 
 int status_progress_init (hashcat_ctx_t *hashcat_ctx)
 {
-  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
   hashes_t     *hashes     = hashcat_ctx->hashes;
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    device_param->progress_done_buf     = (u64 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u64)); VERIFY_PTR (device_param->progress_done_buf);
+    device_param->progress_rejected_buf = (u64 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u64)); VERIFY_PTR (device_param->progress_rejected_buf);
+
+    device_param->progress_done         = 0;
+    device_param->progress_rejected     = 0;
+    device_param->progress_rejected_all = 0;
+  }
 
-  status_ctx->words_progress_done     = (u64 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u64)); VERIFY_PTR (status_ctx->words_progress_done);
-  status_ctx->words_progress_rejected = (u64 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u64)); VERIFY_PTR (status_ctx->words_progress_rejected);
-  status_ctx->words_progress_restored = (u64 *) hccalloc (hashcat_ctx, hashes->salts_cnt, sizeof (u64)); VERIFY_PTR (status_ctx->words_progress_restored);
+  status_ctx->words_progress_restored = 0;
 
   return 0;
 }
 
 void status_progress_destroy (hashcat_ctx_t *hashcat_ctx)
 {
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
   status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
 
-  hcfree (status_ctx->words_progress_done);
-  hcfree (status_ctx->words_progress_rejected);
-  hcfree (status_ctx->words_progress_restored);
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    hcfree (device_param->progress_done_buf);
+    hcfree (device_param->progress_rejected_buf);
 
-  status_ctx->words_progress_done     = NULL;
-  status_ctx->words_progress_rejected = NULL;
-  status_ctx->words_progress_restored = NULL;
+    device_param->progress_done_buf     = NULL;
+    device_param->progress_rejected_buf = NULL;
+  }
+
+  status_ctx->words_progress_restored = 0;
 }
 
 void status_progress_reset (hashcat_ctx_t *hashcat_ctx)
 {
-  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
   hashes_t     *hashes     = hashcat_ctx->hashes;
+  opencl_ctx_t *opencl_ctx = hashcat_ctx->opencl_ctx;
+  status_ctx_t *status_ctx = hashcat_ctx->status_ctx;
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    memset (device_param->progress_done_buf,     0, hashes->salts_cnt * sizeof (u64));
+    memset (device_param->progress_rejected_buf, 0, hashes->salts_cnt * sizeof (u64));
+
+    device_param->progress_done         = 0;
+    device_param->progress_rejected     = 0;
+    device_param->progress_rejected_all = 0;
+  }
 
-  memset (status_ctx->words_progress_done,     0, hashes->salts_cnt * sizeof (u64));
-  memset (status_ctx->words_progress_rejected, 0, hashes->salts_cnt * sizeof (u64));
-  memset (status_ctx->words_progress_restored, 0, hashes->salts_cnt * sizeof (u64));
+  status_ctx->words_progress_restored = 0;
+}
+
+void status_progress_add_done (hc_device_param_t *device_param, const u32 salt_pos, const u64 cnt)
+{
+  device_param->progress_done_buf[salt_pos] += cnt;
+
+  device_param->progress_done += cnt;
+}
+
+void status_progress_add_rejected (hc_device_param_t *device_param, const u32 salt_pos, const u64 cnt)
+{
+  device_param->progress_rejected_buf[salt_pos] += cnt;
+
+  device_param->progress_rejected += cnt;
+}
+
+void status_progress_add_done_salts (hc_device_param_t *device_param, const u32 salt_pos, const u32 salts_cnt, const u64 cnt)
+{
+  for (u32 salt_idx = salt_pos; salt_idx < salt_pos + salts_cnt; salt_idx++)
+  {
+    device_param->progress_done_buf[salt_idx] += cnt;
+  }
+
+  device_param->progress_done += cnt * salts_cnt;
+}
+
+void status_progress_add_rejected_salts (hc_device_param_t *device_param, const u32 salt_pos, const u32 salts_cnt, const u64 cnt)
+{
+  for (u32 salt_idx = salt_pos; salt_idx < salt_pos + salts_cnt; salt_idx++)
+  {
+    device_param->progress_rejected_buf[salt_idx] += cnt;
+  }
+
+  device_param->progress_rejected += cnt * salts_cnt;
+}
+
+void status_progress_add_rejected_all (hc_device_param_t *device_param, const u64 cnt)
+{
+  device_param->progress_rejected_all += cnt;
 }
 
 int status_ctx_init (hashcat_ctx_t *hashcat_ctx)
@@ -1555,5 +1680,7 @@ void status_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   hc_thread_mutex_delete (status_ctx->mux_display);
   hc_thread_mutex_delete (status_ctx->mux_hwmon);
 
+  hcfree (status_ctx->words_skip_buf);
+
   memset (status_ctx, 0, sizeof (status_ctx_t));
 }
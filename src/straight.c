@@ -210,7 +210,7 @@ int straight_ctx_init (hashcat_ctx_t *hashcat_ctx)
   {
     if (user_options->rp_files_cnt)
     {
-      const int rc_kernel_load = kernel_rules_load (hashcat_ctx, &straight_ctx->kernel_rules_buf, &straight_ctx->kernel_rules_cnt);
+      const int rc_kernel_load = kernel_rules_load (hashcat_ctx, &straight_ctx->kernel_rules_buf, &straight_ctx->kernel_rules_cnt, &straight_ctx->kernel_rules_buf_orig, &straight_ctx->kernel_rules_folded);
 
       if (rc_kernel_load == -1) return -1;
     }
@@ -485,6 +485,7 @@ void straight_ctx_destroy (hashcat_ctx_t *hashcat_ctx)
   hcfree (straight_ctx->dicts);
 
   hcfree (straight_ctx->kernel_rules_buf);
+  hcfree (straight_ctx->kernel_rules_buf_orig);
 
   memset (straight_ctx, 0, sizeof (straight_ctx_t));
 }
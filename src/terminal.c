@@ -150,6 +150,16 @@ static void keypress (hashcat_ctx_t *hashcat_ctx)
     //if (ch != '\n')
     //#endif
 
+    // same as the monitor, the snapshot takes mux_display itself, only for copying the cracked counters
+    // print the bare JSON line, without the blank lines and the prompt
+
+    if ((user_options->status_json == true) && ((ch == 's') || (ch == '\r') || (ch == '\n')))
+    {
+      status_display_json (hashcat_ctx);
+
+      continue;
+    }
+
     hc_thread_mutex_lock (status_ctx->mux_display);
 
     event_log_info (hashcat_ctx, "");
@@ -530,10 +540,108 @@ void status_display_machine_readable (hashcat_ctx_t *hashcat_ctx)
   hcfree (hashcat_status);
 }
 
+void status_display_json (hashcat_ctx_t *hashcat_ctx)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  status_snapshot_t *status_snapshot = (status_snapshot_t *) hcmalloc (hashcat_ctx, sizeof (status_snapshot_t));
+
+  const int rc_status = hashcat_get_status_snapshot (hashcat_ctx, status_snapshot);
+
+  if (rc_status == -1)
+  {
+    hcfree (status_snapshot);
+
+    return;
+  }
+
+  char *buf = (char *) hcmalloc (hashcat_ctx, HCBUFSIZ_LARGE);
+
+  const size_t size = HCBUFSIZ_LARGE - 1;
+
+  size_t len = 0;
+
+  len += snprintf (buf + len, size - len, "{\"session\":\"");
+
+  // the session name is the only string, escape it
+
+  for (const char *p = user_options->session; (*p != 0) && (len < size - 2); p++)
+  {
+    if ((u8) *p < 0x20) continue;
+
+    if ((*p == '"') || (*p == '\\')) buf[len++] = '\\';
+
+    buf[len++] = *p;
+  }
+
+  len += snprintf (buf + len, size - len, "\",\"time\":%" PRIu64 ",\"status\":%d,\"msec_running\":%.0f",
+    (u64) status_snapshot->timestamp,
+    status_snapshot->status_number,
+    status_snapshot->msec_running);
+
+  len += snprintf (buf + len, size - len, ",\"progress\":[%" PRIu64 ",%" PRIu64 "],\"progress_done\":%" PRIu64 ",\"progress_rejected\":%" PRIu64 ",\"restore_point\":[%" PRIu64 ",%" PRIu64 "]",
+    status_snapshot->progress_cur_relative_skip,
+    status_snapshot->progress_end_relative_skip,
+    status_snapshot->progress_done,
+    status_snapshot->progress_rejected,
+    status_snapshot->restore_point,
+    status_snapshot->restore_total);
+
+  len += snprintf (buf + len, size - len, ",\"recovered_hashes\":[%d,%d],\"recovered_salts\":[%d,%d],\"cracked\":%" PRIu64 ",\"hashes_msec\":%f,\"devices\":[",
+    status_snapshot->digests_done,
+    status_snapshot->digests_cnt,
+    status_snapshot->salts_done,
+    status_snapshot->salts_cnt,
+    status_snapshot->cracked_total,
+    status_snapshot->hashes_msec_all);
+
+  bool first = true;
+
+  for (int device_id = 0; device_id < status_snapshot->device_cnt; device_id++)
+  {
+    const status_snapshot_dev_t *device = status_snapshot->device_buf + device_id;
+
+    if (device->skipped_dev == true) continue;
+
+    len += snprintf (buf + len, size - len, "%s{\"id\":%d,\"hashes_msec\":%f,\"exec_msec\":%f,\"progress_done\":%" PRIu64 ",\"accel\":%u,\"loops\":%u,\"temp\":%d,\"fan\":%d,\"util\":%d}",
+      (first == true) ? "" : ",",
+      device_id + 1,
+      device->hashes_msec_dev,
+      device->exec_msec_dev,
+      device->progress_done_dev,
+      device->kernel_accel_dev,
+      device->kernel_loops_dev,
+      device->temperature_dev,
+      device->fanspeed_dev,
+      device->utilization_dev);
+
+    first = false;
+  }
+
+  len += snprintf (buf + len, size - len, "]}" EOL);
+
+  // a single write, so the line is not torn apart by a cracked hash printed at the same time
+
+  fwrite (buf, MIN (len, size), 1, stdout);
+
+  fflush (stdout);
+
+  hcfree (buf);
+
+  hcfree (status_snapshot);
+}
+
 void status_display (hashcat_ctx_t *hashcat_ctx)
 {
   const user_options_t *user_options = hashcat_ctx->user_options;
 
+  if (user_options->status_json == true)
+  {
+    status_display_json (hashcat_ctx);
+
+    return;
+  }
+
   if (user_options->machine_readable == true)
   {
     status_display_machine_readable (hashcat_ctx);
@@ -817,6 +925,13 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
       break;
   }
 
+  if (hashcat_ctx->dedup_ctx->enabled == true)
+  {
+    event_log_info (hashcat_ctx,
+      "Duplicates.....: %" PRIu64 " words skipped",
+      hashcat_status->progress_dedup);
+  }
+
   for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
   {
     const device_info_t *device_info = hashcat_status->device_info_buf + device_id;
@@ -830,6 +945,21 @@ void status_display (hashcat_ctx_t *hashcat_ctx)
       device_info->input_candidates_dev);
   }
 
+  for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
+  {
+    const device_info_t *device_info = hashcat_status->device_info_buf + device_id;
+
+    if (device_info->skipped_dev == true) continue;
+
+    if (device_info->retune_cnt_dev == 0) continue;
+
+    event_log_info (hashcat_ctx,
+      "Tuning.Dev.#%d..: Accel:%u Loops:%u (retuned %u times)", device_id + 1,
+      device_info->kernel_accel_dev,
+      device_info->kernel_loops_dev,
+      device_info->retune_cnt_dev);
+  }
+
   if (user_options->gpu_temp_disable == false)
   {
     for (int device_id = 0; device_id < hashcat_status->device_info_cnt; device_id++)
@@ -0,0 +1,197 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "timer.h"
+#include "trace.h"
+
+static const char *TRACE_SPAN_NAMES[] =
+{
+  "fetch",
+  "rules",
+  "copy",
+  "kernel enqueue",
+  "kernel wait",
+  "kernel",
+  "crack check",
+  "potfile write",
+};
+
+int trace_init (hashcat_ctx_t *hashcat_ctx)
+{
+  opencl_ctx_t   *opencl_ctx   = hashcat_ctx->opencl_ctx;
+  trace_ctx_t    *trace_ctx    = hashcat_ctx->trace_ctx;
+  user_options_t *user_options = hashcat_ctx->user_options;
+
+  trace_ctx->enabled = false;
+
+  if (user_options->keyspace    == true) return 0;
+  if (user_options->left        == true) return 0;
+  if (user_options->opencl_info == true) return 0;
+  if (user_options->show        == true) return 0;
+  if (user_options->usage       == true) return 0;
+  if (user_options->version     == true) return 0;
+
+  if (user_options->trace_file == NULL) return 0;
+
+  if (opencl_ctx->enabled == false) return 0;
+
+  trace_ctx->filename  = hcstrdup (hashcat_ctx, user_options->trace_file);
+  trace_ctx->rings_cnt = opencl_ctx->devices_cnt;
+  trace_ctx->rings     = (trace_ring_t *) hccalloc (hashcat_ctx, trace_ctx->rings_cnt, sizeof (trace_ring_t)); VERIFY_PTR (trace_ctx->rings);
+
+  for (u32 device_id = 0; device_id < opencl_ctx->devices_cnt; device_id++)
+  {
+    hc_device_param_t *device_param = &opencl_ctx->devices_param[device_id];
+
+    if (device_param->skipped) continue;
+
+    trace_ring_t *ring = &trace_ctx->rings[device_id];
+
+    ring->buf = (trace_event_t *) hccalloc (hashcat_ctx, TRACE_RING, sizeof (trace_event_t)); VERIFY_PTR (ring->buf);
+  }
+
+  hc_timer_set (&trace_ctx->timer_start);
+
+  trace_ctx->enabled = true;
+
+  return 0;
+}
+
+void trace_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  trace_ctx_t *trace_ctx = hashcat_ctx->trace_ctx;
+
+  if (trace_ctx->enabled == false) return;
+
+  for (u32 ring_pos = 0; ring_pos < trace_ctx->rings_cnt; ring_pos++)
+  {
+    hcfree (trace_ctx->rings[ring_pos].buf);
+  }
+
+  hcfree (trace_ctx->rings);
+  hcfree (trace_ctx->filename);
+
+  memset (trace_ctx, 0, sizeof (trace_ctx_t));
+}
+
+u64 trace_now (hashcat_ctx_t *hashcat_ctx)
+{
+  trace_ctx_t *trace_ctx = hashcat_ctx->trace_ctx;
+
+  if (trace_ctx->enabled == false) return 0;
+
+  return (u64) (hc_timer_get (trace_ctx->timer_start) * 1000);
+}
+
+static void trace_add (trace_ctx_t *trace_ctx, const hc_device_param_t *device_param, const u32 span, const u64 ts, const u64 dur, const u64 arg)
+{
+  trace_ring_t *ring = &trace_ctx->rings[device_param->device_id];
+
+  if (ring->buf == NULL) return;
+
+  trace_event_t *event = &ring->buf[ring->pos];
+
+  event->ts   = ts;
+  event->dur  = (u32) MIN (dur, 0xffffffff);
+  event->span = span;
+  event->arg  = arg;
+
+  ring->pos++;
+
+  if (ring->pos == TRACE_RING) ring->pos = 0;
+
+  if (ring->cnt < TRACE_RING) ring->cnt++;
+}
+
+void trace_span (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u32 span, const u64 ts_start, const u64 arg)
+{
+  trace_ctx_t *trace_ctx = hashcat_ctx->trace_ctx;
+
+  if (trace_ctx->enabled == false) return;
+
+  const u64 ts_end = trace_now (hashcat_ctx);
+
+  trace_add (trace_ctx, device_param, span, ts_start, (ts_end > ts_start) ? ts_end - ts_start : 0, arg);
+}
+
+void trace_device (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, const u32 kern_run, const double exec_us)
+{
+  trace_ctx_t *trace_ctx = hashcat_ctx->trace_ctx;
+
+  if (trace_ctx->enabled == false) return;
+
+  // the profiling counters use the device clock, so the kernel is placed to end
+  // at the time the host has seen it finish, which is close enough for a timeline
+
+  const u64 ts_end = trace_now (hashcat_ctx);
+
+  const u64 dur = (u64) exec_us;
+
+  trace_add (trace_ctx, device_param, TRACE_KERNEL_DEVICE, (ts_end > dur) ? ts_end - dur : 0, dur, kern_run);
+}
+
+int trace_write (hashcat_ctx_t *hashcat_ctx)
+{
+  trace_ctx_t *trace_ctx = hashcat_ctx->trace_ctx;
+
+  if (trace_ctx->enabled == false) return 0;
+
+  FILE *fp = fopen (trace_ctx->filename, "wb");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", trace_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  // chrome://tracing and Perfetto JSON, each device gets a host track and a device track
+
+  fprintf (fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+  fprintf (fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"hashcat\"}}");
+
+  for (u32 ring_pos = 0; ring_pos < trace_ctx->rings_cnt; ring_pos++)
+  {
+    const trace_ring_t *ring = &trace_ctx->rings[ring_pos];
+
+    if (ring->buf == NULL) continue;
+
+    const u32 tid_host   = (ring_pos * 2) + 1;
+    const u32 tid_device = (ring_pos * 2) + 2;
+
+    fprintf (fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Device #%u host\"}}", tid_host,   ring_pos + 1);
+    fprintf (fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Device #%u\"}}",      tid_device, ring_pos + 1);
+
+    // oldest first, the ring may have wrapped
+
+    const u32 first = (ring->cnt == TRACE_RING) ? ring->pos : 0;
+
+    for (u32 i = 0; i < ring->cnt; i++)
+    {
+      const trace_event_t *event = &ring->buf[(first + i) % TRACE_RING];
+
+      const u32 tid = (event->span == TRACE_KERNEL_DEVICE) ? tid_device : tid_host;
+
+      fprintf (fp, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%" PRIu64 ",\"dur\":%u,\"args\":{\"n\":%" PRIu64 "}}",
+        TRACE_SPAN_NAMES[event->span],
+        (event->span == TRACE_KERNEL_DEVICE) ? "device" : "host",
+        tid,
+        event->ts,
+        event->dur,
+        event->arg);
+    }
+  }
+
+  fprintf (fp, "\n]}\n");
+
+  fclose (fp);
+
+  return 0;
+}
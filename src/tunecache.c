@@ -0,0 +1,205 @@
+/**
+ * Author......: See docs/credits.txt
+ * License.....: MIT
+ */
+
+#include "common.h"
+#include "types.h"
+#include "memory.h"
+#include "event.h"
+#include "thread.h"
+#include "tunecache.h"
+
+int sort_by_tunecache (const void *s1, const void *s2)
+{
+  const tunecache_t *t1 = (const tunecache_t *) s1;
+  const tunecache_t *t2 = (const tunecache_t *) s2;
+
+  // the tuned values are not part of the key
+
+  return memcmp (t1, t2, offsetof (tunecache_t, kernel_accel));
+}
+
+int tunecache_init (hashcat_ctx_t *hashcat_ctx)
+{
+  folder_config_t *folder_config = hashcat_ctx->folder_config;
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+  user_options_t  *user_options  = hashcat_ctx->user_options;
+
+  tunecache_ctx->enabled = false;
+
+  if (user_options->benchmark   == true) return 0;
+  if (user_options->keyspace    == true) return 0;
+  if (user_options->left        == true) return 0;
+  if (user_options->opencl_info == true) return 0;
+  if (user_options->show        == true) return 0;
+  if (user_options->stdout_flag == true) return 0;
+  if (user_options->usage       == true) return 0;
+  if (user_options->version     == true) return 0;
+
+  tunecache_ctx->enabled  = true;
+  tunecache_ctx->filename = (char *)        hcmalloc (hashcat_ctx, HCBUFSIZ_TINY);                        VERIFY_PTR (tunecache_ctx->filename);
+  tunecache_ctx->base     = (tunecache_t *) hccalloc (hashcat_ctx, MAX_TUNECACHE, sizeof (tunecache_t));  VERIFY_PTR (tunecache_ctx->base);
+  tunecache_ctx->cnt      = 0;
+
+  snprintf (tunecache_ctx->filename, HCBUFSIZ_TINY - 1, "%s/hashcat.tunecache", folder_config->profile_dir);
+
+  hc_thread_mutex_init (tunecache_ctx->mux_tunecache);
+
+  FILE *fp = fopen (tunecache_ctx->filename, "ab");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tunecache_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  fclose (fp);
+
+  return 0;
+}
+
+void tunecache_destroy (hashcat_ctx_t *hashcat_ctx)
+{
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+
+  if (tunecache_ctx->enabled == false) return;
+
+  hc_thread_mutex_delete (tunecache_ctx->mux_tunecache);
+
+  hcfree (tunecache_ctx->filename);
+  hcfree (tunecache_ctx->base);
+
+  memset (tunecache_ctx, 0, sizeof (tunecache_ctx_t));
+}
+
+void tunecache_read (hashcat_ctx_t *hashcat_ctx)
+{
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+
+  if (tunecache_ctx->enabled == false) return;
+
+  FILE *fp = fopen (tunecache_ctx->filename, "rb");
+
+  if (fp == NULL)
+  {
+    // first run, file does not exist, do not error out
+
+    return;
+  }
+
+  while (!feof (fp))
+  {
+    tunecache_t t;
+
+    const int nread = fread (&t, sizeof (tunecache_t), 1, fp);
+
+    if (nread == 0) continue;
+
+    lsearch (&t, tunecache_ctx->base, &tunecache_ctx->cnt, sizeof (tunecache_t), sort_by_tunecache);
+
+    if (tunecache_ctx->cnt == MAX_TUNECACHE)
+    {
+      event_log_error (hashcat_ctx, "There are too many entries in the %s database. You have to remove/rename it.", tunecache_ctx->filename);
+
+      break;
+    }
+  }
+
+  fclose (fp);
+}
+
+int tunecache_write (hashcat_ctx_t *hashcat_ctx)
+{
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+
+  if (tunecache_ctx->enabled == false) return 0;
+
+  FILE *fp = fopen (tunecache_ctx->filename, "wb");
+
+  if (fp == NULL)
+  {
+    event_log_error (hashcat_ctx, "%s: %s", tunecache_ctx->filename, strerror (errno));
+
+    return -1;
+  }
+
+  fwrite (tunecache_ctx->base, sizeof (tunecache_t), tunecache_ctx->cnt, fp);
+
+  fclose (fp);
+
+  return 0;
+}
+
+void tunecache_key (hashcat_ctx_t *hashcat_ctx, const hc_device_param_t *device_param, tunecache_t *t)
+{
+  hashconfig_t         *hashconfig         = hashcat_ctx->hashconfig;
+  opencl_ctx_t         *opencl_ctx         = hashcat_ctx->opencl_ctx;
+  user_options_extra_t *user_options_extra = hashcat_ctx->user_options_extra;
+
+  // zero it first, the key is compared with memcmp()
+
+  memset (t, 0, sizeof (tunecache_t));
+
+  strncpy (t->device_name_chksum, device_param->device_name_chksum, sizeof (t->device_name_chksum) - 1);
+
+  t->kern_type         = hashconfig->kern_type;
+  t->attack_exec       = hashconfig->attack_exec;
+  t->attack_kern       = user_options_extra->attack_kern;
+  t->device_processors = device_param->device_processors;
+  t->kernel_threads    = device_param->kernel_threads;
+  t->kernel_accel_min  = device_param->kernel_accel_min;
+  t->kernel_accel_max  = device_param->kernel_accel_max;
+  t->kernel_loops_min  = device_param->kernel_loops_min;
+  t->kernel_loops_max  = device_param->kernel_loops_max;
+  t->target_msec       = (u32) opencl_ctx->target_msec;
+}
+
+bool tunecache_find (hashcat_ctx_t *hashcat_ctx, tunecache_t *t)
+{
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+
+  if (tunecache_ctx->enabled == false) return false;
+
+  hc_thread_mutex_lock (tunecache_ctx->mux_tunecache);
+
+  const tunecache_t *t_cache = (const tunecache_t *) lfind (t, tunecache_ctx->base, &tunecache_ctx->cnt, sizeof (tunecache_t), sort_by_tunecache);
+
+  if (t_cache != NULL)
+  {
+    t->kernel_accel = t_cache->kernel_accel;
+    t->kernel_loops = t_cache->kernel_loops;
+  }
+
+  hc_thread_mutex_unlock (tunecache_ctx->mux_tunecache);
+
+  return (t_cache != NULL);
+}
+
+void tunecache_append (hashcat_ctx_t *hashcat_ctx, tunecache_t *t)
+{
+  tunecache_ctx_t *tunecache_ctx = hashcat_ctx->tunecache_ctx;
+
+  if (tunecache_ctx->enabled == false) return;
+
+  hc_thread_mutex_lock (tunecache_ctx->mux_tunecache);
+
+  if (tunecache_ctx->cnt == MAX_TUNECACHE)
+  {
+    hc_thread_mutex_unlock (tunecache_ctx->mux_tunecache);
+
+    event_log_error (hashcat_ctx, "There are too many entries in the %s database. You have to remove/rename it.", tunecache_ctx->filename);
+
+    return;
+  }
+
+  tunecache_t *t_cache = (tunecache_t *) lsearch (t, tunecache_ctx->base, &tunecache_ctx->cnt, sizeof (tunecache_t), sort_by_tunecache);
+
+  // same key tuned again, keep the most recent result
+
+  t_cache->kernel_accel = t->kernel_accel;
+  t_cache->kernel_loops = t->kernel_loops;
+
+  hc_thread_mutex_unlock (tunecache_ctx->mux_tunecache);
+}
@@ -35,6 +35,7 @@ static const char *USAGE_BIG[] =
   "     --force                   |      | Ignore warnings                                      |",
   "     --status                  |      | Enable automatic update of the status-screen         |",
   "     --status-timer            | Num  | Sets seconds between status-screen update to X       | --status-timer=1",
+  "     --status-json             |      | Print status as one JSON line per status-timer tick  |",
   "     --machine-readable        |      | Display the status view in a machine readable format |",
   "     --loopback                |      | Add new plains to induct directory                   |",
   "     --weak-hash-threshold     | Num  | Threshold X when to stop checking for weak hashes    | --weak=0",
@@ -64,6 +65,8 @@ static const char *USAGE_BIG[] =
   "     --induction-dir           | Dir  | Specify the induction directory to use for loopback  | --induction=inducts",
   "     --outfile-check-dir       | Dir  | Specify the outfile directory to monitor for plains  | --outfile-check-dir=x",
   "     --logfile-disable         |      | Disable the logfile                                  |",
+  "     --metrics-file            | File | Export counters in Prometheus text format every sec  | --metrics-file=x.prom",
+  "     --trace-file              | File | Record a Chrome trace of the device pipeline to X    | --trace-file=x.json",
   "     --truecrypt-keyfiles      | File | Keyfiles used, separate with comma                   | --truecrypt-key=x.png",
   "     --veracrypt-keyfiles      | File | Keyfiles used, separate with comma                   | --veracrypt-key=x.txt",
   "     --veracrypt-pim           | Num  | VeraCrypt personal iterations multiplier             | --veracrypt-pim=1000",
@@ -74,10 +77,12 @@ static const char *USAGE_BIG[] =
   "     --bitmap-max              | Num  | Sets maximum bits allowed for bitmaps to X           | --bitmap-max=24",
   "     --cpu-affinity            | Str  | Locks to CPU devices, separate with comma            | --cpu-affinity=1,2,3",
   " -I, --opencl-info             |      | Show info about OpenCL platforms/devices detected    | -I",
+  "     --kernel-warmup           | Str  | Build the kernel cache for a list of hash-modes      | --kernel-warmup=0,100,1000",
   "     --opencl-platforms        | Str  | OpenCL platforms to use, separate with comma         | --opencl-platforms=2",
   " -d, --opencl-devices          | Str  | OpenCL devices to use, separate with comma           | -d 1",
   " -D, --opencl-device-types     | Str  | OpenCL device-types to use, separate with comma      | -D 1",
   "     --opencl-vector-width     | Num  | Manual override OpenCL vector-width to X             | --opencl-vector=4",
+  "     --backend-host            |      | Crack on the host CPU, no OpenCL runtime needed      |",
   " -w, --workload-profile        | Num  | Enable a specific workload profile, see pool below   | -w 3",
   " -n, --kernel-accel            | Num  | Manual workload tuning, set outerloop step size to X | -n 64",
   " -u, --kernel-loops            | Num  | Manual workload tuning, set innerloop step size to X | -u 256",
@@ -97,6 +102,8 @@ static const char *USAGE_BIG[] =
   "     --generate-rules-func-min | Num  | Force min X funcs per rule                           |",
   "     --generate-rules-func-max | Num  | Force max X funcs per rule                           |",
   "     --generate-rules-seed     | Num  | Force RNG seed set to X                              |",
+  "     --host-rule-threads       | Num  | Expand rules on the host with X threads, slow hashes | --host-rule-threads=8",
+  "     --dedup-candidates        | Num  | Skip repeated base words, X MB filter (-a 0, -a 1)   | --dedup-candidates=64",
   " -1, --custom-charset1         | CS   | User-defined charset ?1                              | -1 ?l?d?u",
   " -2, --custom-charset2         | CS   | User-defined charset ?2                              | -2 ?l?d?s",
   " -3, --custom-charset3         | CS   | User-defined charset ?3                              |",
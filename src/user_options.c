@@ -12,6 +12,7 @@
 #include "shared.h"
 #include "usage.h"
 #include "outfile.h"
+#include "host_backend.h"
 #include "user_options.h"
 
 static const char short_options[] = "hVvm:a:r:j:k:g:o:t:d:D:n:u:c:p:s:l:1:2:3:4:iIbw:";
@@ -19,6 +20,7 @@ static const char short_options[] = "hVvm:a:r:j:k:g:o:t:d:D:n:u:c:p:s:l:1:2:3:4:
 static const struct option long_options[] =
 {
   {"attack-mode",               required_argument, 0, IDX_ATTACK_MODE},
+  {"backend-host",              no_argument,       0, IDX_BACKEND_HOST},
   {"benchmark",                 no_argument,       0, IDX_BENCHMARK},
   {"bitmap-max",                required_argument, 0, IDX_BITMAP_MAX},
   {"bitmap-min",                required_argument, 0, IDX_BITMAP_MIN},
@@ -29,6 +31,7 @@ static const struct option long_options[] =
   {"custom-charset4",           required_argument, 0, IDX_CUSTOM_CHARSET_4},
   {"debug-file",                required_argument, 0, IDX_DEBUG_FILE},
   {"debug-mode",                required_argument, 0, IDX_DEBUG_MODE},
+  {"dedup-candidates",          required_argument, 0, IDX_DEDUP_CANDIDATES},
   {"force",                     no_argument,       0, IDX_FORCE},
   {"generate-rules-func-max",   required_argument, 0, IDX_RP_GEN_FUNC_MAX},
   {"generate-rules-func-min",   required_argument, 0, IDX_RP_GEN_FUNC_MIN},
@@ -42,12 +45,14 @@ static const struct option long_options[] =
   {"hex-charset",               no_argument,       0, IDX_HEX_CHARSET},
   {"hex-salt",                  no_argument,       0, IDX_HEX_SALT},
   {"hex-wordlist",              no_argument,       0, IDX_HEX_WORDLIST},
+  {"host-rule-threads",         required_argument, 0, IDX_HOST_RULE_THREADS},
   {"increment-max",             required_argument, 0, IDX_INCREMENT_MAX},
   {"increment-min",             required_argument, 0, IDX_INCREMENT_MIN},
   {"increment",                 no_argument,       0, IDX_INCREMENT},
   {"induction-dir",             required_argument, 0, IDX_INDUCTION_DIR},
   {"kernel-accel",              required_argument, 0, IDX_KERNEL_ACCEL},
   {"kernel-loops",              required_argument, 0, IDX_KERNEL_LOOPS},
+  {"kernel-warmup",             required_argument, 0, IDX_KERNEL_WARMUP},
   {"keyspace",                  no_argument,       0, IDX_KEYSPACE},
   {"left",                      no_argument,       0, IDX_LEFT},
   {"limit",                     required_argument, 0, IDX_LIMIT},
@@ -58,6 +63,7 @@ static const struct option long_options[] =
   {"markov-disable",            no_argument,       0, IDX_MARKOV_DISABLE},
   {"markov-hcstat",             required_argument, 0, IDX_MARKOV_HCSTAT},
   {"markov-threshold",          required_argument, 0, IDX_MARKOV_THRESHOLD},
+  {"metrics-file",              required_argument, 0, IDX_METRICS_FILE},
   {"nvidia-spin-damp",          required_argument, 0, IDX_NVIDIA_SPIN_DAMP},
   {"opencl-devices",            required_argument, 0, IDX_OPENCL_DEVICES},
   {"opencl-device-types",       required_argument, 0, IDX_OPENCL_DEVICE_TYPES},
@@ -89,9 +95,11 @@ static const struct option long_options[] =
   {"show",                      no_argument,       0, IDX_SHOW},
   {"skip",                      required_argument, 0, IDX_SKIP},
   {"status",                    no_argument,       0, IDX_STATUS},
+  {"status-json",               no_argument,       0, IDX_STATUS_JSON},
   {"status-timer",              required_argument, 0, IDX_STATUS_TIMER},
   {"stdout",                    no_argument,       0, IDX_STDOUT_FLAG},
   {"speed-only",                no_argument,       0, IDX_SPEED_ONLY},
+  {"trace-file",                required_argument, 0, IDX_TRACE_FILE},
   {"truecrypt-keyfiles",        required_argument, 0, IDX_TRUECRYPT_KEYFILES},
   {"username",                  no_argument,       0, IDX_USERNAME},
   {"veracrypt-keyfiles",        required_argument, 0, IDX_VERACRYPT_KEYFILES},
@@ -114,6 +122,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options_t *user_options = hashcat_ctx->user_options;
 
   user_options->attack_mode               = ATTACK_MODE;
+  user_options->backend_host              = BACKEND_HOST;
   user_options->benchmark                 = BENCHMARK;
   user_options->bitmap_max                = BITMAP_MAX;
   user_options->bitmap_min                = BITMAP_MIN;
@@ -124,6 +133,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->custom_charset_4          = NULL;
   user_options->debug_file                = NULL;
   user_options->debug_mode                = DEBUG_MODE;
+  user_options->dedup_candidates          = DEDUP_CANDIDATES;
   user_options->force                     = FORCE;
   user_options->gpu_temp_abort            = GPU_TEMP_ABORT;
   user_options->gpu_temp_disable          = GPU_TEMP_DISABLE;
@@ -132,12 +142,14 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->hex_charset               = HEX_CHARSET;
   user_options->hex_salt                  = HEX_SALT;
   user_options->hex_wordlist              = HEX_WORDLIST;
+  user_options->host_rule_threads         = HOST_RULE_THREADS;
   user_options->increment                 = INCREMENT;
   user_options->increment_max             = INCREMENT_MAX;
   user_options->increment_min             = INCREMENT_MIN;
   user_options->induction_dir             = NULL;
   user_options->kernel_accel              = KERNEL_ACCEL;
   user_options->kernel_loops              = KERNEL_LOOPS;
+  user_options->kernel_warmup             = NULL;
   user_options->keyspace                  = KEYSPACE;
   user_options->left                      = LEFT;
   user_options->limit                     = LIMIT;
@@ -148,6 +160,7 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->markov_disable            = MARKOV_DISABLE;
   user_options->markov_hcstat             = NULL;
   user_options->markov_threshold          = MARKOV_THRESHOLD;
+  user_options->metrics_file              = NULL;
   user_options->nvidia_spin_damp          = NVIDIA_SPIN_DAMP;
   user_options->opencl_devices            = NULL;
   user_options->opencl_device_types       = NULL;
@@ -182,9 +195,11 @@ int user_options_init (hashcat_ctx_t *hashcat_ctx)
   user_options->show                      = SHOW;
   user_options->skip                      = SKIP;
   user_options->status                    = STATUS;
+  user_options->status_json               = STATUS_JSON;
   user_options->status_timer              = STATUS_TIMER;
   user_options->stdout_flag               = STDOUT_FLAG;
   user_options->speed_only                = SPEED_ONLY;
+  user_options->trace_file                = NULL;
   user_options->truecrypt_keyfiles        = NULL;
   user_options->usage                     = USAGE;
   user_options->username                  = USERNAME;
@@ -322,6 +337,13 @@ int user_options_getopt (hashcat_ctx_t *hashcat_ctx, int argc, char **argv)
       case IDX_CUSTOM_CHARSET_2:          user_options->custom_charset_2          = optarg;         break;
       case IDX_CUSTOM_CHARSET_3:          user_options->custom_charset_3          = optarg;         break;
       case IDX_CUSTOM_CHARSET_4:          user_options->custom_charset_4          = optarg;         break;
+      case IDX_BACKEND_HOST:              user_options->backend_host              = true;           break;
+      case IDX_KERNEL_WARMUP:             user_options->kernel_warmup             = optarg;         break;
+      case IDX_STATUS_JSON:               user_options->status_json               = true;           break;
+      case IDX_TRACE_FILE:                user_options->trace_file                = optarg;         break;
+      case IDX_METRICS_FILE:              user_options->metrics_file              = optarg;         break;
+      case IDX_DEDUP_CANDIDATES:          user_options->dedup_candidates          = atoi (optarg);  break;
+      case IDX_HOST_RULE_THREADS:         user_options->host_rule_threads         = atoi (optarg);  break;
 
       default:
       {
@@ -490,6 +512,35 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  // a negative value from atoi () wraps around to billions of threads
+
+  if (user_options->host_rule_threads > 1024)
+  {
+    event_log_error (hashcat_ctx, "Invalid host-rule-threads specified");
+
+    return -1;
+  }
+
+  if (user_options->host_rule_threads > 0)
+  {
+    if (user_options->attack_mode != ATTACK_MODE_STRAIGHT)
+    {
+      event_log_error (hashcat_ctx, "Use of host-rule-threads only allowed in attack-mode 0");
+
+      return -1;
+    }
+  }
+
+  if (user_options->dedup_candidates > 0)
+  {
+    if ((user_options->attack_mode != ATTACK_MODE_STRAIGHT) && (user_options->attack_mode != ATTACK_MODE_COMBI))
+    {
+      event_log_error (hashcat_ctx, "Use of dedup-candidates only allowed in attack-mode 0 and 1");
+
+      return -1;
+    }
+  }
+
   if (user_options->bitmap_min > user_options->bitmap_max)
   {
     event_log_error (hashcat_ctx, "Invalid bitmap-min specified");
@@ -737,6 +788,23 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
     }
   }
 
+  if (user_options->backend_host == true)
+  {
+    if ((user_options->opencl_info == true) || (user_options->kernel_warmup != NULL))
+    {
+      event_log_error (hashcat_ctx, "Mixing backend-host parameter not allowed with opencl-info or kernel-warmup parameter");
+
+      return -1;
+    }
+
+    if (((user_options->benchmark == false) || (user_options->hash_mode_chgd == true)) && (host_backend_supported (user_options->hash_mode) == false))
+    {
+      event_log_error (hashcat_ctx, "Hash-mode %u is not supported by the host backend", user_options->hash_mode);
+
+      return -1;
+    }
+  }
+
   // argc / argv checks
 
   bool show_error = true;
@@ -763,6 +831,13 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
       show_error = false;
     }
   }
+  else if (user_options->kernel_warmup != NULL)
+  {
+    if (user_options->hc_argc == 0)
+    {
+      show_error = false;
+    }
+  }
   else if (user_options->restore == true)
   {
     if (user_options->hc_argc == 0)
@@ -894,6 +969,65 @@ int user_options_sanity (hashcat_ctx_t *hashcat_ctx)
   return 0;
 }
 
+static bool user_options_str_equal (const char *a, const char *b)
+{
+  if ((a == NULL) && (b == NULL)) return true;
+  if ((a == NULL) || (b == NULL)) return false;
+
+  return (strcmp (a, b) == 0);
+}
+
+int user_options_job_check (hashcat_ctx_t *hashcat_ctx, const user_options_t *session_options)
+{
+  const user_options_t *user_options = hashcat_ctx->user_options;
+
+  // these were consumed by hashcat_session_init (), devices, files and monitors are not set up again for a job
+
+  const char *changed = NULL;
+
+  if (user_options->backend_host      != session_options->backend_host)      changed = "backend-host";
+  if (user_options->debug_mode        != session_options->debug_mode)        changed = "debug-mode";
+  if (user_options->gpu_temp_abort    != session_options->gpu_temp_abort)    changed = "gpu-temp-abort";
+  if (user_options->gpu_temp_disable  != session_options->gpu_temp_disable)  changed = "gpu-temp-disable";
+  if (user_options->gpu_temp_retain   != session_options->gpu_temp_retain)   changed = "gpu-temp-retain";
+  if (user_options->logfile_disable   != session_options->logfile_disable)   changed = "logfile-disable";
+  if (user_options->loopback          != session_options->loopback)          changed = "loopback";
+  if (user_options->outfile_format    != session_options->outfile_format)    changed = "outfile-format";
+  if (user_options->potfile_disable   != session_options->potfile_disable)   changed = "potfile-disable";
+  if (user_options->powertune_enable  != session_options->powertune_enable)  changed = "powertune-enable";
+  if (user_options->restore           != session_options->restore)           changed = "restore";
+  if (user_options->restore_disable   != session_options->restore_disable)   changed = "restore-disable";
+
+  if (user_options_str_equal (user_options->cpu_affinity,        session_options->cpu_affinity)        == false) changed = "cpu-affinity";
+  if (user_options_str_equal (user_options->debug_file,          session_options->debug_file)          == false) changed = "debug-file";
+  if (user_options_str_equal (user_options->induction_dir,       session_options->induction_dir)       == false) changed = "induction-dir";
+  if (user_options_str_equal (user_options->metrics_file,        session_options->metrics_file)        == false) changed = "metrics-file";
+  if (user_options_str_equal (user_options->opencl_devices,      session_options->opencl_devices)      == false) changed = "opencl-devices";
+  if (user_options_str_equal (user_options->opencl_device_types, session_options->opencl_device_types) == false) changed = "opencl-device-types";
+  if (user_options_str_equal (user_options->opencl_platforms,    session_options->opencl_platforms)    == false) changed = "opencl-platforms";
+  if (user_options_str_equal (user_options->outfile,             session_options->outfile)             == false) changed = "outfile";
+  if (user_options_str_equal (user_options->outfile_check_dir,   session_options->outfile_check_dir)   == false) changed = "outfile-check-dir";
+  if (user_options_str_equal (user_options->potfile_path,        session_options->potfile_path)        == false) changed = "potfile-path";
+  if (user_options_str_equal (user_options->session,             session_options->session)             == false) changed = "session";
+  if (user_options_str_equal (user_options->trace_file,          session_options->trace_file)          == false) changed = "trace-file";
+
+  if (changed != NULL)
+  {
+    event_log_error (hashcat_ctx, "Option --%s can not be changed between jobs", changed);
+
+    return -1;
+  }
+
+  if ((user_options->version == true) || (user_options->usage == true) || (user_options->opencl_info == true) || (user_options->kernel_warmup != NULL))
+  {
+    event_log_error (hashcat_ctx, "Informational options are not supported for jobs");
+
+    return -1;
+  }
+
+  return 0;
+}
+
 void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
 {
   user_options_t *user_options = hashcat_ctx->user_options;
@@ -907,11 +1041,17 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
 
   // some options can influence or overwrite other options
 
-  if (user_options->opencl_info == true
-   || user_options->keyspace    == true
-   || user_options->benchmark   == true
-   || user_options->stdout_flag == true
-   || user_options->speed_only  == true)
+  if (user_options->status_json == true)
+  {
+    user_options->status = true;
+  }
+
+  if (user_options->opencl_info   == true
+   || user_options->keyspace      == true
+   || user_options->benchmark     == true
+   || user_options->stdout_flag   == true
+   || user_options->speed_only    == true
+   || user_options->kernel_warmup != NULL)
   {
     user_options->show                = false;
     user_options->left                = false;
@@ -965,6 +1105,11 @@ void user_options_preprocess (hashcat_ctx_t *hashcat_ctx)
     user_options->opencl_vector_width = 1;
   }
 
+  if (user_options->kernel_warmup != NULL)
+  {
+    user_options->session             = "kernel_warmup";
+  }
+
   if (user_options->opencl_info == true)
   {
     user_options->session             = "opencl_info";
@@ -1121,6 +1266,10 @@ void user_options_extra_init (hashcat_ctx_t *hashcat_ctx)
   else if (user_options->opencl_info == true)
   {
 
+  }
+  else if (user_options->kernel_warmup != NULL)
+  {
+
   }
   else if (user_options->keyspace == true)
   {
@@ -1209,7 +1358,9 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_string (user_options->custom_charset_4);
   logfile_top_string (user_options->debug_file);
   logfile_top_string (user_options->induction_dir);
+  logfile_top_string (user_options->kernel_warmup);
   logfile_top_string (user_options->markov_hcstat);
+  logfile_top_string (user_options->metrics_file);
   logfile_top_string (user_options->opencl_devices);
   logfile_top_string (user_options->opencl_device_types);
   logfile_top_string (user_options->opencl_platforms);
@@ -1220,15 +1371,18 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_string (user_options->rule_buf_l);
   logfile_top_string (user_options->rule_buf_r);
   logfile_top_string (user_options->session);
+  logfile_top_string (user_options->trace_file);
   logfile_top_string (user_options->truecrypt_keyfiles);
   logfile_top_string (user_options->veracrypt_keyfiles);
   logfile_top_uint64 (user_options->limit);
   logfile_top_uint64 (user_options->skip);
   logfile_top_uint   (user_options->attack_mode);
+  logfile_top_uint   (user_options->backend_host);
   logfile_top_uint   (user_options->benchmark);
   logfile_top_uint   (user_options->bitmap_max);
   logfile_top_uint   (user_options->bitmap_min);
   logfile_top_uint   (user_options->debug_mode);
+  logfile_top_uint   (user_options->dedup_candidates);
   logfile_top_uint   (user_options->force);
   logfile_top_uint   (user_options->gpu_temp_abort);
   logfile_top_uint   (user_options->gpu_temp_disable);
@@ -1237,6 +1391,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->hex_charset);
   logfile_top_uint   (user_options->hex_salt);
   logfile_top_uint   (user_options->hex_wordlist);
+  logfile_top_uint   (user_options->host_rule_threads);
   logfile_top_uint   (user_options->increment);
   logfile_top_uint   (user_options->increment_max);
   logfile_top_uint   (user_options->increment_min);
@@ -1274,6 +1429,7 @@ void user_options_logger (hashcat_ctx_t *hashcat_ctx)
   logfile_top_uint   (user_options->segment_size);
   logfile_top_uint   (user_options->show);
   logfile_top_uint   (user_options->status);
+  logfile_top_uint   (user_options->status_json);
   logfile_top_uint   (user_options->status_timer);
   logfile_top_uint   (user_options->stdout_flag);
   logfile_top_uint   (user_options->speed_only);